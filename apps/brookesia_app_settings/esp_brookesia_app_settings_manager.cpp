@@ -189,9 +189,8 @@ bool SettingsManager::processInit()
     ESP_UTILS_CHECK_FALSE_RETURN(initWlan(), false, "Init WLAN failed");
 
     auto &storage_service = StorageNVS::requestInstance();
-    storage_service.connectEventSignal([this](const StorageNVS::Event & event) {
-        if ((event.operation != StorageNVS::Operation::UpdateNVS) || (event.sender == this)) {
-            ESP_UTILS_LOGD("Ignore event: operation(%d), sender(%p)", static_cast<int>(event.operation), event.sender);
+    storage_service.subscribe(Manager::SETTINGS_WLAN_SWITCH, [this](const StorageNVS::Event & event) {
+        if (event.sender == this) {
             return;
         }
 
@@ -199,35 +198,50 @@ bool SettingsManager::processInit()
         ESP_UTILS_CHECK_FALSE_EXIT(
             StorageNVS::requestInstance().getLocalParam(event.key, value), "Get NVS value failed"
         );
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            std::holds_alternative<int>(value), "Invalid WLAN switch flag type"
+        );
 
-        if (event.key == Manager::SETTINGS_WLAN_SWITCH) {
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                std::holds_alternative<int>(value), "Invalid WLAN switch flag type"
-            );
-
-            auto is_open = static_cast<bool>(std::get<int>(value));
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                processStorageServiceEventSignalUpdateWlanSwitch(is_open), "Process WLAN switch flag updated failed"
-            );
-        } else if (event.key == Manager::SETTINGS_VOLUME) {
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                std::holds_alternative<int>(value), "Invalid volume type"
-            );
+        auto is_open = static_cast<bool>(std::get<int>(value));
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            processStorageServiceEventSignalUpdateWlanSwitch(is_open), "Process WLAN switch flag updated failed"
+        );
+    });
+    storage_service.subscribe(Manager::SETTINGS_VOLUME, [this](const StorageNVS::Event & event) {
+        if (event.sender == this) {
+            return;
+        }
 
-            auto volume = std::get<int>(value);
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                processStorageServiceEventSignalUpdateVolume(volume), "Process volume updated failed"
-            );
-        } else if (event.key == Manager::SETTINGS_BRIGHTNESS) {
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                std::holds_alternative<int>(value), "Invalid brightness type"
-            );
+        StorageNVS::Value value;
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            StorageNVS::requestInstance().getLocalParam(event.key, value), "Get NVS value failed"
+        );
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            std::holds_alternative<int>(value), "Invalid volume type"
+        );
 
-            auto brightness = std::get<int>(value);
-            ESP_UTILS_CHECK_FALSE_EXIT(
-                processStorageServiceEventSignalUpdateBrightness(brightness), "Process brightness updated failed"
-            );
+        auto volume = std::get<int>(value);
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            processStorageServiceEventSignalUpdateVolume(volume), "Process volume updated failed"
+        );
+    });
+    storage_service.subscribe(Manager::SETTINGS_BRIGHTNESS, [this](const StorageNVS::Event & event) {
+        if (event.sender == this) {
+            return;
         }
+
+        StorageNVS::Value value;
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            StorageNVS::requestInstance().getLocalParam(event.key, value), "Get NVS value failed"
+        );
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            std::holds_alternative<int>(value), "Invalid brightness type"
+        );
+
+        auto brightness = std::get<int>(value);
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            processStorageServiceEventSignalUpdateBrightness(brightness), "Process brightness updated failed"
+        );
     });
 
     StorageNVS::Value wlan_sw_flag;
@@ -3224,14 +3238,10 @@ bool SettingsManager::saveWlanConfig(std::string ssid, std::string pwd)
     auto &last_pwd_str = std::get<std::string>(last_pwd);
 
     if ((last_ssid_str != ssid) || (last_pwd_str != pwd)) {
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            storage_service.setLocalParam(Manager::SETTINGS_WLAN_SSID, ssid, this), false,
-            "Set last SSID failed"
-        );
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            storage_service.setLocalParam(Manager::SETTINGS_WLAN_PASSWORD, pwd, this), false,
-            "Set last PWD failed"
-        );
+        // Write the SSID and password together, so a reset never leaves a mismatched pair
+        auto transaction = storage_service.beginTransaction();
+        transaction.set(Manager::SETTINGS_WLAN_SSID, ssid).set(Manager::SETTINGS_WLAN_PASSWORD, pwd);
+        ESP_UTILS_CHECK_FALSE_RETURN(transaction.commit(this), false, "Set last SSID and PWD failed");
     } else {
         ESP_UTILS_LOGD(
             "SSID and PWD are the same(%s, %s), no need to save",
@@ -60,7 +60,6 @@ bool Expression::begin(const ExpressionData &data, const EmojiMap *emoji_map, co
         _emoji_map = emoji_map_tmp;
         _emotion_player = std::make_unique<gui::AnimPlayer>();
         ESP_UTILS_CHECK_NULL_RETURN(_emotion_player, false, "Invalid emotion player");
-        ESP_UTILS_CHECK_FALSE_RETURN(_emotion_player->begin(data.emotion.data), false, "Emotion player begin failed");
     }
     if (data.flags.enable_icon) {
         auto animation_num = data.icon.data.getAnimationNum();
@@ -77,6 +76,41 @@ bool Expression::begin(const ExpressionData &data, const EmojiMap *emoji_map, co
         _system_icon_map = system_icon_map_tmp;
         _icon_player = std::make_unique<gui::AnimPlayer>();
         ESP_UTILS_CHECK_NULL_RETURN(_icon_player, false, "Invalid icon player");
+    }
+
+    if (data.flags.enable_compositor && (_emotion_player != nullptr) && (_icon_player != nullptr)) {
+        // The canvas of the compositor is the bounding box of both players
+        auto &emotion_canvas = data.emotion.data.canvas;
+        auto &icon_canvas = data.icon.data.canvas;
+        int x_start = std::min(emotion_canvas.coord_x, icon_canvas.coord_x);
+        int y_start = std::min(emotion_canvas.coord_y, icon_canvas.coord_y);
+        int x_end = std::max(emotion_canvas.coord_x + emotion_canvas.width, icon_canvas.coord_x + icon_canvas.width);
+        int y_end = std::max(emotion_canvas.coord_y + emotion_canvas.height, icon_canvas.coord_y + icon_canvas.height);
+
+        _compositor = std::make_unique<gui::AnimCompositor>();
+        ESP_UTILS_CHECK_NULL_RETURN(_compositor, false, "Invalid compositor");
+        ESP_UTILS_CHECK_FALSE_RETURN(_compositor->begin({
+            .canvas = {
+                .coord_x = x_start,
+                .coord_y = y_start,
+                .width = x_end - x_start,
+                .height = y_end - y_start,
+            },
+            .buffer_in_ext = data.compositor.buffer_in_ext,
+        }), false, "Compositor begin failed");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _compositor->attach(*_emotion_player, emotion_canvas, {}), false, "Attach emotion player failed"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _compositor->attach(*_icon_player, icon_canvas, data.compositor.icon_layer), false,
+            "Attach icon player failed"
+        );
+    }
+
+    if (_emotion_player != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(_emotion_player->begin(data.emotion.data), false, "Emotion player begin failed");
+    }
+    if (_icon_player != nullptr) {
         ESP_UTILS_CHECK_FALSE_RETURN(_icon_player->begin(data.icon.data), false, "Icon player begin failed");
     }
 
@@ -95,6 +129,8 @@ bool Expression::del()
     _flags = {};
     _emotion_player = nullptr;
     _icon_player = nullptr;
+    // Deleted after the players, since they flush into it
+    _compositor = nullptr;
     _emotion_operation_before_pause = gui::AnimPlayer::Operation::PlayOnceStop;
     _icon_operation_before_pause = gui::AnimPlayer::Operation::PlayOnceStop;
     _emotion_type_before_pause = EMOTION_TYPE_NONE;
@@ -161,12 +197,20 @@ bool Expression::resume(bool update_emotion, bool update_icon)
             "Emotion before pause: type(%d), operation(%d)", _emotion_type_before_pause,
             static_cast<int>(_emotion_operation_before_pause)
         );
+        // Continue from the frame where the animation was paused
+        auto position = _emotion_player->getPosition();
         ESP_UTILS_CHECK_FALSE_RETURN(_emotion_player->sendEvent({
             .index = _emotion_type_before_pause,
             .operation = _emotion_operation_before_pause,
             .flags = {
                 .enable_interrupt = true,
                 .force = true,
+                .enable_segment = true,
+            },
+            .segment = {
+                .from_frame = 0,
+                .to_frame = gui::AnimPlayer::FRAME_LAST,
+                .start_frame = (position.index == _emotion_type_before_pause) ? position.frame : 0,
             },
         }, true), false, "Send emotion event failed");
     }
@@ -175,12 +219,20 @@ bool Expression::resume(bool update_emotion, bool update_icon)
             "Icon before pause: type(%d), operation(%d)", _icon_type_before_pause,
             static_cast<int>(_icon_operation_before_pause)
         );
+        // Continue from the frame where the animation was paused
+        auto position = _icon_player->getPosition();
         ESP_UTILS_CHECK_FALSE_RETURN(_icon_player->sendEvent({
             .index = _icon_type_before_pause,
             .operation = _icon_operation_before_pause,
             .flags = {
                 .enable_interrupt = true,
                 .force = true,
+                .enable_segment = true,
+            },
+            .segment = {
+                .from_frame = 0,
+                .to_frame = gui::AnimPlayer::FRAME_LAST,
+                .start_frame = (position.index == _icon_type_before_pause) ? position.frame : 0,
             },
         }, true), false, "Send icon event failed");
     }
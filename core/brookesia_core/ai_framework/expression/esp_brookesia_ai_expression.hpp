@@ -8,6 +8,7 @@
 #include <map>
 #include <string>
 #include "boost/thread.hpp"
+#include "gui/anim_player/esp_brookesia_anim_compositor.hpp"
 #include "gui/anim_player/esp_brookesia_anim_player.hpp"
 
 namespace esp_brookesia::ai_framework {
@@ -22,7 +23,12 @@ struct ExpressionData {
     struct {
         int enable_emotion: 1;
         int enable_icon: 1;
+        int enable_compositor: 1;   // Compose the icon over the emotion, only used when both are enabled
     } flags;
+    struct {
+        bool buffer_in_ext;
+        gui::AnimCompositor::LayerConfig icon_layer;
+    } compositor;
 };
 
 class Expression {
@@ -94,6 +100,8 @@ private:
     IconType _icon_type_before_pause = ICON_TYPE_NONE;
     gui::AnimPlayer::Operation _icon_operation_before_pause = gui::AnimPlayer::Operation::PlayOnceStop;
     std::unique_ptr<gui::AnimPlayer> _icon_player;
+
+    std::unique_ptr<gui::AnimCompositor> _compositor;
 };
 
 } // namespace esp_brookesia::ai_framework
@@ -22,6 +22,8 @@
 /* Services - Storage NVS */
 #if ESP_BROOKESIA_SERVICES_ENABLE_STORAGE_NVS
 #   include "services/storage_nvs/esp_brookesia_service_storage_nvs.hpp"
+#   include "services/storage_nvs/esp_brookesia_service_storage_nvs_flash_backend.hpp"
+#   include "services/storage_nvs/esp_brookesia_service_storage_nvs_file_backend.hpp"
 #endif
 
 /* Systems */
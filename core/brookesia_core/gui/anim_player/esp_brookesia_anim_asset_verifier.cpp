@@ -0,0 +1,228 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "esp_brookesia_anim_asset_verifier.hpp"
+
+#define ANIM_VERIFY_THREAD_NAME             "anim_verify"
+#define ANIM_VERIFY_THREAD_PRIORITY         (1)
+#define ANIM_VERIFY_THREAD_STACK_SIZE       (4 * 1024)
+#define ANIM_VERIFY_THREAD_STACK_CAPS_EXT   (true)
+
+#define ANIM_VERIFY_CHUNK_SIZE_DEFAULT      (16 * 1024)
+
+/**
+ * The checksum of an animation file (.aaf) is the 32-bit sum of the `table_and_data_length` bytes after the header,
+ * see `esp_brookesia_anim_frame_index.cpp` for the header layout.
+ */
+#define AAF_HEADER_SIZE                     (12)
+#define AAF_CHECKSUM_OFFSET                 (4)
+#define AAF_LENGTH_OFFSET                   (8)
+
+namespace esp_brookesia::gui {
+
+static uint32_t read_u32(const uint8_t *ptr)
+{
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static uint32_t sum_bytes(const uint8_t *data, size_t length)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < length; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+AnimAssetVerifier::~AnimAssetVerifier()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_is_begun) {
+        ESP_UTILS_CHECK_FALSE_EXIT(del(), "Failed to delete asset verifier");
+    }
+}
+
+bool AnimAssetVerifier::begin(const std::vector<Asset> &assets, const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: assets(%d), enable_background(%d), chunk_size(%d)", static_cast<int>(assets.size()),
+        config.enable_background, static_cast<int>(config.chunk_size)
+    );
+
+    if (_is_begun) {
+        ESP_UTILS_LOGW("Already begun");
+        return true;
+    }
+
+    _config = config;
+    if (_config.chunk_size == 0) {
+        _config.chunk_size = ANIM_VERIFY_CHUNK_SIZE_DEFAULT;
+    }
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(_assets = assets, false, "Failed to copy assets");
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(_states.assign(assets.size(), State::Unknown), false, "Failed to init states");
+    _is_begun = true;
+
+    if (!_config.enable_background) {
+        return true;
+    }
+
+    _thread_need_exit = false;
+    esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+        .name = ANIM_VERIFY_THREAD_NAME,
+        .priority = ANIM_VERIFY_THREAD_PRIORITY,
+        .stack_size = ANIM_VERIFY_THREAD_STACK_SIZE,
+        .stack_in_ext = ANIM_VERIFY_THREAD_STACK_CAPS_EXT,
+    });
+    _thread = boost::thread([this] {
+        ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+        for (int i = 0; (i < static_cast<int>(_assets.size())) && !_thread_need_exit; i++)
+        {
+            {
+                std::lock_guard lock(_mutex);
+                if (_states[i] != State::Unknown) {
+                    continue;
+                }
+                _states[i] = State::Verifying;
+            }
+
+            bool is_valid = false;
+            if (!checksumAsset(i, true, is_valid)) {
+                // Interrupted, the asset has been verified by a caller or the verifier is being deleted
+                continue;
+            }
+            setState(i, is_valid ? State::Valid : State::Invalid);
+        }
+        ESP_UTILS_LOGD("Background verification finished");
+    });
+
+    return true;
+}
+
+bool AnimAssetVerifier::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    _thread_need_exit = true;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _assets.clear();
+    _states.clear();
+    _is_begun = false;
+
+    return true;
+}
+
+bool AnimAssetVerifier::verify(int index)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (index >= 0) && (index < static_cast<int>(_assets.size())), false, "Invalid index: %d", index
+    );
+
+    {
+        std::lock_guard lock(_mutex);
+        if (_states[index] == State::Valid) {
+            return true;
+        } else if (_states[index] == State::Invalid) {
+            return false;
+        }
+        // A low priority thread may take long to finish, so check the asset here even if it is being verified
+        _states[index] = State::Verifying;
+    }
+
+    bool is_valid = false;
+    checksumAsset(index, false, is_valid);
+    setState(index, is_valid ? State::Valid : State::Invalid);
+    if (!is_valid) {
+        ESP_UTILS_LOGE("Asset(%d) checksum mismatch", index);
+    }
+
+    return is_valid;
+}
+
+AnimAssetVerifier::State AnimAssetVerifier::getState(int index)
+{
+    std::lock_guard lock(_mutex);
+
+    if ((index < 0) || (index >= static_cast<int>(_states.size()))) {
+        return State::Unknown;
+    }
+
+    return _states[index];
+}
+
+bool AnimAssetVerifier::checkAsset(const void *data, size_t length)
+{
+    if ((data == nullptr) || (length < AAF_HEADER_SIZE)) {
+        return false;
+    }
+
+    auto bytes = static_cast<const uint8_t *>(data);
+    size_t data_length = read_u32(bytes + AAF_LENGTH_OFFSET);
+    if (data_length > length - AAF_HEADER_SIZE) {
+        return false;
+    }
+
+    return (sum_bytes(bytes + AAF_HEADER_SIZE, data_length) == read_u32(bytes + AAF_CHECKSUM_OFFSET));
+}
+
+bool AnimAssetVerifier::checksumAsset(int index, bool is_background, bool &is_valid)
+{
+    auto &asset = _assets[index];
+    if (!is_background) {
+        is_valid = checkAsset(asset.data, asset.length);
+        return true;
+    }
+
+    // Same as `checkAsset()`, but split into chunks so that the thread can give up early
+    is_valid = false;
+    auto bytes = static_cast<const uint8_t *>(asset.data);
+    if ((bytes == nullptr) || (asset.length < AAF_HEADER_SIZE)) {
+        return true;
+    }
+    size_t data_length = read_u32(bytes + AAF_LENGTH_OFFSET);
+    if (data_length > asset.length - AAF_HEADER_SIZE) {
+        return true;
+    }
+
+    uint32_t sum = 0;
+    for (size_t offset = 0; offset < data_length; offset += _config.chunk_size) {
+        if (_thread_need_exit || (getState(index) != State::Verifying)) {
+            return false;
+        }
+        sum += sum_bytes(bytes + AAF_HEADER_SIZE + offset, std::min(_config.chunk_size, data_length - offset));
+    }
+    is_valid = (sum == read_u32(bytes + AAF_CHECKSUM_OFFSET));
+
+    return true;
+}
+
+void AnimAssetVerifier::setState(int index, State state)
+{
+    std::lock_guard lock(_mutex);
+
+    // The result of whichever finishes first is kept
+    if (_states[index] == State::Verifying) {
+        _states[index] = state;
+    }
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "boost/thread.hpp"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Verifies the checksum of each animation (.aaf) on its first use instead of the whole partition at boot,
+ *        optionally ahead of time in a low priority background thread. The results are kept until `del()`.
+ */
+class AnimAssetVerifier {
+public:
+    struct Asset {
+        const void *data;
+        size_t length;
+    };
+
+    struct Config {
+        bool enable_background;
+        size_t chunk_size;          // Bytes checked by the background thread between exit checks, `0` uses the default
+    };
+
+    enum class State : uint8_t {
+        Unknown,
+        Verifying,
+        Valid,
+        Invalid,
+    };
+
+    AnimAssetVerifier() = default;
+    ~AnimAssetVerifier();
+
+    AnimAssetVerifier(const AnimAssetVerifier &) = delete;
+    AnimAssetVerifier &operator=(const AnimAssetVerifier &) = delete;
+
+    bool begin(const std::vector<Asset> &assets, const Config &config);
+    bool del();
+
+    /**
+     * @brief Verify the asset if it has not been verified yet, the caller never waits for the background thread
+     */
+    bool verify(int index);
+    State getState(int index);
+
+    bool isBegun() const
+    {
+        return _is_begun;
+    }
+
+    static bool checkAsset(const void *data, size_t length);
+
+private:
+    bool checksumAsset(int index, bool is_background, bool &is_valid);
+    void setState(int index, State state);
+
+    bool _is_begun = false;
+    Config _config = {};
+    std::vector<Asset> _assets;
+    std::vector<State> _states;
+    std::mutex _mutex;
+    std::atomic<bool> _thread_need_exit = false;
+    boost::thread _thread;
+};
+
+} // namespace esp_brookesia::gui
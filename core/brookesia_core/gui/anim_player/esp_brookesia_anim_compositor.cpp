@@ -0,0 +1,360 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include "esp_heap_caps.h"
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "esp_brookesia_anim_compositor.hpp"
+
+#define ANIM_COMPOSITOR_THREAD_NAME             "anim_compose"
+#define ANIM_COMPOSITOR_THREAD_STACK_SIZE       (6 * 1024)
+#define ANIM_COMPOSITOR_THREAD_STACK_CAPS_EXT   (true)
+
+namespace esp_brookesia::gui {
+
+AnimCompositor::FlushReadySignal AnimCompositor::flush_ready_signal;
+
+AnimCompositor::~AnimCompositor()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_is_begun) {
+        ESP_UTILS_CHECK_FALSE_EXIT(del(), "Failed to delete compositor");
+    }
+}
+
+bool AnimCompositor::begin(const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: canvas(%d,%d,%d,%d), buffer_in_ext(%d)", config.canvas.coord_x, config.canvas.coord_y,
+        config.canvas.width, config.canvas.height, config.buffer_in_ext
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (config.canvas.width > 0) && (config.canvas.height > 0), false, "Invalid canvas size"
+    );
+
+    if (_is_begun) {
+        ESP_UTILS_LOGW("Already begun");
+        return true;
+    }
+
+    esp_utils::function_guard del_guard([this]() {
+        ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+        ESP_UTILS_CHECK_FALSE_EXIT(del(), "Failed to delete compositor");
+    });
+
+    _config = config;
+    _output = allocateBuffer(static_cast<size_t>(config.canvas.width) * config.canvas.height);
+    ESP_UTILS_CHECK_NULL_RETURN(_output, false, "Failed to allocate output buffer");
+
+    _thread_need_exit = false;
+    {
+        esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+            .name = ANIM_COMPOSITOR_THREAD_NAME,
+            .stack_size = ANIM_COMPOSITOR_THREAD_STACK_SIZE,
+            .stack_in_ext = ANIM_COMPOSITOR_THREAD_STACK_CAPS_EXT,
+        });
+        _thread = boost::thread([this] {
+            ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+            while (!_thread_need_exit)
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [this]() {
+                    return _thread_need_exit || !_dirty_rects.empty();
+                });
+                if (_thread_need_exit) {
+                    ESP_UTILS_LOGD("Compositor thread not running, exit");
+                    break;
+                }
+
+                // Areas changed while the previous ones were being flushed are collected for the next round
+                _compose_rects.swap(_dirty_rects);
+                _dirty_rects.clear();
+                for (auto &rect : _compose_rects) {
+                    compose(rect);
+                    _is_flushing = true;
+                    lock.unlock();
+
+                    flush_ready_signal(rect.x_start, rect.y_start, rect.x_end, rect.y_end, _output.get(), this);
+
+                    lock.lock();
+                    _cv.wait(lock, [this]() {
+                        return _thread_need_exit || !_is_flushing;
+                    });
+                    if (_thread_need_exit) {
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    del_guard.release();
+    _is_begun = true;
+
+    return true;
+}
+
+bool AnimCompositor::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    {
+        std::lock_guard lock(_mutex);
+        _thread_need_exit = true;
+        _cv.notify_all();
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    _layers.clear();
+    _dirty_rects.clear();
+    _compose_rects.clear();
+    _new_rects.clear();
+    _split_rects.clear();
+    _output.reset();
+    _is_flushing = false;
+    _is_begun = false;
+
+    return true;
+}
+
+bool AnimCompositor::attach(AnimPlayer &player, const AnimPlayerCanvasConfig &canvas, const LayerConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: player(%p), canvas(%d,%d,%d,%d), color_key(%d,0x%04x)", &player, canvas.coord_x, canvas.coord_y,
+        canvas.width, canvas.height, config.enable_color_key, config.color_key
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (canvas.width > 0) && (canvas.height > 0) && (canvas.coord_x >= _config.canvas.coord_x) &&
+        (canvas.coord_y >= _config.canvas.coord_y) &&
+        (canvas.coord_x + canvas.width <= _config.canvas.coord_x + _config.canvas.width) &&
+        (canvas.coord_y + canvas.height <= _config.canvas.coord_y + _config.canvas.height),
+        false, "Layer is out of the canvas"
+    );
+
+    size_t pixels = static_cast<size_t>(canvas.width) * canvas.height;
+    auto layer = std::make_unique<Layer>(Layer{
+        .canvas = canvas,
+        .config = config,
+        .back = allocateBuffer(pixels),
+        .front = allocateBuffer(pixels),
+        .dirty_y_start = canvas.height,
+        .dirty_y_end = 0,
+        .is_visible = false,
+    });
+    ESP_UTILS_CHECK_NULL_RETURN(layer, false, "Failed to create layer");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (layer->back != nullptr) && (layer->front != nullptr), false, "Failed to allocate layer buffers"
+    );
+
+    size_t layer_index = 0;
+    {
+        std::lock_guard lock(_mutex);
+        layer_index = _layers.size();
+        _layers.emplace_back(std::move(layer));
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(player.setOutputHandler({
+        .flush = [this, layer_index](int x_start, int y_start, int x_end, int y_end, const void *data) {
+            onLayerFlush(layer_index, x_start, y_start, x_end, y_end, data);
+        },
+        .clear = [this, layer_index](int, int, int, int) {
+            onLayerClear(layer_index);
+        },
+        .frame_end = [this, layer_index]() {
+            onLayerFrameEnd(layer_index);
+        },
+    }), false, "Failed to set output handler");
+
+    return true;
+}
+
+bool AnimCompositor::notifyFlushFinished()
+{
+    std::lock_guard lock(_mutex);
+    _is_flushing = false;
+    _cv.notify_all();
+
+    return true;
+}
+
+AnimCompositor::Buffer AnimCompositor::allocateBuffer(size_t pixels) const
+{
+    uint32_t caps = (_config.buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+    return Buffer(static_cast<uint16_t *>(heap_caps_calloc(pixels, sizeof(uint16_t), caps)), heap_caps_free);
+}
+
+void AnimCompositor::onLayerFlush(
+    size_t layer_index, int x_start, int y_start, int x_end, int y_end, const void *data
+)
+{
+    std::lock_guard lock(_mutex);
+
+    ESP_UTILS_CHECK_FALSE_EXIT(layer_index < _layers.size(), "Invalid layer: %d", static_cast<int>(layer_index));
+    auto &layer = *_layers[layer_index];
+    auto &canvas = layer.canvas;
+
+    int local_x = x_start - canvas.coord_x;
+    int local_y = y_start - canvas.coord_y;
+    int width = x_end - x_start;
+    int height = y_end - y_start;
+    ESP_UTILS_CHECK_FALSE_EXIT(
+        (local_x >= 0) && (local_y >= 0) && (width > 0) && (height > 0) &&
+        (local_x + width <= canvas.width) && (local_y + height <= canvas.height),
+        "Invalid area: (%d,%d)-(%d,%d)", x_start, y_start, x_end, y_end
+    );
+
+    auto src = static_cast<const uint16_t *>(data);
+    for (int y = 0; y < height; y++) {
+        memcpy(
+            layer.back.get() + (local_y + y) * canvas.width + local_x, src + y * width, width * sizeof(uint16_t)
+        );
+    }
+
+    layer.dirty_y_start = std::min(layer.dirty_y_start, local_y);
+    layer.dirty_y_end = std::max(layer.dirty_y_end, local_y + height);
+}
+
+void AnimCompositor::onLayerFrameEnd(size_t layer_index)
+{
+    std::lock_guard lock(_mutex);
+
+    ESP_UTILS_CHECK_FALSE_EXIT(layer_index < _layers.size(), "Invalid layer: %d", static_cast<int>(layer_index));
+    auto &layer = *_layers[layer_index];
+    auto &canvas = layer.canvas;
+    if (layer.dirty_y_start >= layer.dirty_y_end) {
+        return;
+    }
+
+    // Only complete frames are composed, so a layer never tears. The rows written by the frame are copied back, so
+    // the back buffer holds the last frame again before the next frame only updates some of its rows.
+    std::swap(layer.back, layer.front);
+    size_t offset = static_cast<size_t>(layer.dirty_y_start) * canvas.width;
+    size_t pixels = static_cast<size_t>(layer.dirty_y_end - layer.dirty_y_start) * canvas.width;
+    memcpy(layer.back.get() + offset, layer.front.get() + offset, pixels * sizeof(uint16_t));
+    // A hidden layer is shown as a whole, since the other rows were cleared from the canvas
+    if (!layer.is_visible) {
+        layer.dirty_y_start = 0;
+        layer.dirty_y_end = canvas.height;
+        layer.is_visible = true;
+    }
+    addDirtyRect({
+        canvas.coord_x, canvas.coord_y + layer.dirty_y_start, canvas.coord_x + canvas.width,
+        canvas.coord_y + layer.dirty_y_end
+    });
+    layer.dirty_y_start = canvas.height;
+    layer.dirty_y_end = 0;
+    _cv.notify_all();
+}
+
+void AnimCompositor::onLayerClear(size_t layer_index)
+{
+    std::lock_guard lock(_mutex);
+
+    ESP_UTILS_CHECK_FALSE_EXIT(layer_index < _layers.size(), "Invalid layer: %d", static_cast<int>(layer_index));
+    auto &layer = *_layers[layer_index];
+    auto &canvas = layer.canvas;
+
+    layer.is_visible = false;
+    addDirtyRect({canvas.coord_x, canvas.coord_y, canvas.coord_x + canvas.width, canvas.coord_y + canvas.height});
+    _cv.notify_all();
+}
+
+void AnimCompositor::addDirtyRect(Rect rect)
+{
+    // Only the parts which are not dirty yet are added, so overlapping areas are transferred once. Merging them into
+    // a bounding box would compose, and blank, pixels which are not covered by any layer.
+    _new_rects.clear();
+    _new_rects.push_back(rect);
+    for (auto &dirty_rect : _dirty_rects) {
+        _split_rects.clear();
+        for (auto &new_rect : _new_rects) {
+            subtractRect(new_rect, dirty_rect, _split_rects);
+        }
+        _new_rects.swap(_split_rects);
+        if (_new_rects.empty()) {
+            return;
+        }
+    }
+    _dirty_rects.insert(_dirty_rects.end(), _new_rects.begin(), _new_rects.end());
+}
+
+void AnimCompositor::subtractRect(const Rect &rect, const Rect &hole, std::vector<Rect> &pieces)
+{
+    if ((hole.x_start >= rect.x_end) || (rect.x_start >= hole.x_end) ||
+            (hole.y_start >= rect.y_end) || (rect.y_start >= hole.y_end)) {
+        pieces.push_back(rect);
+        return;
+    }
+
+    // The bands above and below the hole span the whole width, the ones beside it only the overlapped rows
+    int y_start = std::max(rect.y_start, hole.y_start);
+    int y_end = std::min(rect.y_end, hole.y_end);
+    if (rect.y_start < y_start) {
+        pieces.push_back({rect.x_start, rect.y_start, rect.x_end, y_start});
+    }
+    if (y_end < rect.y_end) {
+        pieces.push_back({rect.x_start, y_end, rect.x_end, rect.y_end});
+    }
+    if (rect.x_start < hole.x_start) {
+        pieces.push_back({rect.x_start, y_start, hole.x_start, y_end});
+    }
+    if (hole.x_end < rect.x_end) {
+        pieces.push_back({hole.x_end, y_start, rect.x_end, y_end});
+    }
+}
+
+void AnimCompositor::compose(const Rect &rect)
+{
+    int width = rect.x_end - rect.x_start;
+    auto output = _output.get();
+
+    for (int y = rect.y_start; y < rect.y_end; y++) {
+        auto dest = output + (y - rect.y_start) * width;
+        memset(dest, 0, width * sizeof(uint16_t));
+
+        for (auto &layer_ptr : _layers) {
+            auto &layer = *layer_ptr;
+            auto &canvas = layer.canvas;
+            if (!layer.is_visible || (y < canvas.coord_y) || (y >= canvas.coord_y + canvas.height)) {
+                continue;
+            }
+            int x_start = std::max(rect.x_start, canvas.coord_x);
+            int x_end = std::min(rect.x_end, canvas.coord_x + canvas.width);
+            if (x_start >= x_end) {
+                continue;
+            }
+
+            auto src = layer.front.get() + (y - canvas.coord_y) * canvas.width + (x_start - canvas.coord_x);
+            auto dst = dest + (x_start - rect.x_start);
+            int count = x_end - x_start;
+            if (!layer.config.enable_color_key) {
+                memcpy(dst, src, count * sizeof(uint16_t));
+                continue;
+            }
+            for (int i = 0; i < count; i++) {
+                if (src[i] != layer.config.color_key) {
+                    dst[i] = src[i];
+                }
+            }
+        }
+    }
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "boost/signals2/signal.hpp"
+#include "boost/thread.hpp"
+#include "esp_brookesia_anim_player.hpp"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Composes the output of several players on one canvas in z-order, and flushes the changed areas once
+ */
+class AnimCompositor {
+public:
+    struct Config {
+        AnimPlayerCanvasConfig canvas;
+        bool buffer_in_ext;
+    };
+
+    struct LayerConfig {
+        bool enable_color_key;
+        uint16_t color_key;     // Pixel value in the byte order of the flushed data, treated as transparent
+    };
+
+    using FlushReadySignal = boost::signals2::signal <
+                             void(int x_start, int y_start, int x_end, int y_end, const void *data,
+                                  AnimCompositor *compositor)
+                             >;
+
+    AnimCompositor() = default;
+    ~AnimCompositor();
+
+    AnimCompositor(const AnimCompositor &) = delete;
+    AnimCompositor &operator=(const AnimCompositor &) = delete;
+
+    bool begin(const Config &config);
+    bool del();
+
+    /**
+     * @brief Add the player as the top layer, must be called before `begin()` of the player
+     */
+    bool attach(AnimPlayer &player, const AnimPlayerCanvasConfig &canvas, const LayerConfig &config);
+
+    bool notifyFlushFinished();
+
+    static FlushReadySignal flush_ready_signal;
+
+private:
+    using Buffer = std::unique_ptr<uint16_t, void(*)(void *)>;
+
+    struct Rect {
+        int x_start;
+        int y_start;
+        int x_end;
+        int y_end;
+    };
+
+    struct Layer {
+        AnimPlayerCanvasConfig canvas;
+        LayerConfig config;
+        Buffer back;            // Being written by the player
+        Buffer front;           // Last complete frame
+        int dirty_y_start;      // Rows of the back buffer written since the last frame, in layer coordinates
+        int dirty_y_end;
+        bool is_visible;
+    };
+
+    Buffer allocateBuffer(size_t pixels) const;
+    void onLayerFlush(size_t layer_index, int x_start, int y_start, int x_end, int y_end, const void *data);
+    void onLayerFrameEnd(size_t layer_index);
+    void onLayerClear(size_t layer_index);
+    void addDirtyRect(Rect rect);
+    static void subtractRect(const Rect &rect, const Rect &hole, std::vector<Rect> &pieces);
+    void compose(const Rect &rect);
+
+    bool _is_begun = false;
+    Config _config = {};
+    std::vector<std::unique_ptr<Layer>> _layers;
+    std::vector<Rect> _dirty_rects;     // Disjoint
+    std::vector<Rect> _compose_rects;
+    std::vector<Rect> _new_rects;
+    std::vector<Rect> _split_rects;
+    Buffer _output = Buffer(nullptr, nullptr);
+    bool _is_flushing = false;
+
+    std::atomic<bool> _thread_need_exit = false;
+    boost::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+};
+
+} // namespace esp_brookesia::gui
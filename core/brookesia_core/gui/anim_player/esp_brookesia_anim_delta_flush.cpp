@@ -0,0 +1,214 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include "esp_heap_caps.h"
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "esp_brookesia_anim_delta_flush.hpp"
+
+namespace esp_brookesia::gui {
+
+bool AnimDeltaFlush::begin(const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: area(%d,%d,%d,%d), pixel_bytes(%d), tile_size(%d), merge_tiles(%d), buffer_in_ext(%d)",
+        config.coord_x, config.coord_y, config.width, config.height, config.pixel_bytes, config.tile_size,
+        config.merge_tiles, config.buffer_in_ext
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN((config.width > 0) && (config.height > 0), false, "Invalid canvas size");
+    ESP_UTILS_CHECK_FALSE_RETURN(config.pixel_bytes > 0, false, "Invalid pixel bytes");
+    ESP_UTILS_CHECK_FALSE_RETURN(config.tile_size > 0, false, "Invalid tile size");
+
+    size_t frame_size = static_cast<size_t>(config.width) * config.height * config.pixel_bytes;
+    uint32_t caps = (config.buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+    _reference = Buffer(static_cast<uint8_t *>(heap_caps_malloc(frame_size, caps)), heap_caps_free);
+    ESP_UTILS_CHECK_NULL_RETURN(_reference, false, "Failed to allocate reference frame");
+    _packed = Buffer(static_cast<uint8_t *>(heap_caps_malloc(frame_size, caps)), heap_caps_free);
+    ESP_UTILS_CHECK_NULL_RETURN(_packed, false, "Failed to allocate packed buffer");
+
+    _config = config;
+    _is_reference_valid = false;
+    _is_refreshing = false;
+    _stats = {};
+    _is_begun = true;
+
+    return true;
+}
+
+bool AnimDeltaFlush::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    _reference.reset();
+    _packed.reset();
+    _tile_map.clear();
+    _tile_rects.clear();
+    _open_rects.clear();
+    _next_open_rects.clear();
+    _is_reference_valid = false;
+    _is_refreshing = false;
+    _is_begun = false;
+
+    return true;
+}
+
+bool AnimDeltaFlush::process(
+    int x_start, int y_start, int x_end, int y_end, const void *data, std::vector<Rect> &rects
+)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+    ESP_UTILS_CHECK_NULL_RETURN(data, false, "Invalid data");
+
+    rects.clear();
+
+    int local_x = x_start - _config.coord_x;
+    int local_y = y_start - _config.coord_y;
+    int width = x_end - x_start;
+    int height = y_end - y_start;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (local_x >= 0) && (local_y >= 0) && (width > 0) && (height > 0) &&
+        (local_x + width <= _config.width) && (local_y + height <= _config.height),
+        false, "Invalid area: (%d,%d)-(%d,%d)", x_start, y_start, x_end, y_end
+    );
+
+    auto src = static_cast<const uint8_t *>(data);
+    size_t pixel_bytes = _config.pixel_bytes;
+    size_t src_stride = width * pixel_bytes;
+    size_t ref_stride = _config.width * pixel_bytes;
+    uint8_t *ref = _reference.get() + local_y * ref_stride + local_x * pixel_bytes;
+
+    _stats.strips++;
+    _stats.input_bytes += src_stride * height;
+
+    // The whole strip is changed until a complete frame has been flushed after the reference was invalidated
+    if (!_is_reference_valid) {
+        for (int y = 0; y < height; y++) {
+            memcpy(ref + y * ref_stride, src + y * src_stride, src_stride);
+        }
+        if (local_y == 0) {
+            _is_refreshing = true;
+        }
+        if (_is_refreshing && (local_y + height >= _config.height)) {
+            _is_reference_valid = true;
+            _is_refreshing = false;
+        }
+        rects.push_back(Rect{x_start, y_start, x_end, y_end, data});
+        _stats.rects++;
+        _stats.output_bytes += src_stride * height;
+        return true;
+    }
+
+    int tile = _config.tile_size;
+    int tiles_x = (width + tile - 1) / tile;
+    int tiles_y = (height + tile - 1) / tile;
+    _tile_map.assign(static_cast<size_t>(tiles_x) * tiles_y, 0);
+
+    bool all_changed = true;
+    bool any_changed = false;
+    for (int ty = 0; ty < tiles_y; ty++) {
+        int row_start = ty * tile;
+        int row_end = std::min(row_start + tile, height);
+        for (int tx = 0; tx < tiles_x; tx++) {
+            int col_start = tx * tile;
+            size_t span = (std::min(col_start + tile, width) - col_start) * pixel_bytes;
+            bool changed = false;
+            for (int y = row_start; y < row_end; y++) {
+                auto src_row = src + y * src_stride + col_start * pixel_bytes;
+                auto ref_row = ref + y * ref_stride + col_start * pixel_bytes;
+                if (memcmp(src_row, ref_row, span) != 0) {
+                    changed = true;
+                    break;
+                }
+            }
+            _tile_map[ty * tiles_x + tx] = changed;
+            all_changed &= changed;
+            any_changed |= changed;
+        }
+    }
+
+    // Update the reference frame with the new content
+    for (int y = 0; y < height; y++) {
+        memcpy(ref + y * ref_stride, src + y * src_stride, src_stride);
+    }
+
+    if (!any_changed) {
+        return true;
+    }
+    if (all_changed && _config.merge_tiles) {
+        rects.push_back(Rect{x_start, y_start, x_end, y_end, data});
+        _stats.rects++;
+        _stats.output_bytes += src_stride * height;
+        return true;
+    }
+
+    // Build rectangles in tile units, merging runs of changed tiles in a row and identical runs in adjacent rows.
+    // The runs of a row are found from left to right, so they are matched with the open rects in a single pass.
+    _tile_rects.clear();
+    _open_rects.clear();
+    for (int ty = 0; ty < tiles_y; ty++) {
+        _next_open_rects.clear();
+        size_t open_index = 0;
+        int tx = 0;
+        while (tx < tiles_x) {
+            if (!_tile_map[ty * tiles_x + tx]) {
+                tx++;
+                continue;
+            }
+            int tx_end = tx + 1;
+            if (_config.merge_tiles) {
+                while ((tx_end < tiles_x) && _tile_map[ty * tiles_x + tx_end]) {
+                    tx_end++;
+                }
+            }
+
+            while ((open_index < _open_rects.size()) && (_tile_rects[_open_rects[open_index]].tx_start < tx)) {
+                open_index++;
+            }
+            if (_config.merge_tiles && (open_index < _open_rects.size()) &&
+                    (_tile_rects[_open_rects[open_index]].tx_start == tx) &&
+                    (_tile_rects[_open_rects[open_index]].tx_end == tx_end)) {
+                _tile_rects[_open_rects[open_index]].ty_end = ty + 1;
+                _next_open_rects.push_back(_open_rects[open_index]);
+            } else {
+                _tile_rects.push_back(TileRect{tx, ty, tx_end, ty + 1});
+                _next_open_rects.push_back(_tile_rects.size() - 1);
+            }
+            tx = tx_end;
+        }
+        std::swap(_open_rects, _next_open_rects);
+    }
+
+    // Pack the pixels of each rectangle into a contiguous area
+    uint8_t *packed = _packed.get();
+    for (auto &tile_rect : _tile_rects) {
+        int col_start = tile_rect.tx_start * tile;
+        int col_end = std::min(tile_rect.tx_end * tile, width);
+        int row_start = tile_rect.ty_start * tile;
+        int row_end = std::min(tile_rect.ty_end * tile, height);
+        size_t span = (col_end - col_start) * pixel_bytes;
+
+        auto rect_data = packed;
+        for (int y = row_start; y < row_end; y++) {
+            memcpy(packed, src + y * src_stride + col_start * pixel_bytes, span);
+            packed += span;
+        }
+        rects.push_back(Rect{
+            x_start + col_start, y_start + row_start, x_start + col_end, y_start + row_end, rect_data
+        });
+        _stats.output_bytes += span * (row_end - row_start);
+    }
+    _stats.rects += _tile_rects.size();
+
+    return true;
+}
+
+} // namespace esp_brookesia::gui
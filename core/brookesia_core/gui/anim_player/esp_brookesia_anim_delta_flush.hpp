@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Compares each flushed strip with the previous frame in fixed tiles and keeps only the changed areas
+ */
+class AnimDeltaFlush {
+public:
+    struct Config {
+        int coord_x;
+        int coord_y;
+        int width;
+        int height;
+        int pixel_bytes;
+        int tile_size;
+        bool merge_tiles;
+        bool buffer_in_ext;
+    };
+
+    struct Rect {
+        int x_start;
+        int y_start;
+        int x_end;
+        int y_end;
+        const void *data;
+    };
+
+    struct Stats {
+        uint32_t strips;
+        uint32_t rects;
+        uint64_t input_bytes;
+        uint64_t output_bytes;
+    };
+
+    AnimDeltaFlush() = default;
+    ~AnimDeltaFlush() = default;
+
+    AnimDeltaFlush(const AnimDeltaFlush &) = delete;
+    AnimDeltaFlush &operator=(const AnimDeltaFlush &) = delete;
+
+    bool begin(const Config &config);
+    bool del();
+
+    /**
+     * @brief Get the changed rectangles of a strip and update the reference frame. The data of the rectangles stays
+     *        valid until the next call.
+     */
+    bool process(int x_start, int y_start, int x_end, int y_end, const void *data, std::vector<Rect> &rects);
+    void invalidate()
+    {
+        _is_reference_valid = false;
+        _is_refreshing = false;
+    }
+
+    Stats getStats() const
+    {
+        return _stats;
+    }
+    void resetStats()
+    {
+        _stats = {};
+    }
+
+    bool isBegun() const
+    {
+        return _is_begun;
+    }
+
+private:
+    using Buffer = std::unique_ptr<uint8_t, void(*)(void *)>;
+
+    struct TileRect {
+        int tx_start;
+        int ty_start;
+        int tx_end;
+        int ty_end;
+    };
+
+    bool _is_begun = false;
+    bool _is_reference_valid = false;
+    bool _is_refreshing = false;
+    Config _config = {};
+    Buffer _reference = Buffer(nullptr, nullptr);
+    Buffer _packed = Buffer(nullptr, nullptr);
+    std::vector<uint8_t> _tile_map;
+    std::vector<TileRect> _tile_rects;
+    // Indexes of the rects reaching the last row, sorted by column, and of those reaching the current row
+    std::vector<size_t> _open_rects;
+    std::vector<size_t> _next_open_rects;
+    Stats _stats = {};
+};
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstdio>
+#include <sys/stat.h>
+#include "esp_heap_caps.h"
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "esp_brookesia_anim_file_source.hpp"
+
+// The VFS of ESP-IDF (FATFS, SPIFFS, LittleFS) does not support `mmap()`, only the Linux target does
+#if !defined(ESP_PLATFORM) || defined(CONFIG_IDF_TARGET_LINUX)
+#   define ANIM_FILE_SOURCE_MMAP_SUPPORTED  (1)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <unistd.h>
+#else
+#   define ANIM_FILE_SOURCE_MMAP_SUPPORTED  (0)
+#endif
+
+#define ANIM_FILE_READ_CHUNK_SIZE_DEFAULT       (16 * 1024)
+
+#define ANIM_FILE_LOAD_THREAD_NAME              "anim_file_load"
+#define ANIM_FILE_LOAD_THREAD_STACK_SIZE        (4 * 1024)
+#define ANIM_FILE_LOAD_THREAD_STACK_CAPS_EXT    (true)
+
+namespace esp_brookesia::gui {
+
+AnimFileSource::~AnimFileSource()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (isOpen()) {
+        ESP_UTILS_CHECK_FALSE_EXIT(close(), "Failed to close file source");
+    }
+}
+
+bool AnimFileSource::open(const char *path, const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_NULL_RETURN(path, false, "Invalid path");
+    ESP_UTILS_LOGD(
+        "Param: path(%s), read_chunk_size(%d), buffer_in_ext(%d)", path, static_cast<int>(config.read_chunk_size),
+        config.buffer_in_ext
+    );
+
+    struct stat st = {};
+    ESP_UTILS_CHECK_FALSE_RETURN(stat(path, &st) == 0, false, "File not exists: %s", path);
+    ESP_UTILS_CHECK_FALSE_RETURN(st.st_size > 0, false, "Empty file: %s", path);
+
+    cancelLoad();
+    _path = path;
+    _config = config;
+    if (_config.read_chunk_size == 0) {
+        _config.read_chunk_size = ANIM_FILE_READ_CHUNK_SIZE_DEFAULT;
+    }
+    _length = static_cast<size_t>(st.st_size);
+
+    return true;
+}
+
+bool AnimFileSource::close()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    cancelLoad();
+    _path.clear();
+    _length = 0;
+
+    return true;
+}
+
+bool AnimFileSource::load()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOpen(), false, "Not open");
+
+    if (isLoaded()) {
+        return true;
+    }
+
+    if (loadByMap()) {
+        return true;
+    }
+    if (!loadByRead()) {
+        if (!_load_need_cancel) {
+            ESP_UTILS_LOGE("Failed to load file: %s", _path.c_str());
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool AnimFileSource::startLoad(LoadDoneCallback callback)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOpen(), false, "Not open");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_load_thread.joinable(), false, "Already loading");
+
+    _load_need_cancel = false;
+    esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+        .name = ANIM_FILE_LOAD_THREAD_NAME,
+        .stack_size = ANIM_FILE_LOAD_THREAD_STACK_SIZE,
+        .stack_in_ext = ANIM_FILE_LOAD_THREAD_STACK_CAPS_EXT,
+    });
+    _load_thread = boost::thread([this, callback = std::move(callback)] {
+        ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+        bool is_loaded = load();
+        if (callback) {
+            callback(is_loaded);
+        }
+    });
+
+    return true;
+}
+
+bool AnimFileSource::waitLoad()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_load_thread.joinable()) {
+        _load_thread.join();
+    }
+
+    return isLoaded();
+}
+
+void AnimFileSource::cancelLoad()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    _load_need_cancel = true;
+    if (_load_thread.joinable()) {
+        _load_thread.join();
+    }
+    _load_need_cancel = false;
+    unload();
+}
+
+void AnimFileSource::unload()
+{
+#if ANIM_FILE_SOURCE_MMAP_SUPPORTED
+    if (_map_address != nullptr) {
+        munmap(_map_address, _length);
+        _map_address = nullptr;
+    }
+#endif
+    _buffer.reset();
+    _data = nullptr;
+}
+
+bool AnimFileSource::loadByMap()
+{
+#if ANIM_FILE_SOURCE_MMAP_SUPPORTED
+    int fd = ::open(_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    void *address = mmap(nullptr, _length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        ESP_UTILS_LOGD("Map file failed, fall back to read: %s", _path.c_str());
+        return false;
+    }
+
+    // Let the kernel read the file ahead of the decoder, instead of faulting each page in on first access
+    madvise(address, _length, MADV_WILLNEED);
+    _map_address = address;
+    _data = address;
+    ESP_UTILS_LOGD("Mapped file: %s, length(%d)", _path.c_str(), static_cast<int>(_length));
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool AnimFileSource::loadByRead()
+{
+    uint32_t caps = (_config.buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+    _buffer = std::unique_ptr<uint8_t, void(*)(void *)>(
+                  static_cast<uint8_t *>(heap_caps_malloc(_length, caps)), heap_caps_free
+              );
+    ESP_UTILS_CHECK_NULL_RETURN(_buffer, false, "Failed to allocate buffer(%d)", static_cast<int>(_length));
+
+    std::unique_ptr<FILE, int(*)(FILE *)> file(fopen(_path.c_str(), "rb"), fclose);
+    if (file == nullptr) {
+        ESP_UTILS_LOGE("Failed to open file: %s", _path.c_str());
+        _buffer.reset();
+        return false;
+    }
+    // Read in large chunks straight into the destination, so no intermediate copy is made
+    setvbuf(file.get(), nullptr, _IONBF, 0);
+
+    size_t offset = 0;
+    while (offset < _length) {
+        if (_load_need_cancel) {
+            ESP_UTILS_LOGD("Load cancelled: %s, offset(%d)", _path.c_str(), static_cast<int>(offset));
+            _buffer.reset();
+            return false;
+        }
+        size_t chunk = std::min(_config.read_chunk_size, _length - offset);
+        size_t read_size = fread(_buffer.get() + offset, 1, chunk, file.get());
+        if (read_size != chunk) {
+            ESP_UTILS_LOGE(
+                "Failed to read file: %s, offset(%d), chunk(%d)", _path.c_str(), static_cast<int>(offset),
+                static_cast<int>(chunk)
+            );
+            _buffer.reset();
+            return false;
+        }
+        offset += read_size;
+    }
+
+    _data = _buffer.get();
+    ESP_UTILS_LOGD("Read file: %s, length(%d)", _path.c_str(), static_cast<int>(_length));
+
+    return true;
+}
+
+} // namespace esp_brookesia::gui
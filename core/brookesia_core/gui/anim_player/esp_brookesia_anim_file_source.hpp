@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "boost/thread.hpp"
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Animation file which is only resident in memory while it is loaded. The file is memory-mapped where the
+ *        platform supports it, otherwise it is read chunk by chunk into a single buffer, optionally in a
+ *        background thread so that the caller is not blocked by slow storage.
+ */
+class AnimFileSource {
+public:
+    struct Config {
+        size_t read_chunk_size;
+        bool buffer_in_ext;
+    };
+
+    using LoadDoneCallback = std::function<void(bool is_loaded)>;
+
+    AnimFileSource() = default;
+    ~AnimFileSource();
+
+    AnimFileSource(const AnimFileSource &) = delete;
+    AnimFileSource &operator=(const AnimFileSource &) = delete;
+
+    bool open(const char *path, const Config &config);
+    bool close();
+    bool load();
+    void unload();
+
+    /**
+     * @brief Load the file in a background thread, `callback` is called from that thread when the load ends.
+     *        The data must not be accessed until `waitLoad()` returns
+     */
+    bool startLoad(LoadDoneCallback callback);
+    bool waitLoad();
+    /**
+     * @brief Stop the background load between two chunks and release what has been loaded
+     */
+    void cancelLoad();
+
+    bool isOpen() const
+    {
+        return !_path.empty();
+    }
+    bool isLoaded() const
+    {
+        return (_data != nullptr);
+    }
+    const std::string &getPath() const
+    {
+        return _path;
+    }
+    const void *getData() const
+    {
+        return _data;
+    }
+    size_t getLength() const
+    {
+        return _length;
+    }
+
+private:
+    bool loadByMap();
+    bool loadByRead();
+
+    std::string _path;
+    Config _config = {};
+    size_t _length = 0;
+    const void *_data = nullptr;
+    std::unique_ptr<uint8_t, void(*)(void *)> _buffer = {nullptr, nullptr};
+    void *_map_address = nullptr;
+    std::atomic<bool> _load_need_cancel = false;
+    boost::thread _load_thread;
+};
+
+} // namespace esp_brookesia::gui
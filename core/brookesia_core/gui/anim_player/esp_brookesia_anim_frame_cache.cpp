@@ -0,0 +1,251 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include "esp_heap_caps.h"
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "pixel/esp_brookesia_pixel_kernels.hpp"
+#include "esp_brookesia_anim_frame_cache.hpp"
+
+namespace esp_brookesia::gui {
+
+AnimFrameCache::~AnimFrameCache()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_is_begun) {
+        ESP_UTILS_CHECK_FALSE_EXIT(del(), "Failed to delete frame cache");
+    }
+}
+
+bool AnimFrameCache::begin(const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: budget_bytes(%d), buffer_in_ext(%d)", static_cast<int>(config.budget_bytes), config.buffer_in_ext
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(config.budget_bytes > 0, false, "Invalid budget");
+
+    if (_is_begun) {
+        ESP_UTILS_LOGW("Already begun");
+        return true;
+    }
+
+    std::lock_guard lock(_mutex);
+    _config = config;
+    _stats = {};
+    _stats.budget_bytes = config.budget_bytes;
+    _is_begun = true;
+
+    return true;
+}
+
+bool AnimFrameCache::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    abortFrame();
+    clear();
+
+    std::lock_guard lock(_mutex);
+    _recording_strips.clear();
+    _recording_strips.shrink_to_fit();
+    _recording_buffer.reset();
+    _recording_capacity = 0;
+    _recording_size_hint = 0;
+    _is_begun = false;
+
+    return true;
+}
+
+bool AnimFrameCache::beginFrame(int animation_index, int frame_index)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+
+    _recording_key = makeKey(animation_index, frame_index);
+    _recording_strips.clear();
+    _recording_size = 0;
+    _is_recording = true;
+
+    return true;
+}
+
+bool AnimFrameCache::appendStrip(
+    int x_start, int y_start, int x_end, int y_end, const void *data, size_t size, bool swap_bytes
+)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_recording, false, "Not recording");
+    ESP_UTILS_CHECK_NULL_RETURN(data, false, "Invalid data");
+
+    auto offset = _recording_size;
+    if (offset + size > _config.budget_bytes) {
+        ESP_UTILS_LOGD("Frame exceeds budget, skip");
+        abortFrame();
+        return true;
+    }
+
+    if (offset + size > _recording_capacity) {
+        size_t capacity = std::max({offset + size, _recording_capacity * 2, _recording_size_hint});
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            reserveRecordingBuffer(std::min(capacity, _config.budget_bytes)), false, "Failed to reserve buffer"
+        );
+    }
+    if (swap_bytes) {
+        pixel::swap16(_recording_buffer.get() + offset, data, size / sizeof(uint16_t));
+    } else {
+        memcpy(_recording_buffer.get() + offset, data, size);
+    }
+    _recording_size += size;
+    _recording_strips.push_back(Strip{
+        .x_start = x_start,
+        .y_start = y_start,
+        .x_end = x_end,
+        .y_end = y_end,
+        .offset = offset,
+        .size = size,
+    });
+
+    return true;
+}
+
+bool AnimFrameCache::endFrame()
+{
+    if (!_is_recording) {
+        return true;
+    }
+    _is_recording = false;
+
+    auto size = _recording_size;
+    ESP_UTILS_CHECK_FALSE_RETURN(size > 0, false, "Empty frame");
+    _recording_size_hint = size;
+    // The buffer is only larger than the frame for the first frame of an animation, shrink it to keep the budget exact
+    if (_recording_capacity != size) {
+        ESP_UTILS_CHECK_FALSE_RETURN(reserveRecordingBuffer(size), false, "Failed to shrink buffer");
+    }
+
+    auto frame = std::make_shared<Frame>(Frame{
+        .strips = std::move(_recording_strips),
+        .size = size,
+        .buffer = std::move(_recording_buffer),
+    });
+    ESP_UTILS_CHECK_NULL_RETURN(frame, false, "Failed to create frame");
+    _recording_buffer = Buffer(nullptr, nullptr);
+    _recording_capacity = 0;
+    _recording_strips = {};
+
+    std::lock_guard lock(_mutex);
+    evict(size);
+
+    auto it = _entries.find(_recording_key);
+    if (it != _entries.end()) {
+        _stats.used_bytes -= it->second.frame->size;
+        _lru_list.erase(it->second.lru_it);
+        _entries.erase(it);
+    }
+    _lru_list.push_front(_recording_key);
+    _entries.emplace(_recording_key, Entry{
+        .frame = frame,
+        .lru_it = _lru_list.begin(),
+    });
+    _stats.used_bytes += size;
+    _stats.insertions++;
+
+    return true;
+}
+
+void AnimFrameCache::abortFrame()
+{
+    _is_recording = false;
+    _recording_strips.clear();
+    _recording_size = 0;
+}
+
+AnimFrameCache::FramePtr AnimFrameCache::find(int animation_index, int frame_index)
+{
+    std::lock_guard lock(_mutex);
+
+    auto it = _entries.find(makeKey(animation_index, frame_index));
+    if (it == _entries.end()) {
+        _stats.misses++;
+        return nullptr;
+    }
+
+    // Move to the most recently used position
+    _lru_list.splice(_lru_list.begin(), _lru_list, it->second.lru_it);
+    _stats.hits++;
+
+    return it->second.frame;
+}
+
+bool AnimFrameCache::contains(int animation_index, int frame_index)
+{
+    std::lock_guard lock(_mutex);
+
+    return (_entries.find(makeKey(animation_index, frame_index)) != _entries.end());
+}
+
+void AnimFrameCache::clear()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard lock(_mutex);
+    _entries.clear();
+    _lru_list.clear();
+    _stats.used_bytes = 0;
+}
+
+AnimFrameCache::Stats AnimFrameCache::getStats()
+{
+    std::lock_guard lock(_mutex);
+
+    return _stats;
+}
+
+void AnimFrameCache::resetStats()
+{
+    std::lock_guard lock(_mutex);
+
+    _stats.hits = 0;
+    _stats.misses = 0;
+    _stats.insertions = 0;
+    _stats.evictions = 0;
+}
+
+bool AnimFrameCache::reserveRecordingBuffer(size_t capacity)
+{
+    uint32_t caps = (_config.buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+    Buffer buffer(static_cast<uint8_t *>(heap_caps_malloc(capacity, caps)), heap_caps_free);
+    ESP_UTILS_CHECK_NULL_RETURN(buffer, false, "Failed to allocate frame buffer(%d)", static_cast<int>(capacity));
+
+    if (_recording_size > 0) {
+        memcpy(buffer.get(), _recording_buffer.get(), std::min(_recording_size, capacity));
+    }
+    _recording_buffer = std::move(buffer);
+    _recording_capacity = capacity;
+
+    return true;
+}
+
+void AnimFrameCache::evict(size_t required_bytes)
+{
+    while (!_lru_list.empty() && (_stats.used_bytes + required_bytes > _config.budget_bytes)) {
+        auto key = _lru_list.back();
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            _stats.used_bytes -= it->second.frame->size;
+            _entries.erase(it);
+        }
+        _lru_list.pop_back();
+        _stats.evictions++;
+    }
+}
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace esp_brookesia::gui {
+
+class AnimFrameCache {
+public:
+    using Buffer = std::unique_ptr<uint8_t, void(*)(void *)>;
+
+    struct Config {
+        size_t budget_bytes;
+        bool buffer_in_ext;
+    };
+
+    struct Strip {
+        int x_start;
+        int y_start;
+        int x_end;
+        int y_end;
+        size_t offset;
+        size_t size;
+    };
+
+    struct Frame {
+        const void *getStripData(const Strip &strip) const
+        {
+            return buffer.get() + strip.offset;
+        }
+
+        std::vector<Strip> strips;
+        size_t size;
+        Buffer buffer;
+    };
+    using FramePtr = std::shared_ptr<const Frame>;
+
+    struct Stats {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t insertions;
+        uint32_t evictions;
+        size_t used_bytes;
+        size_t budget_bytes;
+    };
+
+    AnimFrameCache() = default;
+    ~AnimFrameCache();
+
+    AnimFrameCache(const AnimFrameCache &) = delete;
+    AnimFrameCache &operator=(const AnimFrameCache &) = delete;
+
+    bool begin(const Config &config);
+    bool del();
+
+    bool beginFrame(int animation_index, int frame_index);
+    /**
+     * @brief Copy a strip into the frame being recorded, with the bytes of each RGB565 pixel swapped if `swap_bytes`
+     */
+    bool appendStrip(
+        int x_start, int y_start, int x_end, int y_end, const void *data, size_t size, bool swap_bytes = false
+    );
+    bool endFrame();
+    void abortFrame();
+    bool isFrameRecording() const
+    {
+        return _is_recording;
+    }
+
+    FramePtr find(int animation_index, int frame_index);
+    bool contains(int animation_index, int frame_index);
+    void clear();
+
+    Stats getStats();
+    void resetStats();
+
+    bool isBegun() const
+    {
+        return _is_begun;
+    }
+
+private:
+    using Key = uint64_t;
+
+    static Key makeKey(int animation_index, int frame_index)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(animation_index)) << 32) |
+               static_cast<uint32_t>(frame_index);
+    }
+    void evict(size_t required_bytes);
+    bool reserveRecordingBuffer(size_t capacity);
+
+    struct Entry {
+        FramePtr frame;
+        std::list<Key>::iterator lru_it;
+    };
+
+    bool _is_begun = false;
+    Config _config = {};
+
+    std::mutex _mutex;
+    std::list<Key> _lru_list;
+    std::unordered_map<Key, Entry> _entries;
+    Stats _stats = {};
+
+    // Only accessed by the decoder thread
+    bool _is_recording = false;
+    Key _recording_key = 0;
+    std::vector<Strip> _recording_strips;
+    // Strips are recorded straight into the buffer of the frame, which is sized after the last recorded frame
+    Buffer _recording_buffer = Buffer(nullptr, nullptr);
+    size_t _recording_size = 0;
+    size_t _recording_capacity = 0;
+    size_t _recording_size_hint = 0;
+};
+
+} // namespace esp_brookesia::gui
@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstring>
+#include <unordered_map>
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "esp_brookesia_anim_frame_index.hpp"
+
+/**
+ * Header layout: frame_num(u32), checksum(u32), table_and_data_length(u32), then `frame_num` entries of
+ * size(u32) and offset(u32), where the offset is relative to the end of the table.
+ */
+#define AAF_HEADER_SIZE             (12)
+#define AAF_TABLE_ENTRY_SIZE        (8)
+
+namespace esp_brookesia::gui {
+
+static uint32_t read_u32(const uint8_t *ptr)
+{
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+bool AnimFrameIndex::build(const void *data, size_t length)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: data(%p), length(%d)", data, static_cast<int>(length));
+    ESP_UTILS_CHECK_NULL_RETURN(data, false, "Invalid data");
+
+    _frames.clear();
+
+    auto bytes = static_cast<const uint8_t *>(data);
+    ESP_UTILS_CHECK_FALSE_RETURN(length >= AAF_HEADER_SIZE, false, "Invalid length");
+
+    uint32_t frame_num = read_u32(bytes);
+    size_t table_end = AAF_HEADER_SIZE + static_cast<size_t>(frame_num) * AAF_TABLE_ENTRY_SIZE;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (frame_num > 0) && (table_end <= length), false, "Invalid frame num(%d)", static_cast<int>(frame_num)
+    );
+
+    std::unordered_map<uint32_t, int> offset_to_index;
+    _frames.reserve(frame_num);
+    for (uint32_t i = 0; i < frame_num; i++) {
+        auto entry = bytes + AAF_HEADER_SIZE + i * AAF_TABLE_ENTRY_SIZE;
+        uint32_t size = read_u32(entry);
+        uint32_t offset = read_u32(entry + 4);
+        if (table_end + offset + size > length) {
+            ESP_UTILS_LOGE("Invalid frame(%d): offset(%d), size(%d)", static_cast<int>(i),
+                           static_cast<int>(offset), static_cast<int>(size));
+            _frames.clear();
+            return false;
+        }
+
+        auto result = offset_to_index.emplace(offset, static_cast<int>(i));
+        _frames.push_back(Frame{
+            .offset = static_cast<uint32_t>(table_end + offset),
+            .size = size,
+            .canonical_index = result.first->second,
+        });
+    }
+
+    ESP_UTILS_LOGD(
+        "Built frame index: frames(%d), unique(%d)", static_cast<int>(frame_num),
+        static_cast<int>(offset_to_index.size())
+    );
+
+    return true;
+}
+
+} // namespace esp_brookesia::gui
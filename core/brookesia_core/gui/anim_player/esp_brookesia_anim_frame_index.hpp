@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Frame table of an animation file (.aaf), parsed from its header without decoding any frame
+ */
+class AnimFrameIndex {
+public:
+    struct Frame {
+        uint32_t offset;
+        uint32_t size;
+        int canonical_index;    // Index of the first frame which shares the same encoded data
+    };
+
+    bool build(const void *data, size_t length);
+    void clear()
+    {
+        _frames.clear();
+    }
+
+    bool isValid() const
+    {
+        return !_frames.empty();
+    }
+    int getFrameNum() const
+    {
+        return static_cast<int>(_frames.size());
+    }
+    int getCanonicalIndex(int frame_index) const
+    {
+        if ((frame_index < 0) || (frame_index >= getFrameNum())) {
+            return frame_index;
+        }
+        return _frames[frame_index].canonical_index;
+    }
+    const Frame *getFrame(int frame_index) const
+    {
+        if ((frame_index < 0) || (frame_index >= getFrameNum())) {
+            return nullptr;
+        }
+        return &_frames[frame_index];
+    }
+
+private:
+    std::vector<Frame> _frames;
+};
+
+} // namespace esp_brookesia::gui
@@ -3,25 +3,37 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
-#include <iostream>
-#include <filesystem>
 #include <vector>
-#include <fstream>
+#include <cstring>
 #include "esp_heap_caps.h"
 #include "esp_brookesia_gui_internal.h"
 #if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
 #include "private/esp_brookesia_anim_player_utils.hpp"
+#include "pixel/esp_brookesia_pixel_kernels.hpp"
 #include "esp_brookesia_anim_player.hpp"
 
-#define THREAD_EXIT_CHECK_INTERVAL_MS       100
-
 #define ANIM_EVENT_THREAD_NAME              "anim_event"
 #define ANIM_EVENT_THREAD_STACK_SIZE        (10 * 1024)
 #define ANIM_EVENT_THREAD_STACK_CAPS_EXT    (true)
 
-namespace fs = std::filesystem;
+#define ANIM_FLUSH_THREAD_NAME              "anim_flush"
+#define ANIM_FLUSH_THREAD_STACK_SIZE        (6 * 1024)
+#define ANIM_FLUSH_THREAD_STACK_CAPS_EXT    (true)
+
+#define ANIM_REPLAY_THREAD_NAME             "anim_replay"
+#define ANIM_REPLAY_THREAD_STACK_SIZE       (6 * 1024)
+#define ANIM_REPLAY_THREAD_STACK_CAPS_EXT   (true)
+
+#define ANIM_PIXEL_BYTES                    (2)
+#define ANIM_TILE_CANVAS_IN_EXT             (true)
+
+#if ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING
+#   define ANIM_PLAYER_PROFILE(player, call)   (player)->_profiler.call
+#else
+#   define ANIM_PLAYER_PROFILE(player, call)
+#endif
 
 namespace esp_brookesia::gui {
 
@@ -75,11 +87,44 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
 
             auto &anim_paths = std::get<const AnimPlayerAnimPath *>(resources_config.resources);
             ESP_UTILS_CHECK_FALSE_RETURN(
-                loadAnimationConfig(anim_paths, resources_config.num), false, "Failed to load animation config"
+                loadAnimationConfig(anim_paths, resources_config.num, {
+                .read_chunk_size = data.file.read_chunk_size,
+                .buffer_in_ext = data.file.buffer_in_ext,
+            }), false, "Failed to load animation config"
             );
         }
     }
 
+#if ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING
+    ESP_UTILS_CHECK_FALSE_RETURN(_profiler.begin({
+        .sample_num = ESP_BROOKESIA_ANIM_PLAYER_PROFILING_SAMPLE_NUM,
+        .report_interval_ms = ESP_BROOKESIA_ANIM_PLAYER_PROFILING_REPORT_INTERVAL_MS,
+        .owner = this,
+    }), false, "Failed to begin profiler");
+#endif
+    // Frame tables are parsed on the first play of each animation
+    _frame_indexes.clear();
+    _frame_indexes.resize(_animation_configs.size());
+    _asset_checked.assign(_animation_configs.size(), false);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(beginFlushPipeline(data), false, "Failed to begin flush pipeline");
+    // Pipelined strips are copied into the output buffers anyway, so the bytes are swapped by that copy instead of
+    // by an extra pass of the decoder
+    _swap_decoder_output = data.flags.enable_data_swap_bytes && isFlushPipelineEnabled();
+    ESP_UTILS_CHECK_FALSE_RETURN(beginFrameCache(data), false, "Failed to begin frame cache");
+    if (data.delta.tile_size > 0) {
+        ESP_UTILS_CHECK_FALSE_RETURN(_delta_flush.begin({
+            .coord_x = data.canvas.coord_x,
+            .coord_y = data.canvas.coord_y,
+            .width = data.canvas.width,
+            .height = data.canvas.height,
+            .pixel_bytes = ANIM_PIXEL_BYTES,
+            .tile_size = data.delta.tile_size,
+            .merge_tiles = data.delta.merge_tiles,
+            .buffer_in_ext = data.delta.buffer_in_ext,
+        }), false, "Failed to begin delta flush");
+    }
+
     {
         anim_player_config_t config = {
             .flush_cb = [](anim_player_handle_t handle, int x1, int y1, int x2, int y2, const void *data)
@@ -91,6 +136,7 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
                 auto *self = static_cast<AnimPlayer *>(anim_player_get_user_data(handle));
                 ESP_UTILS_CHECK_NULL_EXIT(self, "Invalid user data");
                 auto &canvas_config = self->_canvas_config;
+                ANIM_PLAYER_PROFILE(self, onDecodeStripBegin());
 
                 ESP_UTILS_CHECK_FALSE_EXIT(
                     (x1 > 0 || y1 > 0 || x2 <= canvas_config.width),
@@ -104,7 +150,38 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
                 int x_end = std::min(x_start + width, canvas_config.coord_x + canvas_config.width);
                 int y_end = std::min(y_start + height, canvas_config.coord_y + canvas_config.height);
 
-                flush_ready_signal(x_start, y_start, x_end, y_end, data, self);
+                // A strip starting from the top of the canvas opens a new frame
+                if (y1 == 0) {
+                    self->_decode_frame_index++;
+                    self->_position_frame = self->_decode_frame_index;
+                }
+                self->recordFrameCache(y1, x_start, y_start, x_end, y_end, data);
+
+                // The whole frame is dropped after decoding, so the decoder catches up without waiting for the output
+                if (y1 == 0) {
+                    self->_pacing_is_skipping = self->beginPacedFrame();
+                }
+                if (self->_pacing_is_skipping) {
+                    ANIM_PLAYER_PROFILE(self, onDecodeStripReleased());
+                    anim_player_flush_ready(handle);
+                    return;
+                }
+
+                // The decoder flushes every frame from the top to the bottom of the canvas
+                bool is_frame_end = (y_end >= canvas_config.coord_y + canvas_config.height);
+                if (!self->isFlushPipelineEnabled()) {
+                    self->emitFlush(x_start, y_start, x_end, y_end, data, is_frame_end);
+                    return;
+                }
+
+                // Copy the strip into a free output buffer, then let the decoder continue with the next one
+                if (!self->pushFlushPipeline(
+                            x_start, y_start, x_end, y_end, data, is_frame_end, self->_swap_decoder_output
+                        )) {
+                    ESP_UTILS_LOGE("Push flush pipeline failed, drop strip");
+                }
+                ANIM_PLAYER_PROFILE(self, onDecodeStripReleased());
+                anim_player_flush_ready(handle);
             },
             .update_cb = [](anim_player_handle_t handle, player_event_t event)
             {
@@ -112,55 +189,18 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
 
                 // ESP_UTILS_LOGD("Param: handle(%p), event(%d)", handle, static_cast<int>(event));
 
-                if ((event != PLAYER_EVENT_ALL_FRAME_DONE) && (event != PLAYER_EVENT_IDLE)) {
-                    return;
-                }
-
                 auto *self = static_cast<AnimPlayer *>(anim_player_get_user_data(handle));
                 ESP_UTILS_CHECK_NULL_EXIT(self, "Invalid user data");
 
-                std::unique_lock<std::mutex> lock(self->_player_mutex);
-
                 if (event == PLAYER_EVENT_ALL_FRAME_DONE) {
-                    self->_player_flags.is_frame_done = true;
+                    self->onPlayerFrameDone();
                 } else if (event == PLAYER_EVENT_IDLE) {
-                    self->_player_state = OperationState::Stop;
-
-                    auto &event_wrapper = self->_current_event;
-                    ESP_UTILS_CHECK_NULL_EXIT(event_wrapper, "Invalid current event");
-
-                    if (event_wrapper->event.operation == Operation::PlayOnceStop) {
-                        ESP_UTILS_LOGD("Animation play once stop: %d", event_wrapper->event.index);
-
-                        if (self->_event_queue.empty() && !self->_player_flags.is_starting) {
-                            self->sendEvent({-1, Operation::Stop, {true, true}}, false);
-                        } else {
-                            if (event_wrapper->promise != nullptr) {
-                                event_wrapper->promise->set_value();
-                            }
-                            event_wrapper.reset();
-                        }
-                    } else {
-                        if (event_wrapper->event.operation == Operation::PlayOncePause) {
-                            ESP_UTILS_LOGD("Animation play once pause: %d", event_wrapper->event.index);
-
-                            self->_player_state = OperationState::Pause;
-                        } else {
-                            ESP_UTILS_LOGD("Animation stop: %d", event_wrapper->event.index);
-                        }
-
-                        if (event_wrapper->promise != nullptr) {
-                            event_wrapper->promise->set_value();
-                        }
-                        event_wrapper.reset();
-                    }
+                    self->onPlayerIdle();
                 }
-
-                self->_player_condition.notify_all();
             },
             .user_data = this,
             .flags = {
-                .swap = static_cast<unsigned char>(data.flags.enable_data_swap_bytes),
+                .swap = static_cast<unsigned char>(data.flags.enable_data_swap_bytes && !_swap_decoder_output),
             },
             .task = {
                 .task_priority = data.task.task_priority,
@@ -185,25 +225,28 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
         _event_thread = boost::thread([this] {
             ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
+            EventWrapper event_wrapper = {};
             while (!_event_thread_need_exit)
             {
                 std::unique_lock<std::mutex> lock(_event_mutex);
-                while (_event_queue.empty() && !_event_thread_need_exit) {
-                    _event_cv.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
-                }
+                _event_cv.wait(lock, [this]() {
+                    return _event_thread_need_exit || !isEventQueueEmpty();
+                });
                 if (_event_thread_need_exit) {
                     ESP_UTILS_LOGD("Event thread not running, exit");
                     break;
                 }
 
-                while (!_event_queue.empty() && !_event_thread_need_exit) {
-                    auto event_wrapper = _event_queue.front();
-                    _event_queue.pop();
-
+                while (!_event_thread_need_exit && popEvent(event_wrapper)) {
                     lock.unlock();
                     if (!processEvent(event_wrapper)) {
                         ESP_UTILS_LOGE("Failed to process event");
                     }
+                    // The promise is still here unless the event became the current one, so it is finished now
+                    if (event_wrapper.promise != nullptr) {
+                        event_wrapper.promise->set_value();
+                        event_wrapper.promise.reset();
+                    }
                     lock.lock();
                 }
                 if (_event_thread_need_exit) {
@@ -217,6 +260,10 @@ bool AnimPlayer::begin(const AnimPlayerData &data)
     del_guard.release();
     _is_begun = true;
     _canvas_config = data.canvas;
+    _swap_data_bytes = data.flags.enable_data_swap_bytes;
+    _pacing_enable_skip = data.pacing.enable_frame_skip;
+    _pacing_max_skip_frames = data.pacing.max_skip_frames;
+    _pacing_skipped_frames = 0;
 
     return true;
 }
@@ -230,22 +277,68 @@ bool AnimPlayer::del()
         _event_thread_need_exit = true;
         _event_cv.notify_all();
     }
+    {
+        std::lock_guard lock(_player_mutex);
+        _player_condition.notify_all();
+    }
+    {
+        std::lock_guard lock(_flush_mutex);
+        _flush_thread_need_exit = true;
+        _flush_cv.notify_all();
+    }
+    {
+        std::lock_guard lock(_replay_mutex);
+        _replay_thread_need_exit = true;
+        _replay_cv.notify_all();
+    }
     if (_event_thread.joinable()) {
         _event_thread.join();
     }
+    if (_flush_thread.joinable()) {
+        _flush_thread.join();
+    }
+    if (_replay_thread.joinable()) {
+        _replay_thread.join();
+    }
 
     if (_player_handle != nullptr) {
         anim_player_deinit(_player_handle);
         _player_handle = nullptr;
     }
 
+    // The verifier reads the mapped partition, so it must be stopped first
+    _asset_verifier.del();
     if (_assets_handle != nullptr) {
         mmap_assets_del(_assets_handle);
         _assets_handle = nullptr;
     }
 
+    {
+        std::lock_guard lock(_event_mutex);
+        clearEvents();
+    }
+    _current_event.reset();
     _animation_configs.clear();
-    _animation_data.clear();
+    _animation_files.clear();
+    _animation_file_loaded_index = INDEX_NONE;
+    _flush_slots.clear();
+    _flush_slot_write = 0;
+    _flush_slot_emit = 0;
+    _flush_slot_used = 0;
+    _flush_slot_ready = 0;
+    _flush_slot_is_flushing = false;
+    _swap_decoder_output = false;
+    _frame_cache.del();
+    _frame_indexes.clear();
+    _asset_checked.clear();
+    _delta_flush.del();
+    _delta_pending_rects = 0;
+    _tile_decoder.del();
+    _tile_rects.clear();
+    _profiler.del();
+    _replay_index = INDEX_NONE;
+    _replay_need_stop = false;
+    _replay_flush_pending = false;
     _is_begun = false;
 
     return true;
@@ -262,47 +355,308 @@ bool AnimPlayer::sendEvent(const Event &event, bool clear_queue, EventFuture *fu
 
     std::lock_guard lock(_event_mutex);
     if (clear_queue) {
-        while (!_event_queue.empty()) {
-            auto event_wrapper = _event_queue.front();
-            _event_queue.pop();
-
-            ESP_UTILS_LOGD("Pop event: %d", event_wrapper->event.index);
-            if (event_wrapper->promise != nullptr) {
-                event_wrapper->promise->set_value();
-            }
-        }
+        clearEvents();
     }
+    // Dropping a queued event would break the order of the requests, so the new one is rejected instead
+    ESP_UTILS_CHECK_FALSE_RETURN(!isEventQueueFull(), false, "Event queue full, reject event: %d", event.index);
 
-    std::shared_ptr<EventPromise> promise = nullptr;
+    std::unique_ptr<EventPromise> promise = nullptr;
     if (future != nullptr) {
         ESP_UTILS_CHECK_EXCEPTION_RETURN(
-            promise = std::make_shared<EventPromise>(), false, "Failed to create event promise"
+            promise = std::make_unique<EventPromise>(), false, "Failed to create event promise"
         );
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(*future = promise->get_future(), false, "Failed to get event future");
     }
+    pushEvent(EventWrapper{event, std::move(promise), std::chrono::steady_clock::now()});
+    _event_cv.notify_all();
 
-    std::shared_ptr<EventWrapper> event_wrapper = nullptr;
-    ESP_UTILS_CHECK_EXCEPTION_RETURN(
-        event_wrapper = std::make_shared<EventWrapper>(EventWrapper{event, promise}), false,
-        "Failed to create event wrapper"
-    );
+    return true;
+}
 
-    _event_queue.emplace(event_wrapper);
-    _event_cv.notify_all();
+bool AnimPlayer::play(int index, int from_frame, int to_frame, bool loop, EventFuture *future)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    if (future != nullptr) {
-        *future = promise->get_future();
-    }
+    ESP_UTILS_LOGD("Param: index(%d), from_frame(%d), to_frame(%d), loop(%d)", index, from_frame, to_frame, loop);
+
+    Event event = {
+        .index = index,
+        .operation = loop ? Operation::PlayLoop : Operation::PlayOnceStop,
+        .flags = {
+            .enable_interrupt = true,
+            .force = true,
+            .enable_segment = true,
+        },
+        .segment = {
+            .from_frame = from_frame,
+            .to_frame = to_frame,
+            .start_frame = from_frame,
+        },
+    };
+    ESP_UTILS_CHECK_FALSE_RETURN(sendEvent(event, true, future), false, "Failed to send event");
 
     return true;
 }
 
-bool AnimPlayer::notifyFlushFinished() const
+bool AnimPlayer::notifyFlushFinished()
 {
     // ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     ESP_UTILS_CHECK_NULL_RETURN(_player_handle, false, "Invalid handle");
 
-    anim_player_flush_ready(_player_handle);
+    // A strip split into several rectangles is finished when the last one is flushed
+    {
+        std::lock_guard lock(_delta_mutex);
+        if (_delta_pending_rects > 1) {
+            _delta_pending_rects--;
+            return true;
+        }
+        _delta_pending_rects = 0;
+    }
+    ANIM_PLAYER_PROFILE(this, onFlushEnd());
+
+    {
+        std::lock_guard lock(_replay_mutex);
+        if (_replay_flush_pending) {
+            _replay_flush_pending = false;
+            _replay_cv.notify_all();
+            return true;
+        }
+    }
+
+    if (!isFlushPipelineEnabled()) {
+        ANIM_PLAYER_PROFILE(this, onDecodeStripReleased());
+        anim_player_flush_ready(_player_handle);
+        return true;
+    }
+
+    // Release the buffer which is being flushed, it is always the oldest one in use
+    std::lock_guard lock(_flush_mutex);
+    if (_flush_slot_is_flushing) {
+        _flush_slot_is_flushing = false;
+        _flush_slot_used--;
+        _flush_cv.notify_all();
+    }
+
+    return true;
+}
+
+bool AnimPlayer::setOutputHandler(const OutputHandler &handler)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!_is_begun, false, "Should be called before begin");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (handler.flush != nullptr) && (handler.clear != nullptr), false, "Invalid handler"
+    );
+
+    _output_handler = handler;
+
+    return true;
+}
+
+AnimFrameCache::Stats AnimPlayer::getFrameCacheStats()
+{
+    return _frame_cache.getStats();
+}
+
+AnimDeltaFlush::Stats AnimPlayer::getDeltaFlushStats() const
+{
+    return _delta_flush.getStats();
+}
+
+AnimProfiler::Summary AnimPlayer::getProfileSummary()
+{
+    return _profiler.getSummary();
+}
+
+std::vector<AnimProfiler::Sample> AnimPlayer::getProfileSamples()
+{
+    return _profiler.getSamples();
+}
+
+void AnimPlayer::resetProfile()
+{
+    _profiler.reset();
+}
+
+void AnimPlayer::emitFlush(int x_start, int y_start, int x_end, int y_end, const void *data, bool is_frame_end)
+{
+    if (_is_first_flush_pending.exchange(false)) {
+        ESP_UTILS_LOGD(
+            "Event to first flush latency: %d us", static_cast<int>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - _first_flush_send_time
+                ).count()
+            )
+        );
+    }
+    ANIM_PLAYER_PROFILE(this, onFlushBegin(y_start == _canvas_config.coord_y));
+
+    // The handler keeps the whole frame, so the delta of the strip is not needed
+    if (_output_handler.flush != nullptr) {
+        _output_handler.flush(x_start, y_start, x_end, y_end, data);
+        if (is_frame_end && (_output_handler.frame_end != nullptr)) {
+            _output_handler.frame_end();
+        }
+        notifyFlushFinished();
+        return;
+    }
+
+    if (!_delta_flush.isBegun()) {
+        flush_ready_signal(x_start, y_start, x_end, y_end, data, this);
+        return;
+    }
+
+    if (!_delta_flush.process(x_start, y_start, x_end, y_end, data, _delta_rects)) {
+        ESP_UTILS_LOGE("Process delta flush failed, flush the whole strip");
+        flush_ready_signal(x_start, y_start, x_end, y_end, data, this);
+        return;
+    }
+
+    if (_delta_rects.empty()) {
+        // Nothing changed, finish the strip directly
+        notifyFlushFinished();
+        return;
+    }
+
+    {
+        std::lock_guard lock(_delta_mutex);
+        _delta_pending_rects = _delta_rects.size();
+    }
+    for (auto &rect : _delta_rects) {
+        flush_ready_signal(rect.x_start, rect.y_start, rect.x_end, rect.y_end, rect.data, this);
+    }
+}
+
+bool AnimPlayer::beginFlushPipeline(const AnimPlayerData &data)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (data.task.pipeline_depth <= 1) {
+        ESP_UTILS_LOGD("Flush pipeline disabled");
+        return true;
+    }
+
+    ESP_UTILS_LOGD("Enable flush pipeline: depth(%d)", data.task.pipeline_depth);
+
+    // Buffers are allocated on the first flush, since the strip size is decided by the decoder
+    _flush_slots.clear();
+    _flush_slots.reserve(data.task.pipeline_depth);
+    for (int i = 0; i < data.task.pipeline_depth; i++) {
+        _flush_slots.emplace_back(FlushSlot{
+            .buffer = std::unique_ptr<uint8_t, void(*)(void *)>(nullptr, heap_caps_free),
+        });
+    }
+    _flush_buffer_in_ext = data.task.pipeline_buffer_in_ext;
+    _flush_slot_write = 0;
+    _flush_slot_emit = 0;
+    _flush_slot_used = 0;
+    _flush_slot_ready = 0;
+    _flush_slot_is_flushing = false;
+    _flush_thread_need_exit = false;
+
+    esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+        .name = ANIM_FLUSH_THREAD_NAME,
+        .stack_size = ANIM_FLUSH_THREAD_STACK_SIZE,
+        .stack_in_ext = ANIM_FLUSH_THREAD_STACK_CAPS_EXT,
+    });
+    _flush_thread = boost::thread([this] {
+        ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+        while (!_flush_thread_need_exit)
+        {
+            std::unique_lock<std::mutex> lock(_flush_mutex);
+            // Only one buffer is handed to the signal at a time, so `notifyFlushFinished()` releases them in order
+            _flush_cv.wait(lock, [this]() {
+                return _flush_thread_need_exit || ((_flush_slot_ready > 0) && !_flush_slot_is_flushing);
+            });
+            if (_flush_thread_need_exit) {
+                ESP_UTILS_LOGD("Flush thread not running, exit");
+                break;
+            }
+
+            auto &slot = _flush_slots[_flush_slot_emit];
+            _flush_slot_emit = (_flush_slot_emit + 1) % _flush_slots.size();
+            _flush_slot_ready--;
+            _flush_slot_is_flushing = true;
+            lock.unlock();
+
+            emitFlush(slot.x_start, slot.y_start, slot.x_end, slot.y_end, slot.buffer.get(), slot.is_frame_end);
+        }
+    });
+
+    return true;
+}
+
+bool AnimPlayer::pushFlushPipeline(
+    int x_start, int y_start, int x_end, int y_end, const void *data, bool is_frame_end, bool swap_bytes
+)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(data, false, "Invalid data");
+
+    std::unique_lock<std::mutex> lock(_flush_mutex);
+    _flush_cv.wait(lock, [this]() {
+        return _flush_thread_need_exit || (_flush_slot_used < _flush_slots.size());
+    });
+    if (_flush_thread_need_exit) {
+        return true;
+    }
+
+    auto &slot = _flush_slots[_flush_slot_write];
+    // The slot is owned by this thread until it is marked as ready
+    lock.unlock();
+
+    size_t size = static_cast<size_t>(x_end - x_start) * (y_end - y_start) * ANIM_PIXEL_BYTES;
+    if (slot.capacity < size) {
+        uint32_t caps = (_flush_buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+        slot.buffer.reset(static_cast<uint8_t *>(heap_caps_malloc(size, caps)));
+        slot.capacity = (slot.buffer != nullptr) ? size : 0;
+        ESP_UTILS_CHECK_NULL_RETURN(slot.buffer, false, "Failed to allocate flush buffer(%d)", static_cast<int>(size));
+    }
+    if (swap_bytes) {
+        pixel::swap16(slot.buffer.get(), data, size / ANIM_PIXEL_BYTES);
+    } else {
+        memcpy(slot.buffer.get(), data, size);
+    }
+    slot.x_start = x_start;
+    slot.y_start = y_start;
+    slot.x_end = x_end;
+    slot.y_end = y_end;
+    slot.size = size;
+    slot.is_frame_end = is_frame_end;
+
+    lock.lock();
+    _flush_slot_write = (_flush_slot_write + 1) % _flush_slots.size();
+    _flush_slot_used++;
+    _flush_slot_ready++;
+    _flush_cv.notify_all();
+
+    return true;
+}
+
+bool AnimPlayer::drainFlushPipeline(bool discard)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (!isFlushPipelineEnabled()) {
+        return true;
+    }
+
+    ESP_UTILS_LOGD("Param: discard(%d)", discard);
+
+    std::unique_lock<std::mutex> lock(_flush_mutex);
+    if (discard && (_flush_slot_ready > 0)) {
+        // Drop the buffers which have not been handed to the signal yet, they are the newest ones
+        ESP_UTILS_LOGD("Discard %d pending buffers", static_cast<int>(_flush_slot_ready));
+        _flush_slot_write = (_flush_slot_write + _flush_slots.size() - _flush_slot_ready) % _flush_slots.size();
+        _flush_slot_used -= _flush_slot_ready;
+        _flush_slot_ready = 0;
+        _flush_cv.notify_all();
+    }
+    _flush_cv.wait(lock, [this]() {
+        return _flush_thread_need_exit || ((_flush_slot_ready == 0) && !_flush_slot_is_flushing);
+    });
 
     return true;
 }
@@ -311,13 +665,14 @@ bool AnimPlayer::loadAnimationConfig(const AnimPlayerPartitionConfig &partition_
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
+    bool is_full_check = (partition_config.check_mode == AnimPlayerPartitionCheck::Full);
     mmap_assets_config_t asset_config = {
         .partition_label = partition_config.partition_label,
         .max_files = partition_config.max_files,
         .checksum = partition_config.checksum,
         .flags = {
             .mmap_enable = true,
-            .full_check = true,
+            .full_check = is_full_check,
         },
     };
     ESP_UTILS_CHECK_ERROR_RETURN(mmap_assets_new(&asset_config, &_assets_handle), false, "Failed to create mmap assets");
@@ -333,6 +688,17 @@ bool AnimPlayer::loadAnimationConfig(const AnimPlayerPartitionConfig &partition_
         _animation_configs[i].fps = partition_config.fps[i];
     }
 
+    if (!is_full_check) {
+        std::vector<AnimAssetVerifier::Asset> assets;
+        for (auto &config : _animation_configs) {
+            assets.push_back({config.data_address, config.data_length});
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(_asset_verifier.begin(assets, {
+            .enable_background = (partition_config.check_mode == AnimPlayerPartitionCheck::Background),
+            .chunk_size = 0,
+        }), false, "Failed to begin asset verifier");
+    }
+
     return true;
 }
 
@@ -354,38 +720,100 @@ bool AnimPlayer::loadAnimationConfig(const AnimPlayerAnimAddress *anim_address,
     return true;
 }
 
-bool AnimPlayer::loadAnimationConfig(const AnimPlayerAnimPath *anim_path, int num)
+bool AnimPlayer::loadAnimationConfig(
+    const AnimPlayerAnimPath *anim_path, int num, const AnimFileSource::Config &config
+)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    _animation_data.clear();
+    // Only the file size is read here, the data is loaded when the animation is played
+    _animation_files.clear();
+    _animation_file_loaded_index = INDEX_NONE;
     for (int i = 0; i < num; i++) {
-        ESP_UTILS_CHECK_FALSE_RETURN(fs::exists(anim_path[i].path), false, "File not exists: %s", anim_path[i].path);
+        ESP_UTILS_CHECK_NULL_RETURN(anim_path[i].path, false, "Invalid path");
 
-        std::ifstream file(anim_path[i].path, std::ios::binary);
-        ESP_UTILS_CHECK_FALSE_RETURN(file.is_open(), false, "Failed to open file: %s", anim_path[i].path);
+        auto file = std::make_unique<AnimFileSource>();
+        ESP_UTILS_CHECK_NULL_RETURN(file, false, "Failed to create file source");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            file->open(anim_path[i].path, config), false, "Failed to open file: %s", anim_path[i].path
+        );
 
-        ESP_UTILS_LOGD("Load animation %d: %s, fps(%d)", i, anim_path[i].path, anim_path[i].fps);
-        _animation_data.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        ESP_UTILS_LOGD(
+            "Load animation %d: %s, length(%d), fps(%d)", i, anim_path[i].path, static_cast<int>(file->getLength()),
+            anim_path[i].fps
+        );
         _animation_configs.emplace_back(AnimPlayerAnimAddress{
-            .data_address = _animation_data.back().data(),
-            .data_length = _animation_data.back().size(),
+            .data_address = nullptr,
+            .data_length = file->getLength(),
             .fps = anim_path[i].fps,
         });
+        _animation_files.emplace_back(std::move(file));
     }
 
     return true;
 }
 
+bool AnimPlayer::loadAnimationData(int index, bool &is_interrupted)
+{
+    is_interrupted = false;
+    if (_animation_files.empty() || (index == _animation_file_loaded_index)) {
+        return true;
+    }
+
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: index(%d)", index);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (index >= 0) && (index < static_cast<int>(_animation_files.size())), false, "Invalid index: %d", index
+    );
+
+    // The decoder is idle here, so the previous animation can be released before the next one is loaded
+    if (_animation_file_loaded_index != INDEX_NONE) {
+        _animation_files[_animation_file_loaded_index]->unload();
+        _animation_configs[_animation_file_loaded_index].data_address = nullptr;
+        _animation_file_loaded_index = INDEX_NONE;
+    }
+
+    // Read the file in the load thread, so that a newer interrupting event is not blocked by slow storage
+    auto &file = _animation_files[index];
+    bool is_load_done = false;
+    ESP_UTILS_CHECK_FALSE_RETURN(file->startLoad([this, &is_load_done](bool) {
+        std::lock_guard lock(_event_mutex);
+        is_load_done = true;
+        _event_cv.notify_all();
+    }), false, "Failed to start loading file: %s", file->getPath().c_str());
+    {
+        std::unique_lock lock(_event_mutex);
+        _event_cv.wait(lock, [this, &is_load_done]() {
+            return is_load_done || _event_thread_need_exit || hasInterruptEvent();
+        });
+        is_interrupted = !is_load_done;
+    }
+    if (is_interrupted) {
+        ESP_UTILS_LOGD("Loading interrupted: %s", file->getPath().c_str());
+        file->cancelLoad();
+        return true;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(file->waitLoad(), false, "Failed to load file: %s", file->getPath().c_str());
+
+    _animation_configs[index].data_address = file->getData();
+    _animation_configs[index].data_length = file->getLength();
+    _animation_file_loaded_index = index;
+    // The data is read again from the file, so it is checked again
+    _asset_checked[index] = false;
+
+    return true;
+}
+
 bool AnimPlayer::waitPlayerFrameDone()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     std::unique_lock<std::mutex> lock(_player_mutex);
     _player_flags.is_frame_done = false;
-    while (!_event_thread_need_exit && !_player_flags.is_frame_done && (_player_state != OperationState::Stop)) {
-        _player_condition.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
-    }
+    _player_condition.wait(lock, [this]() {
+        return _event_thread_need_exit || _player_flags.is_frame_done || (_player_state == OperationState::Stop);
+    });
 
     return true;
 }
@@ -395,9 +823,10 @@ bool AnimPlayer::waitPlayerIdle()
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     std::unique_lock<std::mutex> lock(_player_mutex);
-    while (!_event_thread_need_exit && (_player_state != OperationState::Stop) && (_player_state != OperationState::Pause)) {
-        _player_condition.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
-    }
+    _player_condition.wait(lock, [this]() {
+        return _event_thread_need_exit || (_player_state == OperationState::Stop) ||
+               (_player_state == OperationState::Pause);
+    });
 
     return true;
 }
@@ -408,46 +837,555 @@ bool AnimPlayer::waitPlayerState(OperationState state)
 
     ESP_UTILS_LOGD("Param: state(%d)", static_cast<int>(state));
 
-    if (_player_state & state) {
-        ESP_UTILS_LOGD("Already meet target state");
-        return true;
+    std::unique_lock<std::mutex> lock(_player_mutex);
+    _player_condition.wait(lock, [this, state]() {
+        return _event_thread_need_exit || (_player_state & state);
+    });
+
+    return true;
+}
+
+void AnimPlayer::setPlayerState(OperationState state)
+{
+    std::lock_guard lock(_player_mutex);
+    _player_state = state;
+    _player_condition.notify_all();
+}
+
+bool AnimPlayer::pushEvent(EventWrapper &&event_wrapper)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(!isEventQueueFull(), false, "Event queue full");
+
+    _event_queue[(_event_queue_head + _event_queue_size) % _event_queue.size()] = std::move(event_wrapper);
+    _event_queue_size++;
+
+    return true;
+}
+
+bool AnimPlayer::popEvent(EventWrapper &event_wrapper)
+{
+    if (isEventQueueEmpty()) {
+        return false;
     }
 
+    event_wrapper = std::move(_event_queue[_event_queue_head]);
+    _event_queue_head = (_event_queue_head + 1) % _event_queue.size();
+    _event_queue_size--;
+
+    return true;
+}
+
+bool AnimPlayer::hasInterruptEvent() const
+{
+    for (size_t i = 0; i < _event_queue_size; i++) {
+        if (_event_queue[(_event_queue_head + i) % _event_queue.size()].event.flags.enable_interrupt) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AnimPlayer::clearEvents()
+{
+    EventWrapper event_wrapper = {};
+    while (popEvent(event_wrapper)) {
+        ESP_UTILS_LOGD("Pop event: %d", event_wrapper.event.index);
+        if (event_wrapper.promise != nullptr) {
+            event_wrapper.promise->set_value();
+        }
+    }
+    _event_queue_head = 0;
+}
+
+void AnimPlayer::onPlayerFrameDone()
+{
     std::unique_lock<std::mutex> lock(_player_mutex);
-    while (!_event_thread_need_exit && !(_player_state & state)) {
-        _player_condition.wait_for(lock, std::chrono::milliseconds(THREAD_EXIT_CHECK_INTERVAL_MS));
-        ESP_UTILS_LOGD("Not meet target state, current state: %d", static_cast<int>(_player_state));
+
+    _player_flags.is_frame_done = true;
+
+    if (!isReplaying()) {
+        if (_frame_cache.isFrameRecording() && !_frame_cache.endFrame()) {
+            ESP_UTILS_LOGE("Failed to end cached frame");
+        }
+        _decode_frame_index = _decode_segment.from - 1;
+
+        auto &event_wrapper = _current_event;
+        bool is_loop = event_wrapper.has_value() && (event_wrapper->event.operation == Operation::PlayLoop);
+        if (is_loop && (_decode_segment.start != _decode_segment.from)) {
+            // A loop started from the middle of its segment is decoded once up to the end, then restarted as a whole
+            std::lock_guard event_lock(_event_mutex);
+            if (isEventQueueEmpty()) {
+                auto loop_event = event_wrapper->event;
+                loop_event.flags.enable_interrupt = true;
+                loop_event.flags.force = true;
+                loop_event.flags.enable_segment = true;
+                loop_event.segment = {_decode_segment.from, _decode_segment.to, _decode_segment.from};
+                pushEvent(EventWrapper{
+                    loop_event, std::move(event_wrapper->promise), std::chrono::steady_clock::now()
+                });
+                _event_cv.notify_all();
+            }
+        } else if (is_loop && isAnimationCached(event_wrapper->event.index, _decode_segment)) {
+            // Switch to the cache once a whole loop has been decoded, unless another event is pending
+            std::lock_guard event_lock(_event_mutex);
+            if (isEventQueueEmpty()) {
+                ESP_UTILS_LOGD("Animation[%d] fully cached, switch to replay", event_wrapper->event.index);
+                auto switch_event = event_wrapper->event;
+                switch_event.flags.enable_interrupt = true;
+                switch_event.flags.force = true;
+                pushEvent(EventWrapper{
+                    switch_event, std::move(event_wrapper->promise), std::chrono::steady_clock::now()
+                });
+                _event_cv.notify_all();
+            }
+        }
+    }
+
+    _player_condition.notify_all();
+}
+
+void AnimPlayer::onPlayerIdle()
+{
+    std::unique_lock<std::mutex> lock(_player_mutex);
+
+    // The last strips of a finished animation are flushed before it is reported, unlike those of an interrupted one
+    if (!isReplaying() && !_player_flags.is_stopping) {
+        lock.unlock();
+        if (!drainFlushPipeline(false)) {
+            ESP_UTILS_LOGE("Failed to drain flush pipeline");
+        }
+        lock.lock();
+    }
+
+    _player_state = OperationState::Stop;
+    if (!isReplaying()) {
+        // The last frame may be incomplete when the animation is interrupted
+        _frame_cache.abortFrame();
+        _decode_frame_index = -1;
+    }
+
+    _player_condition.notify_all();
+
+    auto &event_wrapper = _current_event;
+    ESP_UTILS_CHECK_FALSE_EXIT(event_wrapper.has_value(), "Invalid current event");
+
+    if (event_wrapper->event.operation == Operation::PlayOnceStop) {
+        ESP_UTILS_LOGD("Animation play once stop: %d", event_wrapper->event.index);
+
+        bool is_queue_empty = false;
+        {
+            std::lock_guard event_lock(_event_mutex);
+            is_queue_empty = isEventQueueEmpty();
+        }
+        if (is_queue_empty && !_player_flags.is_starting) {
+            sendEvent({-1, Operation::Stop, {true, true}}, false);
+        } else {
+            if (event_wrapper->promise != nullptr) {
+                event_wrapper->promise->set_value();
+            }
+            event_wrapper.reset();
+        }
+    } else {
+        if (event_wrapper->event.operation == Operation::PlayOncePause) {
+            ESP_UTILS_LOGD("Animation play once pause: %d", event_wrapper->event.index);
+
+            _player_state = OperationState::Pause;
+        } else {
+            ESP_UTILS_LOGD("Animation stop: %d", event_wrapper->event.index);
+        }
+
+        if (event_wrapper->promise != nullptr) {
+            event_wrapper->promise->set_value();
+        }
+        event_wrapper.reset();
     }
 
+    _player_condition.notify_all();
+}
+
+bool AnimPlayer::beginFrameCache(const AnimPlayerData &data)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (data.cache.budget_bytes == 0) {
+        ESP_UTILS_LOGD("Frame cache disabled");
+        return true;
+    }
+
+    ESP_UTILS_LOGD(
+        "Enable frame cache: budget(%d), in_ext(%d)", static_cast<int>(data.cache.budget_bytes),
+        data.cache.buffer_in_ext
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(_frame_cache.begin({
+        .budget_bytes = data.cache.budget_bytes,
+        .buffer_in_ext = data.cache.buffer_in_ext,
+    }), false, "Failed to begin frame cache");
+
     return true;
 }
 
-bool AnimPlayer::processEvent(std::shared_ptr<EventWrapper> event_wrapper)
+bool AnimPlayer::beginReplayThread()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    ESP_UTILS_CHECK_NULL_RETURN(event_wrapper, false, "Invalid event wrapper");
+    _replay_thread_need_exit = false;
+    _replay_index = INDEX_NONE;
+    _replay_need_stop = false;
+    _replay_flush_pending = false;
+
+    esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
+        .name = ANIM_REPLAY_THREAD_NAME,
+        .stack_size = ANIM_REPLAY_THREAD_STACK_SIZE,
+        .stack_in_ext = ANIM_REPLAY_THREAD_STACK_CAPS_EXT,
+    });
+    _replay_thread = boost::thread([this] {
+        ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+        while (!_replay_thread_need_exit)
+        {
+            std::unique_lock<std::mutex> lock(_replay_mutex);
+            _replay_cv.wait(lock, [this]() {
+                return _replay_thread_need_exit || (_replay_index != INDEX_NONE);
+            });
+            if (_replay_thread_need_exit) {
+                ESP_UTILS_LOGD("Replay thread not running, exit");
+                break;
+            }
+            int index = _replay_index;
+            auto config = _replay_config;
+            lock.unlock();
+
+            if (!processReplay(index, config)) {
+                ESP_UTILS_LOGE("Failed to replay animation: %d", index);
+            }
+
+            lock.lock();
+            _replay_index = INDEX_NONE;
+            _replay_need_stop = false;
+            _replay_flush_pending = false;
+            lock.unlock();
+
+            onPlayerIdle();
+        }
+    });
+
+    return true;
+}
+
+void AnimPlayer::recordFrameCache(int y1, int x_start, int y_start, int x_end, int y_end, const void *data)
+{
+    if (!_frame_cache.isBegun() || (_decode_index == INDEX_NONE)) {
+        return;
+    }
+
+    if (y1 == 0) {
+        if (_frame_cache.isFrameRecording() && !_frame_cache.endFrame()) {
+            ESP_UTILS_LOGE("Failed to end cached frame");
+        }
+
+        auto &frame_index = _frame_indexes[_decode_index];
+        auto canonical_index = frame_index.getCanonicalIndex(_decode_frame_index);
+        // Every decoded frame is looked up, so a frame which had to be decoded counts as a miss
+        if ((_frame_cache.find(_decode_index, canonical_index) != nullptr) ||
+                (canonical_index != _decode_frame_index)) {
+            return;
+        }
+        if (!_frame_cache.beginFrame(_decode_index, canonical_index)) {
+            ESP_UTILS_LOGE("Failed to begin cached frame");
+            return;
+        }
+    }
+
+    if (_frame_cache.isFrameRecording()) {
+        size_t size = static_cast<size_t>(x_end - x_start) * (y_end - y_start) * ANIM_PIXEL_BYTES;
+        if (!_frame_cache.appendStrip(x_start, y_start, x_end, y_end, data, size, _swap_decoder_output)) {
+            ESP_UTILS_LOGE("Failed to append cached strip");
+            _frame_cache.abortFrame();
+        }
+    }
+}
+
+AnimFrameIndex *AnimPlayer::getFrameIndex(int index)
+{
+    if ((index < 0) || (index >= static_cast<int>(_frame_indexes.size()))) {
+        return nullptr;
+    }
+
+    auto &frame_index = _frame_indexes[index];
+    if (!frame_index.isValid()) {
+        auto &config = _animation_configs[index];
+        // Not loaded yet, or decoded by the player, which has its own table
+        if ((config.data_address == nullptr) ||
+                AnimTileDecoder::isTileFormat(config.data_address, config.data_length)) {
+            return nullptr;
+        }
+        if (!frame_index.build(config.data_address, config.data_length)) {
+            ESP_UTILS_LOGW("Failed to build frame index: %d", index);
+            return nullptr;
+        }
+    }
+
+    return &frame_index;
+}
+
+bool AnimPlayer::resolveSegment(const Event &event, int last_frame, Segment &segment)
+{
+    segment = {0, last_frame, 0};
+    if (!event.flags.enable_segment) {
+        return true;
+    }
+
+    auto &config = event.segment;
+    int to = ((config.to_frame == FRAME_LAST) || (config.to_frame > last_frame)) ? last_frame : config.to_frame;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (config.from_frame >= 0) && (config.from_frame <= to), false, "Invalid segment: [%d, %d], last frame(%d)",
+        config.from_frame, config.to_frame, last_frame
+    );
+
+    // Start from the beginning if the start frame is out of the segment, e.g. a finished animation is resumed
+    int start = ((config.start_frame < config.from_frame) || (config.start_frame > to)) ?
+                config.from_frame : config.start_frame;
+    segment = {config.from_frame, to, start};
+
+    return true;
+}
+
+bool AnimPlayer::isAnimationCached(int index, const Segment &segment)
+{
+    if (!_frame_cache.isBegun()) {
+        return false;
+    }
+
+    auto frame_index = getFrameIndex(index);
+    if ((frame_index == nullptr) || (segment.to >= frame_index->getFrameNum())) {
+        return false;
+    }
+
+    for (int i = segment.from; i <= segment.to; i++) {
+        auto canonical_index = frame_index->getCanonicalIndex(i);
+        if (!_frame_cache.contains(index, canonical_index)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void AnimPlayer::resetPacing(int fps)
+{
+    _pacing_frame_period = std::chrono::microseconds(1000000 / std::max(fps, 1));
+    _pacing_frame_index = -1;
+    _pacing_skip_frames = 0;
+    _pacing_is_skipping = false;
+}
+
+bool AnimPlayer::beginPacedFrame()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    // The schedule starts from the first frame of the animation
+    if (_pacing_frame_index < 0) {
+        _pacing_start_time = now;
+        _pacing_frame_index = 0;
+        return false;
+    }
+    _pacing_frame_index++;
+    if (!_pacing_enable_skip) {
+        return false;
+    }
+
+    // A frame is late when the next one is already due
+    auto due_time = _pacing_start_time + _pacing_frame_period * _pacing_frame_index;
+    if (now - due_time < _pacing_frame_period) {
+        _pacing_skip_frames = 0;
+        return false;
+    }
+    if (_pacing_skip_frames < _pacing_max_skip_frames) {
+        _pacing_skip_frames++;
+        _pacing_skipped_frames++;
+        ESP_UTILS_LOGD("Skip late frame(%d), late(%d us)", _pacing_frame_index, static_cast<int>(
+                           std::chrono::duration_cast<std::chrono::microseconds>(now - due_time).count()
+                       ));
+        return true;
+    }
+
+    // Too many frames skipped in a row, show this one and continue the schedule from it
+    _pacing_start_time = now - _pacing_frame_period * _pacing_frame_index;
+    _pacing_skip_frames = 0;
+
+    return false;
+}
+
+std::chrono::steady_clock::time_point AnimPlayer::getPacedFrameDeadline() const
+{
+    return _pacing_start_time + _pacing_frame_period * (_pacing_frame_index + 1);
+}
+
+bool AnimPlayer::startReplay(int index, const ReplayConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    auto &event = event_wrapper->event;
+    ESP_UTILS_LOGD(
+        "Param: index(%d), fps(%d), segment([%d, %d], start(%d)), is_repeat(%d), is_tile_source(%d)", index,
+        config.fps, config.segment.from, config.segment.to, config.segment.start, config.is_repeat,
+        config.is_tile_source
+    );
+
+    // The thread is only created once an animation is replayed or decoded by the player itself
+    if (!_replay_thread.joinable()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(beginReplayThread(), false, "Failed to begin replay thread");
+    }
+
+    std::lock_guard lock(_replay_mutex);
+    _replay_index = index;
+    _replay_config = config;
+    _replay_need_stop = false;
+    _replay_cv.notify_all();
+
+    return true;
+}
+
+bool AnimPlayer::stopReplay()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard lock(_replay_mutex);
+    _replay_need_stop = true;
+    _replay_cv.notify_all();
+
+    return true;
+}
+
+bool AnimPlayer::processReplay(int index, const ReplayConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    auto &frame_index = _frame_indexes[index];
+    auto &segment = config.segment;
+    auto frame_period = std::chrono::microseconds(1000000 / std::max(config.fps, 1));
+    auto need_stop = [this]() {
+        return _replay_thread_need_exit || _replay_need_stop;
+    };
+    // Tile rects point into the canvas of the decoder, so with the pipeline they are copied out and the next frame
+    // is decoded while they are being flushed
+    bool is_pipelined = config.is_tile_source && isFlushPipelineEnabled();
+    auto emit_strip = [&](int x_start, int y_start, int x_end, int y_end, const void *data, bool is_frame_end) {
+        std::unique_lock<std::mutex> lock(_replay_mutex);
+        if (need_stop()) {
+            return false;
+        }
+        if (is_pipelined) {
+            lock.unlock();
+            if (!pushFlushPipeline(x_start, y_start, x_end, y_end, data, is_frame_end, false)) {
+                ESP_UTILS_LOGE("Push flush pipeline failed, drop strip");
+            }
+            return true;
+        }
+        _replay_flush_pending = true;
+        lock.unlock();
+
+        emitFlush(x_start, y_start, x_end, y_end, data, is_frame_end);
+
+        lock.lock();
+        _replay_cv.wait(lock, [this, &need_stop]() {
+            return !_replay_flush_pending || need_stop();
+        });
+        return true;
+    };
+
+    int start = segment.start;
+    while (true) {
+        for (int i = start; i <= segment.to; i++) {
+            auto frame_start = std::chrono::steady_clock::now();
+            _position_frame = i;
+            bool is_skipped = beginPacedFrame();
+
+            if (config.is_tile_source) {
+                // A skipped frame is not decoded, the next shown frame catches up with its changes
+                if (is_skipped) {
+                    continue;
+                }
+                ESP_UTILS_CHECK_FALSE_RETURN(_tile_decoder.decodeFrame(i), false, "Failed to decode frame(%d)", i);
+                _tile_decoder.takeDirtyRects(_tile_rects);
+                // Only the changed bands are flushed, so the end of the frame is the last of them
+                for (size_t j = 0; j < _tile_rects.size(); j++) {
+                    auto &rect = _tile_rects[j];
+                    if (!emit_strip(
+                                rect.x_start + _canvas_config.coord_x, rect.y_start + _canvas_config.coord_y,
+                                rect.x_end + _canvas_config.coord_x, rect.y_end + _canvas_config.coord_y, rect.data,
+                                j + 1 == _tile_rects.size()
+                            )) {
+                        return true;
+                    }
+                }
+            } else {
+                if (is_skipped) {
+                    continue;
+                }
+                auto frame = _frame_cache.find(index, frame_index.getCanonicalIndex(i));
+                ESP_UTILS_CHECK_NULL_RETURN(frame, false, "Frame(%d) not cached", i);
+
+                for (size_t j = 0; j < frame->strips.size(); j++) {
+                    auto &strip = frame->strips[j];
+                    if (!emit_strip(
+                                strip.x_start, strip.y_start, strip.x_end, strip.y_end, frame->getStripData(strip),
+                                j + 1 == frame->strips.size()
+                            )) {
+                        return true;
+                    }
+                }
+            }
+
+            auto deadline = _pacing_enable_skip ? getPacedFrameDeadline() : (frame_start + frame_period);
+            std::unique_lock<std::mutex> lock(_replay_mutex);
+            if (_replay_cv.wait_until(lock, deadline, need_stop)) {
+                return true;
+            }
+        }
+        start = segment.from;
+
+        onPlayerFrameDone();
+        if (!config.is_repeat) {
+            break;
+        }
+    }
+    // The last frame of a finished animation is still flushed, unlike the frames of an interrupted one
+    if (is_pipelined) {
+        ESP_UTILS_CHECK_FALSE_RETURN(drainFlushPipeline(false), false, "Failed to drain flush pipeline");
+    }
+
+    return true;
+}
+
+bool AnimPlayer::processEvent(EventWrapper &event_wrapper)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    auto event = event_wrapper.event;
     ESP_UTILS_LOGD(
         "Param: event(%d,%d,%d,%d)", event.index, static_cast<int>(event.operation), event.flags.enable_interrupt,
         event.flags.force
     );
 
-    if (!event.flags.force && (_current_event != nullptr) && (_current_event->event.index == event.index) &&
+    if (!event.flags.force && _current_event.has_value() && (_current_event->event.index == event.index) &&
             (_current_event->event.operation == event.operation)) {
         ESP_UTILS_LOGD("Animation already in index & operation");
         return true;
     }
 
     {
-        _player_flags.is_starting = true;
+        {
+            std::lock_guard lock(_player_mutex);
+            _player_flags.is_starting = true;
+        }
         esp_utils::function_guard end_guard([this]() {
             ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+            std::lock_guard lock(_player_mutex);
             _player_flags.is_starting = false;
         });
 
-        if (_current_event != nullptr) {
+        if (_current_event.has_value()) {
             if (!event.flags.enable_interrupt) {
                 ESP_UTILS_LOGD("Do not enable interrupt, wait player frame done");
                 ESP_UTILS_CHECK_FALSE_RETURN(waitPlayerFrameDone(), false, "Failed to wait player frame done");
@@ -458,14 +1396,32 @@ bool AnimPlayer::processEvent(std::shared_ptr<EventWrapper> event_wrapper)
             }
 
             ESP_UTILS_LOGD("Update current event[%d] to stop", _current_event->event.index);
-            anim_player_update(_player_handle, PLAYER_ACTION_STOP);
+            if (isReplaying()) {
+                ESP_UTILS_CHECK_FALSE_RETURN(stopReplay(), false, "Failed to stop replay");
+            } else {
+                {
+                    std::lock_guard lock(_player_mutex);
+                    _player_flags.is_stopping = true;
+                }
+                anim_player_update(_player_handle, PLAYER_ACTION_STOP);
+            }
 
             ESP_UTILS_LOGD("Wait player idle");
-            ESP_UTILS_CHECK_FALSE_RETURN(waitPlayerIdle(), false, "Failed to wait player idle");
+            bool is_idle = waitPlayerIdle();
+            {
+                std::lock_guard lock(_player_mutex);
+                _player_flags.is_stopping = false;
+            }
+            ESP_UTILS_CHECK_FALSE_RETURN(is_idle, false, "Failed to wait player idle");
             if (_event_thread_need_exit) {
                 ESP_UTILS_LOGD("Event thread need exit, return true");
                 return true;
             }
+
+            // Buffers decoded ahead are stale when the animation is interrupted
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                drainFlushPipeline(event.flags.enable_interrupt), false, "Failed to drain flush pipeline"
+            );
         }
 
         // Then update animation
@@ -474,16 +1430,105 @@ bool AnimPlayer::processEvent(std::shared_ptr<EventWrapper> event_wrapper)
         case Operation::PlayLoop:
         case Operation::PlayOnceStop:
         case Operation::PlayOncePause: {
-            _current_event = event_wrapper;
+            _current_event = std::move(event_wrapper);
+            // An event which fails to start is finished at once, instead of waiting for the next event
+            esp_utils::function_guard finish_function([this]() {
+                if (_current_event->promise != nullptr) {
+                    _current_event->promise->set_value();
+                }
+                _current_event.reset();
+            });
 
             ESP_UTILS_CHECK_FALSE_RETURN(
                 (index >= 0) && (index < static_cast<int>(_animation_configs.size())), false, "Invalid index: %d", index
             );
+            if (_asset_verifier.isBegun()) {
+                ESP_UTILS_CHECK_FALSE_RETURN(_asset_verifier.verify(index), false, "Animation(%d) is corrupted", index);
+            }
 
             auto &config = _animation_configs[index];
             uint32_t start = 0;
             uint32_t end = 0;
             bool is_repeat = (event.operation == Operation::PlayLoop);
+            Segment segment = {};
+
+            _decode_index = index;
+            _position_index = index;
+            _position_frame = -1;
+            resetPacing(config.fps);
+            ANIM_PLAYER_PROFILE(this, setTargetFps(config.fps));
+            auto frame_index = getFrameIndex(index);
+            bool is_cached = is_repeat && (frame_index != nullptr) &&
+                             resolveSegment(event, frame_index->getFrameNum() - 1, segment) &&
+                             isAnimationCached(index, segment);
+            if (is_cached) {
+                ESP_UTILS_LOGI(
+                    "Replay animation from cache: %d, segment([%d, %d], start(%d)), fps(%d)", index, segment.from,
+                    segment.to, segment.start, config.fps
+                );
+                setPlayerState(OperationState::Play);
+                _first_flush_send_time = _current_event->send_time;
+                _is_first_flush_pending = true;
+                ESP_UTILS_CHECK_FALSE_RETURN(startReplay(index, {
+                    .fps = config.fps,
+                    .segment = segment,
+                    .is_repeat = true,
+                    .is_tile_source = false,
+                }), false, "Failed to start replay");
+                finish_function.release();
+                break;
+            }
+
+            bool is_load_interrupted = false;
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                loadAnimationData(index, is_load_interrupted), false, "Failed to load animation data: %d", index
+            );
+            if (is_load_interrupted) {
+                ESP_UTILS_LOGD("Animation(%d) is interrupted while loading", index);
+                return true;
+            }
+
+            bool is_tile_source = AnimTileDecoder::isTileFormat(config.data_address, config.data_length);
+            // Partition sources are checked by the asset verifier or the mmap assets, the others once loaded
+            if ((_assets_handle == nullptr) && !_asset_checked[index]) {
+                ESP_UTILS_CHECK_FALSE_RETURN(
+                    is_tile_source ? AnimTileDecoder::checkAsset(config.data_address, config.data_length) :
+                    AnimAssetVerifier::checkAsset(config.data_address, config.data_length), false,
+                    "Animation(%d) is corrupted", index
+                );
+                _asset_checked[index] = true;
+            }
+
+            // Tile-compressed animations are decoded by the player instead of the external decoder
+            if (is_tile_source) {
+                ESP_UTILS_CHECK_FALSE_RETURN(
+                    _tile_decoder.begin(
+                        config.data_address, config.data_length, ANIM_TILE_CANVAS_IN_EXT, _swap_data_bytes
+                    ), false, "Failed to begin tile decoder: %d", index
+                );
+                ESP_UTILS_CHECK_FALSE_RETURN(
+                    (_tile_decoder.getWidth() <= _canvas_config.width) &&
+                    (_tile_decoder.getHeight() <= _canvas_config.height), false, "Animation(%d) exceeds canvas", index
+                );
+                ESP_UTILS_CHECK_FALSE_RETURN(
+                    resolveSegment(event, _tile_decoder.getFrameNum() - 1, segment), false, "Failed to resolve segment"
+                );
+                ESP_UTILS_LOGI(
+                    "Play tile animation: %d, start(%d), end(%d), fps(%d), is_repeat(%d)", index, segment.start,
+                    segment.to, config.fps, is_repeat
+                );
+                setPlayerState(OperationState::Play);
+                _first_flush_send_time = _current_event->send_time;
+                _is_first_flush_pending = true;
+                ESP_UTILS_CHECK_FALSE_RETURN(startReplay(index, {
+                    .fps = config.fps,
+                    .segment = segment,
+                    .is_repeat = is_repeat,
+                    .is_tile_source = true,
+                }), false, "Failed to start replay");
+                finish_function.release();
+                break;
+            }
 
             ESP_UTILS_LOGD("Animation[%d] set src data start", index);
             ESP_UTILS_CHECK_ERROR_RETURN(
@@ -491,26 +1536,50 @@ bool AnimPlayer::processEvent(std::shared_ptr<EventWrapper> event_wrapper)
                 "Failed to set src data"
             );
             ESP_UTILS_LOGD("Animation[%d] set src data end", index);
+            // Parse the frame table once, it is kept for the cache and later plays
+            getFrameIndex(index);
 
-            _player_state = OperationState::Play;
+            // The decoder reports the whole range of the animation after the data is set
             anim_player_get_segment(_player_handle, &start, &end);
-            anim_player_set_segment(_player_handle, start, end, config.fps, is_repeat);
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                resolveSegment(event, static_cast<int>(end), segment), false, "Failed to resolve segment"
+            );
+            // Frames are independently encoded, so the decoder can start from any of them
+            _decode_segment = segment;
+            _decode_frame_index = segment.start - 1;
+            is_repeat = is_repeat && (segment.start == segment.from);
+
+            setPlayerState(OperationState::Play);
+            _first_flush_send_time = _current_event->send_time;
+            _is_first_flush_pending = true;
+            anim_player_set_segment(_player_handle, segment.start, segment.to, config.fps, is_repeat);
             anim_player_update(_player_handle, PLAYER_ACTION_START);
             ESP_UTILS_LOGI(
-                "Update animation: %d, start(%d), end(%d), fps(%d), is_repeat(%d)", index,
-                static_cast<int>(start), static_cast<int>(end), config.fps, is_repeat
+                "Update animation: %d, start(%d), end(%d), fps(%d), is_repeat(%d)", index, segment.start, segment.to,
+                config.fps, is_repeat
             );
+            finish_function.release();
             break;
         }
         case Operation::Pause: {
             break;
         }
         case Operation::Stop:
-            animation_stop_signal(
-                _canvas_config.coord_x, _canvas_config.coord_y, _canvas_config.coord_x + _canvas_config.width,
-                _canvas_config.coord_y + _canvas_config.height, this
-            );
-            if (_current_event != nullptr) {
+            ESP_UTILS_CHECK_FALSE_RETURN(drainFlushPipeline(true), false, "Failed to drain flush pipeline");
+            // The area is cleared by the receiver, so the next frame must be flushed completely
+            _delta_flush.invalidate();
+            if (_output_handler.clear != nullptr) {
+                _output_handler.clear(
+                    _canvas_config.coord_x, _canvas_config.coord_y, _canvas_config.coord_x + _canvas_config.width,
+                    _canvas_config.coord_y + _canvas_config.height
+                );
+            } else {
+                animation_stop_signal(
+                    _canvas_config.coord_x, _canvas_config.coord_y, _canvas_config.coord_x + _canvas_config.width,
+                    _canvas_config.coord_y + _canvas_config.height, this
+                );
+            }
+            if (_current_event.has_value()) {
                 // In this case, the current event type is PlayOnceStop, so we need to send value to the current event
                 if (_current_event->promise != nullptr) {
                     _current_event->promise->set_value();
@@ -5,17 +5,28 @@
  */
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <future>
 #include <mutex>
-#include <queue>
+#include <memory>
+#include <optional>
 #include <variant>
 #include <vector>
 #include "boost/signals2/signal.hpp"
 #include "boost/thread.hpp"
 #include "esp_mmap_assets.h"
 #include "anim_player.h"
+#include "esp_brookesia_anim_asset_verifier.hpp"
+#include "esp_brookesia_anim_delta_flush.hpp"
+#include "esp_brookesia_anim_file_source.hpp"
+#include "esp_brookesia_anim_frame_cache.hpp"
+#include "esp_brookesia_anim_frame_index.hpp"
+#include "esp_brookesia_anim_profiler.hpp"
+#include "esp_brookesia_anim_tile_decoder.hpp"
 
 namespace esp_brookesia::gui {
 
@@ -42,11 +53,18 @@ struct AnimPlayerResourcesConfig {
     std::variant<const AnimPlayerAnimAddress *, const AnimPlayerAnimPath *> resources;
 };
 
+enum class AnimPlayerPartitionCheck {
+    Full,           // Check the whole partition when it is loaded
+    Lazy,           // Check each animation when it is played for the first time
+    Background,     // Same as `Lazy`, and check the others ahead of time in a low priority background thread
+};
+
 struct AnimPlayerPartitionConfig {
     const char *partition_label;
     int max_files;
     const int *fps;
     uint32_t checksum;
+    AnimPlayerPartitionCheck check_mode;
 };
 
 struct AnimPlayerData {
@@ -67,10 +85,29 @@ struct AnimPlayerData {
         int task_stack;
         int task_affinity;
         bool task_stack_in_ext;
+        int pipeline_depth;             // Number of output buffers, `<= 1` disables pipelined flushing
+        bool pipeline_buffer_in_ext;
     } task;
     struct {
         int enable_data_swap_bytes: 1;
     } flags;
+    struct {
+        size_t budget_bytes;            // `0` disables the decoded-frame cache
+        bool buffer_in_ext;
+    } cache;
+    struct {
+        int tile_size;                  // `0` disables delta flushing
+        bool merge_tiles;
+        bool buffer_in_ext;
+    } delta;
+    struct {
+        size_t read_chunk_size;         // `0` uses the default size
+        bool buffer_in_ext;
+    } file;
+    struct {
+        bool enable_frame_skip;         // Keep to the wall-clock schedule by skipping frames which are already late
+        int max_skip_frames;            // Max consecutive skipped frames, the schedule is rebased when reached
+    } pacing;
 };
 
 class AnimPlayer {
@@ -104,7 +141,18 @@ public:
         struct {
             int enable_interrupt: 1;
             int force: 1;
+            int enable_segment: 1;  // Only play `segment` instead of the whole animation
         } flags;
+        struct {
+            int from_frame;
+            int to_frame;           // Inclusive, `FRAME_LAST` for the last frame
+            int start_frame;        // First frame to play, the loop restarts from `from_frame`
+        } segment;
+    };
+
+    struct Position {
+        int index;
+        int frame;
     };
 
     using EventFuture = std::future<void>;
@@ -117,7 +165,15 @@ public:
                                 >;
     using AnimationEndSignal = boost::signals2::signal<void(AnimPlayer *player)>;
 
+    struct OutputHandler {
+        std::function<void(int x_start, int y_start, int x_end, int y_end, const void *data)> flush;
+        std::function<void(int x_start, int y_start, int x_end, int y_end)> clear;
+        std::function<void()> frame_end;    // Optional, called after the last flush of each frame
+    };
+
     static constexpr int INDEX_NONE = -1;
+    static constexpr int FRAME_LAST = -1;
+    static constexpr size_t EVENT_QUEUE_SIZE = 8;
 
     AnimPlayer() = default;
     ~AnimPlayer();
@@ -128,37 +184,142 @@ public:
     bool begin(const AnimPlayerData &data);
     bool del();
 
+    /**
+     * @brief Queue an event, which is rejected when `EVENT_QUEUE_SIZE` events are already pending. The future is
+     *        ready once the event is finished, or has been dropped by a later event clearing the queue.
+     */
     bool sendEvent(const Event &event, bool clear_queue, EventFuture *future = nullptr);
 
-    bool notifyFlushFinished() const;
+    /**
+     * @brief Play the frames `[from_frame, to_frame]` of an animation, interrupting the current one. Every frame of
+     *        an animation is independently encoded, so playback starts at `from_frame` without decoding the frames
+     *        before it.
+     */
+    bool play(int index, int from_frame, int to_frame, bool loop, EventFuture *future = nullptr);
+
+    /**
+     * @brief Get the animation and frame being played, which are kept after the animation is paused or stopped
+     */
+    Position getPosition() const
+    {
+        return {_position_index, _position_frame};
+    }
+
+    bool notifyFlushFinished();
+
+    /**
+     * @brief Redirect the output to the handler instead of the global signals, must be called before `begin()`.
+     *        The flushed data must be consumed before the handler returns.
+     */
+    bool setOutputHandler(const OutputHandler &handler);
+
+    AnimFrameCache::Stats getFrameCacheStats();
+    AnimDeltaFlush::Stats getDeltaFlushStats() const;
+
+    /**
+     * @brief Frame timing, only recorded when `ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING` is enabled
+     */
+    AnimProfiler::Summary getProfileSummary();
+    std::vector<AnimProfiler::Sample> getProfileSamples();
+    void resetProfile();
+
+    /**
+     * @brief Number of frames skipped by the frame pacing since `begin()`
+     */
+    uint32_t getSkippedFrameNum() const
+    {
+        return _pacing_skipped_frames;
+    }
 
     static FlushReadySignal flush_ready_signal;
     static AnimationStopSignal animation_stop_signal;
 
 private:
     using EventPromise = std::promise<void>;
+    struct Segment {
+        int from;
+        int to;
+        int start;
+    };
+    struct ReplayConfig {
+        int fps;
+        Segment segment;
+        bool is_repeat;
+        bool is_tile_source;            // Decode the tile-compressed animation instead of reading the frame cache
+    };
     struct EventWrapper {
         Event event;
-        std::shared_ptr<EventPromise> promise;
+        std::unique_ptr<EventPromise> promise;  // Only allocated when the caller asks for a future
+        std::chrono::steady_clock::time_point send_time;
     };
 
     bool loadAnimationConfig(const AnimPlayerPartitionConfig &partition_config);
     bool loadAnimationConfig(const AnimPlayerAnimAddress *anim_address, int num);
-    bool loadAnimationConfig(const AnimPlayerAnimPath *anim_path, int num);
+    bool loadAnimationConfig(const AnimPlayerAnimPath *anim_path, int num, const AnimFileSource::Config &config);
+    bool loadAnimationData(int index, bool &is_interrupted);
     bool waitPlayerFrameDone();
     bool waitPlayerIdle();
     bool waitPlayerState(OperationState state);
-    bool processEvent(std::shared_ptr<EventWrapper> event_wrapper);
+    bool processEvent(EventWrapper &event_wrapper);
+    // The following event queue functions must be called with `_event_mutex` held
+    bool pushEvent(EventWrapper &&event_wrapper);
+    bool popEvent(EventWrapper &event_wrapper);
+    void clearEvents();
+    bool isEventQueueEmpty() const
+    {
+        return (_event_queue_size == 0);
+    }
+    bool isEventQueueFull() const
+    {
+        return (_event_queue_size == _event_queue.size());
+    }
+    bool hasInterruptEvent() const;
+    void setPlayerState(OperationState state);
+    bool beginFlushPipeline(const AnimPlayerData &data);
+    bool pushFlushPipeline(
+        int x_start, int y_start, int x_end, int y_end, const void *data, bool is_frame_end, bool swap_bytes
+    );
+    bool drainFlushPipeline(bool discard);
+    bool isFlushPipelineEnabled() const
+    {
+        return !_flush_slots.empty();
+    }
+    void emitFlush(int x_start, int y_start, int x_end, int y_end, const void *data, bool is_frame_end);
+    void onPlayerFrameDone();
+    void onPlayerIdle();
+    bool beginFrameCache(const AnimPlayerData &data);
+    void recordFrameCache(int y1, int x_start, int y_start, int x_end, int y_end, const void *data);
+    AnimFrameIndex *getFrameIndex(int index);
+    bool resolveSegment(const Event &event, int last_frame, Segment &segment);
+    bool isAnimationCached(int index, const Segment &segment);
+    bool beginReplayThread();
+    bool startReplay(int index, const ReplayConfig &config);
+    bool stopReplay();
+    bool processReplay(int index, const ReplayConfig &config);
+    bool isReplaying() const
+    {
+        return (_replay_index != INDEX_NONE);
+    }
+    void resetPacing(int fps);
+    bool beginPacedFrame();
+    std::chrono::steady_clock::time_point getPacedFrameDeadline() const;
 
     bool _is_begun = false;
     AnimPlayerCanvasConfig _canvas_config = {};
+    bool _swap_data_bytes = false;
+    bool _swap_decoder_output = false;  // Swapped by the player while the decoder output is copied, not by the decoder
     std::vector<AnimPlayerAnimAddress> _animation_configs;
-    std::vector<std::vector<uint8_t>> _animation_data;
+    std::vector<std::unique_ptr<AnimFileSource>> _animation_files;
+    int _animation_file_loaded_index = INDEX_NONE;
 
     std::atomic<bool> _event_thread_need_exit = false;
     boost::thread _event_thread;
-    std::queue<std::shared_ptr<EventWrapper>> _event_queue;
-    std::shared_ptr<EventWrapper> _current_event;
+    std::array<EventWrapper, EVENT_QUEUE_SIZE> _event_queue;
+    size_t _event_queue_head = 0;
+    size_t _event_queue_size = 0;
+    std::optional<EventWrapper> _current_event;
+    std::atomic<bool> _is_first_flush_pending = false;
+    std::chrono::steady_clock::time_point _first_flush_send_time;
     std::mutex _event_mutex;
     std::condition_variable _event_cv;
 
@@ -166,11 +327,73 @@ private:
     struct {
         int is_starting: 1;
         int is_frame_done: 1;
-    } _player_flags;
+        int is_stopping: 1;     // The decoder is stopped by the event thread, which drains the pipeline itself
+    } _player_flags = {};
     OperationState _player_state = OperationState::Stop;
     std::condition_variable _player_condition;
     anim_player_handle_t _player_handle = nullptr;
     mmap_assets_handle_t _assets_handle = nullptr;
+
+    struct FlushSlot {
+        int x_start;
+        int y_start;
+        int x_end;
+        int y_end;
+        size_t size;
+        size_t capacity;
+        bool is_frame_end;
+        std::unique_ptr<uint8_t, void(*)(void *)> buffer;
+    };
+    std::vector<FlushSlot> _flush_slots;
+    bool _flush_buffer_in_ext = false;
+    size_t _flush_slot_write = 0;
+    size_t _flush_slot_emit = 0;
+    size_t _flush_slot_used = 0;
+    size_t _flush_slot_ready = 0;
+    bool _flush_slot_is_flushing = false;
+    std::atomic<bool> _flush_thread_need_exit = false;
+    boost::thread _flush_thread;
+    std::mutex _flush_mutex;
+    std::condition_variable _flush_cv;
+
+    AnimFrameCache _frame_cache;
+    std::vector<AnimFrameIndex> _frame_indexes;
+    std::vector<bool> _asset_checked;   // Animations which passed the checksum since they were loaded
+    int _decode_index = INDEX_NONE;
+    int _decode_frame_index = -1;
+    Segment _decode_segment = {};
+    std::atomic<int> _position_index = INDEX_NONE;
+    std::atomic<int> _position_frame = -1;
+    std::atomic<int> _replay_index = INDEX_NONE;
+    ReplayConfig _replay_config = {};
+    bool _replay_need_stop = false;
+    bool _replay_flush_pending = false;
+    std::atomic<bool> _replay_thread_need_exit = false;
+    boost::thread _replay_thread;
+    std::mutex _replay_mutex;
+    std::condition_variable _replay_cv;
+
+    OutputHandler _output_handler;
+    AnimProfiler _profiler;
+    AnimAssetVerifier _asset_verifier;
+
+    // Only accessed by the thread producing frames, which is either the decoder or the replay thread
+    bool _pacing_enable_skip = false;
+    int _pacing_max_skip_frames = 0;
+    std::chrono::microseconds _pacing_frame_period{0};
+    std::chrono::steady_clock::time_point _pacing_start_time;
+    int _pacing_frame_index = -1;
+    int _pacing_skip_frames = 0;
+    bool _pacing_is_skipping = false;
+    std::atomic<uint32_t> _pacing_skipped_frames = 0;
+
+    AnimTileDecoder _tile_decoder;
+    std::vector<AnimTileDecoder::Rect> _tile_rects;
+
+    AnimDeltaFlush _delta_flush;
+    std::vector<AnimDeltaFlush::Rect> _delta_rects;
+    size_t _delta_pending_rects = 0;
+    std::mutex _delta_mutex;
 };
 
 } // namespace esp_brookesia::gui
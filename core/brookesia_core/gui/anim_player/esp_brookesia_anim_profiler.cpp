@@ -0,0 +1,238 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "esp_brookesia_anim_profiler.hpp"
+
+namespace esp_brookesia::gui {
+
+bool AnimProfiler::begin(const Config &config)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: sample_num(%d), report_interval_ms(%d)", static_cast<int>(config.sample_num),
+        static_cast<int>(config.report_interval_ms)
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(config.sample_num > 0, false, "Invalid sample num");
+
+    std::lock_guard lock(_mutex);
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(_samples.assign(config.sample_num, Sample{}), false, "Failed to allocate samples");
+    _config = config;
+    _sample_next = 0;
+    _sample_count = 0;
+    _total_frames = 0;
+    _dropped_frames = 0;
+    _has_frame = false;
+    _is_decoding = false;
+    _is_flush_waiting = false;
+    _is_flushing = false;
+    _last_report = Clock::now();
+    _is_begun = true;
+
+    return true;
+}
+
+void AnimProfiler::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    std::lock_guard lock(_mutex);
+    _samples.clear();
+    _samples.shrink_to_fit();
+    _is_begun = false;
+}
+
+void AnimProfiler::setTargetFps(int fps)
+{
+    std::lock_guard lock(_mutex);
+    _target_fps = fps;
+    // The interval across an animation switch is not a frame interval
+    _has_frame = false;
+}
+
+void AnimProfiler::onDecodeStripBegin()
+{
+    auto now = Clock::now();
+
+    std::lock_guard lock(_mutex);
+    if (_is_decoding) {
+        _frame.decode_us += elapsedUs(_decode_start, now);
+        _is_decoding = false;
+    }
+    _flush_wait_start = now;
+    _is_flush_waiting = true;
+}
+
+void AnimProfiler::onDecodeStripReleased()
+{
+    auto now = Clock::now();
+
+    std::lock_guard lock(_mutex);
+    if (_is_flush_waiting) {
+        _frame.flush_wait_us += elapsedUs(_flush_wait_start, now);
+        _is_flush_waiting = false;
+    }
+    _decode_start = now;
+    _is_decoding = true;
+}
+
+void AnimProfiler::onFlushBegin(bool is_frame_start)
+{
+    auto now = Clock::now();
+    Summary report = {};
+    bool need_report = false;
+
+    {
+        std::lock_guard lock(_mutex);
+        if (is_frame_start) {
+            need_report = commitFrame(now, report);
+        }
+        _flush_start = now;
+        _is_flushing = true;
+    }
+
+    // Logging is slow, so it is done after the decoder and flush threads are released
+    if (need_report) {
+        logSummary(report);
+    }
+}
+
+void AnimProfiler::onFlushEnd()
+{
+    auto now = Clock::now();
+
+    std::lock_guard lock(_mutex);
+    if (_is_flushing) {
+        _frame.flush_us += elapsedUs(_flush_start, now);
+        _is_flushing = false;
+    }
+}
+
+AnimProfiler::Summary AnimProfiler::getSummary()
+{
+    std::lock_guard lock(_mutex);
+
+    return makeSummary();
+}
+
+std::vector<AnimProfiler::Sample> AnimProfiler::getSamples()
+{
+    std::lock_guard lock(_mutex);
+
+    // From the oldest to the newest
+    std::vector<Sample> samples;
+    samples.reserve(_sample_count);
+    size_t first = (_sample_next + _samples.size() - _sample_count) % std::max<size_t>(_samples.size(), 1);
+    for (size_t i = 0; i < _sample_count; i++) {
+        samples.push_back(_samples[(first + i) % _samples.size()]);
+    }
+
+    return samples;
+}
+
+void AnimProfiler::reset()
+{
+    std::lock_guard lock(_mutex);
+
+    _sample_next = 0;
+    _sample_count = 0;
+    _total_frames = 0;
+    _dropped_frames = 0;
+    _has_frame = false;
+}
+
+uint32_t AnimProfiler::elapsedUs(Clock::time_point start, Clock::time_point end)
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+bool AnimProfiler::commitFrame(Clock::time_point now, Summary &report)
+{
+    if (!_is_begun) {
+        return false;
+    }
+
+    if (_has_frame) {
+        _frame.interval_us = elapsedUs(_frame_start, now);
+        _samples[_sample_next] = _frame;
+        _sample_next = (_sample_next + 1) % _samples.size();
+        _sample_count = std::min(_sample_count + 1, _samples.size());
+        _total_frames++;
+
+        // A frame is dropped for every whole period the interval exceeds the target by
+        if (_target_fps > 0) {
+            uint32_t period_us = 1000000 / _target_fps;
+            uint32_t periods = (_frame.interval_us + period_us / 2) / period_us;
+            if (periods > 1) {
+                _dropped_frames += periods - 1;
+            }
+        }
+    }
+    _frame = {};
+    _frame_start = now;
+    _has_frame = true;
+
+    if ((_config.report_interval_ms == 0) ||
+            (now - _last_report < std::chrono::milliseconds(_config.report_interval_ms))) {
+        return false;
+    }
+    _last_report = now;
+    report = makeSummary();
+
+    return true;
+}
+
+void AnimProfiler::logSummary(const Summary &summary) const
+{
+    ESP_UTILS_LOGI(
+        "Player(%p): fps(%.1f/%d), dropped(%d/%d), decode(%d/%d us), flush wait(%d/%d us), flush(%d/%d us)",
+        _config.owner, summary.achieved_fps, summary.target_fps, static_cast<int>(summary.dropped_frames),
+        static_cast<int>(summary.frames), static_cast<int>(summary.decode_us_avg),
+        static_cast<int>(summary.decode_us_max), static_cast<int>(summary.flush_wait_us_avg),
+        static_cast<int>(summary.flush_wait_us_max), static_cast<int>(summary.flush_us_avg),
+        static_cast<int>(summary.flush_us_max)
+    );
+}
+
+AnimProfiler::Summary AnimProfiler::makeSummary() const
+{
+    Summary summary = {
+        .frames = _total_frames,
+        .dropped_frames = _dropped_frames,
+        .target_fps = _target_fps,
+    };
+    if (_sample_count == 0) {
+        return summary;
+    }
+
+    uint64_t interval_sum = 0;
+    uint64_t decode_sum = 0;
+    uint64_t flush_wait_sum = 0;
+    uint64_t flush_sum = 0;
+    for (size_t i = 0; i < _sample_count; i++) {
+        auto &sample = _samples[i];
+        interval_sum += sample.interval_us;
+        decode_sum += sample.decode_us;
+        flush_wait_sum += sample.flush_wait_us;
+        flush_sum += sample.flush_us;
+        summary.decode_us_max = std::max(summary.decode_us_max, sample.decode_us);
+        summary.flush_wait_us_max = std::max(summary.flush_wait_us_max, sample.flush_wait_us);
+        summary.flush_us_max = std::max(summary.flush_us_max, sample.flush_us);
+    }
+    summary.achieved_fps = (interval_sum > 0) ? (1000000.0f * _sample_count / interval_sum) : 0;
+    summary.decode_us_avg = decode_sum / _sample_count;
+    summary.flush_wait_us_avg = flush_wait_sum / _sample_count;
+    summary.flush_us_avg = flush_sum / _sample_count;
+
+    return summary;
+}
+
+} // namespace esp_brookesia::gui
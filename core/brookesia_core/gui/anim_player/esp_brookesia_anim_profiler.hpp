@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Ring-buffered frame timing of a player. All durations are in microseconds.
+ */
+class AnimProfiler {
+public:
+    struct Config {
+        size_t sample_num;
+        uint32_t report_interval_ms;    // `0` disables the periodic summary log
+        const void *owner;              // Only used to tell the players apart in the log
+    };
+
+    struct Sample {
+        uint32_t interval_us;           // Between the starts of this frame and the previous one
+        uint32_t decode_us;             // Spent by the decoder producing the strips
+        uint32_t flush_wait_us;         // Spent by the decoder waiting for the strips to be taken over
+        uint32_t flush_us;              // From emitting the strips to `notifyFlushFinished()`
+    };
+
+    struct Summary {
+        uint32_t frames;
+        uint32_t dropped_frames;
+        int target_fps;
+        float achieved_fps;
+        uint32_t decode_us_avg;
+        uint32_t decode_us_max;
+        uint32_t flush_wait_us_avg;
+        uint32_t flush_wait_us_max;
+        uint32_t flush_us_avg;
+        uint32_t flush_us_max;
+    };
+
+    bool begin(const Config &config);
+    void del();
+
+    void setTargetFps(int fps);
+    void onDecodeStripBegin();
+    void onDecodeStripReleased();
+    void onFlushBegin(bool is_frame_start);
+    void onFlushEnd();
+
+    Summary getSummary();
+    std::vector<Sample> getSamples();
+    void reset();
+
+    bool isBegun() const
+    {
+        return _is_begun;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static uint32_t elapsedUs(Clock::time_point start, Clock::time_point end);
+    // Return true and fill `report` when the periodic summary is due
+    bool commitFrame(Clock::time_point now, Summary &report);
+    Summary makeSummary() const;
+    void logSummary(const Summary &summary) const;
+
+    bool _is_begun = false;
+    Config _config = {};
+    std::mutex _mutex;
+
+    std::vector<Sample> _samples;
+    size_t _sample_next = 0;
+    size_t _sample_count = 0;
+    uint32_t _total_frames = 0;
+    uint32_t _dropped_frames = 0;
+    int _target_fps = 0;
+
+    Sample _frame = {};
+    bool _has_frame = false;
+    Clock::time_point _frame_start;
+    Clock::time_point _decode_start;
+    Clock::time_point _flush_wait_start;
+    Clock::time_point _flush_start;
+    bool _is_decoding = false;
+    bool _is_flush_waiting = false;
+    bool _is_flushing = false;
+    Clock::time_point _last_report;
+};
+
+} // namespace esp_brookesia::gui
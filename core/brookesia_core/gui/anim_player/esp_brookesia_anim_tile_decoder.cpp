@@ -0,0 +1,307 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include "esp_heap_caps.h"
+#include "esp_brookesia_gui_internal.h"
+#if !ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG
+#   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
+#endif
+#include "private/esp_brookesia_anim_player_utils.hpp"
+#include "pixel/esp_brookesia_pixel_kernels.hpp"
+#include "esp_brookesia_anim_tile_decoder.hpp"
+
+/**
+ * Header layout: magic "ATF1", checksum(u32), data_length(u32), width(u16), height(u16), tile_size(u16),
+ * reserved(u16), frame_num(u32), then `frame_num` entries of offset(u32) and size(u32), where the offset is relative
+ * to the end of the table. See `tools/anim_transcoder/anim_transcoder.py` for the frame layout.
+ */
+#define ATF_MAGIC                   "ATF1"
+#define ATF_MAGIC_SIZE              (4)
+#define ATF_HEADER_SIZE             (24)
+#define ATF_DATA_START              (12)
+#define ATF_TABLE_ENTRY_SIZE        (8)
+#define ATF_FRAME_FLAG_KEYFRAME     (0x01)
+#define ATF_TILE_METHOD_RAW         (0)
+#define ATF_TILE_METHOD_RLE         (1)
+#define ATF_TILE_HEADER_SIZE        (3)
+#define ATF_PIXEL_BYTES             (2)
+
+namespace esp_brookesia::gui {
+
+static uint16_t read_u16(const uint8_t *ptr)
+{
+    uint16_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static uint16_t read_pixel(const uint8_t *ptr, bool swap_bytes)
+{
+    uint16_t value = read_u16(ptr);
+    return swap_bytes ? static_cast<uint16_t>((value << 8) | (value >> 8)) : value;
+}
+
+static uint32_t read_u32(const uint8_t *ptr)
+{
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+bool AnimTileDecoder::begin(const void *data, size_t length, bool buffer_in_ext, bool swap_bytes)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: data(%p), length(%d), buffer_in_ext(%d), swap_bytes(%d)", data, static_cast<int>(length),
+        buffer_in_ext, swap_bytes
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(isTileFormat(data, length), false, "Invalid format");
+
+    auto bytes = static_cast<const uint8_t *>(data);
+    size_t data_end = ATF_DATA_START + read_u32(bytes + 8);
+    int width = read_u16(bytes + 12);
+    int height = read_u16(bytes + 14);
+    int tile_size = read_u16(bytes + 16);
+    uint32_t frame_num = read_u32(bytes + 20);
+    size_t table_end = ATF_HEADER_SIZE + static_cast<size_t>(frame_num) * ATF_TABLE_ENTRY_SIZE;
+    ESP_UTILS_CHECK_FALSE_RETURN(data_end <= length, false, "Invalid data length");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (width > 0) && (height > 0) && (tile_size > 0), false, "Invalid size(%dx%d), tile size(%d)", width, height,
+        tile_size
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (frame_num > 0) && (table_end <= data_end), false, "Invalid frame num(%d)", static_cast<int>(frame_num)
+    );
+
+    std::vector<Frame> frames;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(frames.reserve(frame_num), false, "Failed to allocate frame table");
+    for (uint32_t i = 0; i < frame_num; i++) {
+        auto entry = bytes + ATF_HEADER_SIZE + i * ATF_TABLE_ENTRY_SIZE;
+        uint32_t offset = read_u32(entry);
+        uint32_t size = read_u32(entry + 4);
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (size > 0) && (table_end + offset + size <= data_end), false, "Invalid frame(%d): offset(%d), size(%d)",
+            static_cast<int>(i), static_cast<int>(offset), static_cast<int>(size)
+        );
+        frames.push_back(Frame{
+            .data = bytes + table_end + offset,
+            .size = size,
+            .is_keyframe = static_cast<bool>(bytes[table_end + offset] & ATF_FRAME_FLAG_KEYFRAME),
+        });
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(frames[0].is_keyframe, false, "The first frame is not a keyframe");
+
+    // Keep the canvas between animations of the same size
+    size_t canvas_pixels = static_cast<size_t>(width) * height;
+    if ((_canvas == nullptr) || (_canvas_pixels != canvas_pixels) || (_canvas_in_ext != buffer_in_ext)) {
+        _canvas.reset();
+        uint32_t caps = (buffer_in_ext ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT;
+        _canvas = std::unique_ptr<uint16_t, void(*)(void *)>(
+                      static_cast<uint16_t *>(heap_caps_malloc(canvas_pixels * ATF_PIXEL_BYTES, caps)), heap_caps_free
+                  );
+        ESP_UTILS_CHECK_NULL_RETURN(_canvas, false, "Failed to allocate canvas(%dx%d)", width, height);
+        _canvas_pixels = canvas_pixels;
+        _canvas_in_ext = buffer_in_ext;
+    }
+
+    _data = bytes;
+    _width = width;
+    _height = height;
+    _tile_size = tile_size;
+    _swap_bytes = swap_bytes;
+    _tiles_x = (width + tile_size - 1) / tile_size;
+    _tiles_y = (height + tile_size - 1) / tile_size;
+    _frames = std::move(frames);
+    _dirty_rows.assign(_tiles_y, 0);
+    _last_frame_index = -1;
+    _is_begun = true;
+
+    ESP_UTILS_LOGD(
+        "Tile animation: size(%dx%d), tile size(%d), frames(%d)", width, height, tile_size, static_cast<int>(frame_num)
+    );
+
+    return true;
+}
+
+bool AnimTileDecoder::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    _canvas.reset();
+    _canvas_pixels = 0;
+    _frames.clear();
+    _dirty_rows.clear();
+    _data = nullptr;
+    _last_frame_index = -1;
+    _is_begun = false;
+
+    return true;
+}
+
+bool AnimTileDecoder::decodeFrame(int frame_index)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_begun, false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (frame_index >= 0) && (frame_index < getFrameNum()), false, "Invalid frame index: %d", frame_index
+    );
+
+    // Seek from the nearest keyframe, or continue from the last frame if it is nearer, so skipped frames which
+    // precede a keyframe are never decoded
+    int start = frame_index;
+    while ((start > 0) && !_frames[start].is_keyframe) {
+        start--;
+    }
+    if ((_last_frame_index >= start) && (_last_frame_index < frame_index)) {
+        start = _last_frame_index + 1;
+    }
+    for (int i = start; i <= frame_index; i++) {
+        if (!applyFrame(_frames[i])) {
+            ESP_UTILS_LOGE("Failed to decode frame(%d)", i);
+            _last_frame_index = -1;
+            return false;
+        }
+    }
+    _last_frame_index = frame_index;
+
+    return true;
+}
+
+void AnimTileDecoder::takeDirtyRects(std::vector<Rect> &rects)
+{
+    rects.clear();
+
+    int ty = 0;
+    while (ty < _tiles_y) {
+        if (!_dirty_rows[ty]) {
+            ty++;
+            continue;
+        }
+        int ty_end = ty + 1;
+        while ((ty_end < _tiles_y) && _dirty_rows[ty_end]) {
+            ty_end++;
+        }
+
+        int y_start = ty * _tile_size;
+        int y_end = std::min(ty_end * _tile_size, _height);
+        rects.push_back(Rect{0, y_start, _width, y_end, _canvas.get() + static_cast<size_t>(y_start) * _width});
+        ty = ty_end;
+    }
+    std::fill(_dirty_rows.begin(), _dirty_rows.end(), 0);
+}
+
+bool AnimTileDecoder::isTileFormat(const void *data, size_t length)
+{
+    return (data != nullptr) && (length >= ATF_HEADER_SIZE) && (memcmp(data, ATF_MAGIC, ATF_MAGIC_SIZE) == 0);
+}
+
+bool AnimTileDecoder::checkAsset(const void *data, size_t length)
+{
+    if (!isTileFormat(data, length)) {
+        return false;
+    }
+
+    auto bytes = static_cast<const uint8_t *>(data);
+    size_t data_length = read_u32(bytes + 8);
+    if (data_length > length - ATF_DATA_START) {
+        return false;
+    }
+
+    uint32_t sum = 0;
+    for (size_t i = 0; i < data_length; i++) {
+        sum += bytes[ATF_DATA_START + i];
+    }
+
+    return (sum == read_u32(bytes + 4));
+}
+
+bool AnimTileDecoder::applyFrame(const Frame &frame)
+{
+    size_t bitmap_size = (static_cast<size_t>(_tiles_x) * _tiles_y + 7) / 8;
+    ESP_UTILS_CHECK_FALSE_RETURN(frame.size >= 1 + bitmap_size, false, "Truncated frame");
+
+    const uint8_t *bitmap = frame.data + 1;
+    const uint8_t *ptr = bitmap + bitmap_size;
+    const uint8_t *end = frame.data + frame.size;
+    for (int ty = 0; ty < _tiles_y; ty++) {
+        for (int tx = 0; tx < _tiles_x; tx++) {
+            int tile_index = ty * _tiles_x + tx;
+            if (!(bitmap[tile_index / 8] & (1 << (tile_index % 8)))) {
+                continue;
+            }
+            ESP_UTILS_CHECK_FALSE_RETURN(end - ptr >= ATF_TILE_HEADER_SIZE, false, "Truncated tile(%d)", tile_index);
+            uint8_t method = ptr[0];
+            size_t length = read_u16(ptr + 1);
+            ptr += ATF_TILE_HEADER_SIZE;
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                static_cast<size_t>(end - ptr) >= length, false, "Truncated tile(%d) payload", tile_index
+            );
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                decodeTile(tx, ty, method, ptr, length), false, "Failed to decode tile(%d)", tile_index
+            );
+            ptr += length;
+            _dirty_rows[ty] = 1;
+        }
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(ptr == end, false, "Trailing frame data");
+
+    return true;
+}
+
+bool AnimTileDecoder::decodeTile(int tile_x, int tile_y, uint8_t method, const uint8_t *payload, size_t length)
+{
+    int x_start = tile_x * _tile_size;
+    int y_start = tile_y * _tile_size;
+    int tile_width = std::min(_tile_size, _width - x_start);
+    int tile_height = std::min(_tile_size, _height - y_start);
+    size_t pixel_num = static_cast<size_t>(tile_width) * tile_height;
+    uint16_t *row = _canvas.get() + static_cast<size_t>(y_start) * _width + x_start;
+
+    if (method == ATF_TILE_METHOD_RAW) {
+        ESP_UTILS_CHECK_FALSE_RETURN(length == pixel_num * ATF_PIXEL_BYTES, false, "Invalid raw tile length");
+        size_t row_bytes = static_cast<size_t>(tile_width) * ATF_PIXEL_BYTES;
+        for (int y = 0; y < tile_height; y++) {
+            if (_swap_bytes) {
+                pixel::swap16(row + static_cast<size_t>(y) * _width, payload + y * row_bytes, tile_width);
+            } else {
+                memcpy(row + static_cast<size_t>(y) * _width, payload + y * row_bytes, row_bytes);
+            }
+        }
+        return true;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(method == ATF_TILE_METHOD_RLE, false, "Invalid tile method(%d)", method);
+
+    // Expand the packets straight into the canvas, wrapping to the next row at the tile edge
+    const uint8_t *end = payload + length;
+    size_t pixel_index = 0;
+    int x = 0;
+    uint16_t *dst = row;
+    while ((payload < end) && (pixel_index < pixel_num)) {
+        uint8_t control = *payload++;
+        bool is_run = (control & 0x80);
+        size_t count = (control & 0x7f) + 1;
+        ESP_UTILS_CHECK_FALSE_RETURN(pixel_index + count <= pixel_num, false, "RLE overflow");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            static_cast<size_t>(end - payload) >= (is_run ? 1 : count) * ATF_PIXEL_BYTES, false, "Truncated RLE"
+        );
+        uint16_t value = read_pixel(payload, _swap_bytes);
+        for (size_t i = 0; i < count; i++) {
+            dst[x] = is_run ? value : read_pixel(payload + i * ATF_PIXEL_BYTES, _swap_bytes);
+            if (++x == tile_width) {
+                x = 0;
+                dst += _width;
+            }
+        }
+        payload += (is_run ? 1 : count) * ATF_PIXEL_BYTES;
+        pixel_index += count;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN((pixel_index == pixel_num) && (payload == end), false, "Invalid RLE payload");
+
+    return true;
+}
+
+} // namespace esp_brookesia::gui
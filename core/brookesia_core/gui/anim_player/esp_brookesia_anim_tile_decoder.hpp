@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace esp_brookesia::gui {
+
+/**
+ * @brief Decoder of the tile-compressed animation format (.atf) generated by `tools/anim_transcoder`. Only the tiles
+ *        which changed are decoded, and any frame can be reached from its nearest keyframe.
+ */
+class AnimTileDecoder {
+public:
+    struct Rect {
+        int x_start;
+        int y_start;
+        int x_end;
+        int y_end;
+        const void *data;
+    };
+
+    AnimTileDecoder() = default;
+    ~AnimTileDecoder() = default;
+
+    AnimTileDecoder(const AnimTileDecoder &) = delete;
+    AnimTileDecoder &operator=(const AnimTileDecoder &) = delete;
+
+    /**
+     * @brief Begin decoding an animation, with the bytes of each pixel swapped when `swap_bytes` is set
+     */
+    bool begin(const void *data, size_t length, bool buffer_in_ext, bool swap_bytes);
+    bool del();
+
+    /**
+     * @brief Decode a frame into the canvas, from the last decoded frame or from the nearest keyframe, whichever is
+     *        nearer. The canvas holds the changes of all the frames in between.
+     */
+    bool decodeFrame(int frame_index);
+
+    /**
+     * @brief Get the canvas rows changed since the last call, as full-width bands which point into the canvas. The
+     *        data stays valid until the next `decodeFrame()`.
+     */
+    void takeDirtyRects(std::vector<Rect> &rects);
+
+    static bool isTileFormat(const void *data, size_t length);
+    /**
+     * @brief Check the header checksum of an animation, which covers all data after the first 12 bytes
+     */
+    static bool checkAsset(const void *data, size_t length);
+
+    bool isBegun() const
+    {
+        return _is_begun;
+    }
+    int getWidth() const
+    {
+        return _width;
+    }
+    int getHeight() const
+    {
+        return _height;
+    }
+    int getFrameNum() const
+    {
+        return static_cast<int>(_frames.size());
+    }
+
+private:
+    struct Frame {
+        const uint8_t *data;
+        uint32_t size;
+        bool is_keyframe;
+    };
+
+    bool applyFrame(const Frame &frame);
+    bool decodeTile(int tile_x, int tile_y, uint8_t method, const uint8_t *payload, size_t length);
+
+    bool _is_begun = false;
+    const uint8_t *_data = nullptr;
+    int _width = 0;
+    int _height = 0;
+    int _tile_size = 0;
+    bool _swap_bytes = false;
+    int _tiles_x = 0;
+    int _tiles_y = 0;
+    std::vector<Frame> _frames;
+    int _last_frame_index = -1;
+    std::unique_ptr<uint16_t, void(*)(void *)> _canvas = std::unique_ptr<uint16_t, void(*)(void *)>(nullptr, nullptr);
+    size_t _canvas_pixels = 0;
+    bool _canvas_in_ext = false;
+    std::vector<uint8_t> _dirty_rows;   // One flag per tile row
+};
+
+} // namespace esp_brookesia::gui
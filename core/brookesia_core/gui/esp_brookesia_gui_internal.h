@@ -30,6 +30,30 @@
 #           define ESP_BROOKESIA_ANIM_PLAYER_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+#   if !defined(ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING)
+#       if defined(CONFIG_ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING)
+#           define ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING  CONFIG_ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING
+#       else
+#           define ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING  (0)
+#       endif
+#   endif
+#   if ESP_BROOKESIA_ANIM_PLAYER_ENABLE_PROFILING
+#       if !defined(ESP_BROOKESIA_ANIM_PLAYER_PROFILING_SAMPLE_NUM)
+#           if defined(CONFIG_ESP_BROOKESIA_ANIM_PLAYER_PROFILING_SAMPLE_NUM)
+#               define ESP_BROOKESIA_ANIM_PLAYER_PROFILING_SAMPLE_NUM  CONFIG_ESP_BROOKESIA_ANIM_PLAYER_PROFILING_SAMPLE_NUM
+#           else
+#               define ESP_BROOKESIA_ANIM_PLAYER_PROFILING_SAMPLE_NUM  (64)
+#           endif
+#       endif
+#       if !defined(ESP_BROOKESIA_ANIM_PLAYER_PROFILING_REPORT_INTERVAL_MS)
+#           if defined(CONFIG_ESP_BROOKESIA_ANIM_PLAYER_PROFILING_REPORT_INTERVAL_MS)
+#               define ESP_BROOKESIA_ANIM_PLAYER_PROFILING_REPORT_INTERVAL_MS \
+                    CONFIG_ESP_BROOKESIA_ANIM_PLAYER_PROFILING_REPORT_INTERVAL_MS
+#           else
+#               define ESP_BROOKESIA_ANIM_PLAYER_PROFILING_REPORT_INTERVAL_MS  (0)
+#           endif
+#       endif
+#   endif
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
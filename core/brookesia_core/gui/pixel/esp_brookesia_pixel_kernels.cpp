@@ -0,0 +1,225 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cstring>
+#include "esp_brookesia_pixel_kernels.hpp"
+
+// GCC vector extensions are lowered to SSE2/NEON on the host, the Xtensa and RISC-V targets use the word path
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#   define PIXEL_KERNELS_ENABLE_VECTOR  (1)
+#else
+#   define PIXEL_KERNELS_ENABLE_VECTOR  (0)
+#endif
+
+namespace esp_brookesia::gui::pixel {
+
+namespace {
+
+inline uint16_t swap_pixel(uint16_t pixel)
+{
+    return static_cast<uint16_t>((pixel << 8) | (pixel >> 8));
+}
+
+inline uint32_t swap_word(uint32_t word)
+{
+    return ((word & 0x00FF00FFU) << 8) | ((word >> 8) & 0x00FF00FFU);
+}
+
+inline uint32_t rgb565_to_argb(uint16_t pixel)
+{
+    uint32_t r = (pixel >> 11) & 0x1F;
+    uint32_t g = (pixel >> 5) & 0x3F;
+    uint32_t b = pixel & 0x1F;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+
+    return 0xFF000000U | (r << 16) | (g << 8) | b;
+}
+
+inline uint16_t rgb_to_rgb565(uint32_t r, uint32_t g, uint32_t b)
+{
+    return static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+} // namespace
+
+void swap16(void *dst, const void *src, size_t pixels)
+{
+    auto dst_ptr = static_cast<uint8_t *>(dst);
+    auto src_ptr = static_cast<const uint8_t *>(src);
+    auto dst_addr = reinterpret_cast<uintptr_t>(dst_ptr);
+    auto src_addr = reinterpret_cast<uintptr_t>(src_ptr);
+
+    // Byte-aligned buffers, or buffers which can never be word-aligned together
+    if (((dst_addr | src_addr) & 0x1) || ((dst_addr ^ src_addr) & 0x3)) {
+        for (size_t i = 0; i < pixels; i++) {
+            uint8_t low = src_ptr[i * 2];
+            dst_ptr[i * 2] = src_ptr[i * 2 + 1];
+            dst_ptr[i * 2 + 1] = low;
+        }
+        return;
+    }
+
+    auto dst16 = reinterpret_cast<uint16_t *>(dst_ptr);
+    auto src16 = reinterpret_cast<const uint16_t *>(src_ptr);
+    if ((src_addr & 0x3) && (pixels > 0)) {
+        *dst16++ = swap_pixel(*src16++);
+        pixels--;
+    }
+
+    auto dst32 = reinterpret_cast<uint32_t *>(dst16);
+    auto src32 = reinterpret_cast<const uint32_t *>(src16);
+    size_t words = pixels / 2;
+    size_t i = 0;
+#if PIXEL_KERNELS_ENABLE_VECTOR
+    typedef uint32_t vec_t __attribute__((vector_size(16)));
+    for (; i + 4 <= words; i += 4) {
+        vec_t v;
+        memcpy(&v, src32 + i, sizeof(v));
+        v = ((v & 0x00FF00FFU) << 8) | ((v >> 8) & 0x00FF00FFU);
+        memcpy(dst32 + i, &v, sizeof(v));
+    }
+#endif
+    for (; i + 4 <= words; i += 4) {
+        uint32_t w0 = src32[i];
+        uint32_t w1 = src32[i + 1];
+        uint32_t w2 = src32[i + 2];
+        uint32_t w3 = src32[i + 3];
+        dst32[i] = swap_word(w0);
+        dst32[i + 1] = swap_word(w1);
+        dst32[i + 2] = swap_word(w2);
+        dst32[i + 3] = swap_word(w3);
+    }
+    for (; i < words; i++) {
+        dst32[i] = swap_word(src32[i]);
+    }
+
+    if (pixels & 0x1) {
+        auto last = reinterpret_cast<const uint16_t *>(src32 + words);
+        *reinterpret_cast<uint16_t *>(dst32 + words) = swap_pixel(*last);
+    }
+}
+
+void rgb565_to_rgb888(uint8_t *dst, const uint16_t *src, size_t pixels)
+{
+    size_t i = 0;
+    // Four pixels make three whole words
+    if ((reinterpret_cast<uintptr_t>(dst) & 0x3) == 0) {
+        auto dst32 = reinterpret_cast<uint32_t *>(dst);
+        for (; i + 4 <= pixels; i += 4) {
+            uint32_t p0 = rgb565_to_argb(src[i]) & 0xFFFFFF;
+            uint32_t p1 = rgb565_to_argb(src[i + 1]) & 0xFFFFFF;
+            uint32_t p2 = rgb565_to_argb(src[i + 2]) & 0xFFFFFF;
+            uint32_t p3 = rgb565_to_argb(src[i + 3]) & 0xFFFFFF;
+            *dst32++ = p0 | (p1 << 24);
+            *dst32++ = (p1 >> 8) | (p2 << 16);
+            *dst32++ = (p2 >> 16) | (p3 << 8);
+        }
+    }
+    for (; i < pixels; i++) {
+        uint32_t pixel = rgb565_to_argb(src[i]);
+        dst[i * 3] = pixel & 0xFF;
+        dst[i * 3 + 1] = (pixel >> 8) & 0xFF;
+        dst[i * 3 + 2] = (pixel >> 16) & 0xFF;
+    }
+}
+
+void rgb565_to_argb8888(uint32_t *dst, const uint16_t *src, size_t pixels)
+{
+    size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        dst[i] = rgb565_to_argb(src[i]);
+        dst[i + 1] = rgb565_to_argb(src[i + 1]);
+        dst[i + 2] = rgb565_to_argb(src[i + 2]);
+        dst[i + 3] = rgb565_to_argb(src[i + 3]);
+    }
+    for (; i < pixels; i++) {
+        dst[i] = rgb565_to_argb(src[i]);
+    }
+}
+
+void rgb888_to_rgb565(uint16_t *dst, const uint8_t *src, size_t pixels)
+{
+    size_t i = 0;
+    // Three whole words hold four pixels, and two output pixels are stored as one word
+    if (((reinterpret_cast<uintptr_t>(src) | reinterpret_cast<uintptr_t>(dst)) & 0x3) == 0) {
+        auto src32 = reinterpret_cast<const uint32_t *>(src);
+        auto dst32 = reinterpret_cast<uint32_t *>(dst);
+        for (; i + 4 <= pixels; i += 4) {
+            uint32_t w0 = *src32++;
+            uint32_t w1 = *src32++;
+            uint32_t w2 = *src32++;
+            uint32_t p0 = w0 & 0xFFFFFF;
+            uint32_t p1 = (w0 >> 24) | ((w1 & 0xFFFF) << 8);
+            uint32_t p2 = (w1 >> 16) | ((w2 & 0xFF) << 16);
+            uint32_t p3 = w2 >> 8;
+            uint32_t c0 = rgb_to_rgb565(p0 >> 16, (p0 >> 8) & 0xFF, p0 & 0xFF);
+            uint32_t c1 = rgb_to_rgb565(p1 >> 16, (p1 >> 8) & 0xFF, p1 & 0xFF);
+            uint32_t c2 = rgb_to_rgb565(p2 >> 16, (p2 >> 8) & 0xFF, p2 & 0xFF);
+            uint32_t c3 = rgb_to_rgb565(p3 >> 16, (p3 >> 8) & 0xFF, p3 & 0xFF);
+            *dst32++ = c0 | (c1 << 16);
+            *dst32++ = c2 | (c3 << 16);
+        }
+    }
+    for (; i < pixels; i++) {
+        dst[i] = rgb_to_rgb565(src[i * 3 + 2], src[i * 3 + 1], src[i * 3]);
+    }
+}
+
+void argb8888_to_rgb565(uint16_t *dst, const uint32_t *src, size_t pixels)
+{
+    size_t i = 0;
+    if ((reinterpret_cast<uintptr_t>(dst) & 0x3) == 0) {
+        auto dst32 = reinterpret_cast<uint32_t *>(dst);
+        for (; i + 2 <= pixels; i += 2) {
+            uint32_t p0 = src[i];
+            uint32_t p1 = src[i + 1];
+            uint32_t c0 = rgb_to_rgb565((p0 >> 16) & 0xFF, (p0 >> 8) & 0xFF, p0 & 0xFF);
+            uint32_t c1 = rgb_to_rgb565((p1 >> 16) & 0xFF, (p1 >> 8) & 0xFF, p1 & 0xFF);
+            *dst32++ = c0 | (c1 << 16);
+        }
+    }
+    for (; i < pixels; i++) {
+        uint32_t pixel = src[i];
+        dst[i] = rgb_to_rgb565((pixel >> 16) & 0xFF, (pixel >> 8) & 0xFF, pixel & 0xFF);
+    }
+}
+
+void fill16(uint16_t *dst, uint16_t value, size_t pixels)
+{
+    if ((reinterpret_cast<uintptr_t>(dst) & 0x3) && (pixels > 0)) {
+        *dst++ = value;
+        pixels--;
+    }
+
+    fill32(reinterpret_cast<uint32_t *>(dst), (static_cast<uint32_t>(value) << 16) | value, pixels / 2);
+    if (pixels & 0x1) {
+        dst[pixels - 1] = value;
+    }
+}
+
+void fill32(uint32_t *dst, uint32_t value, size_t pixels)
+{
+    size_t i = 0;
+#if PIXEL_KERNELS_ENABLE_VECTOR
+    typedef uint32_t vec_t __attribute__((vector_size(16)));
+    vec_t v = {value, value, value, value};
+    for (; i + 4 <= pixels; i += 4) {
+        memcpy(dst + i, &v, sizeof(v));
+    }
+#endif
+    for (; i + 4 <= pixels; i += 4) {
+        dst[i] = value;
+        dst[i + 1] = value;
+        dst[i + 2] = value;
+        dst[i + 3] = value;
+    }
+    for (; i < pixels; i++) {
+        dst[i] = value;
+    }
+}
+
+} // namespace esp_brookesia::gui::pixel
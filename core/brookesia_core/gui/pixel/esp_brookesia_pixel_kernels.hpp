@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Pixel kernels for the display path. Each one processes a word (or a vector, where available) at a time when
+ *        the buffers are aligned, and falls back to a per-pixel loop for the unaligned head and tail.
+ *
+ * The byte orders follow LVGL: RGB888 is stored as B, G, R and ARGB8888 as 0xAARRGGBB in a native `uint32_t`.
+ */
+namespace esp_brookesia::gui::pixel {
+
+/**
+ * @brief Swap the two bytes of each RGB565 pixel, `dst` may be the same as `src`
+ */
+void swap16(void *dst, const void *src, size_t pixels);
+
+void rgb565_to_rgb888(uint8_t *dst, const uint16_t *src, size_t pixels);
+void rgb565_to_argb8888(uint32_t *dst, const uint16_t *src, size_t pixels);
+void rgb888_to_rgb565(uint16_t *dst, const uint8_t *src, size_t pixels);
+void argb8888_to_rgb565(uint16_t *dst, const uint32_t *src, size_t pixels);
+
+void fill16(uint16_t *dst, uint16_t value, size_t pixels);
+void fill32(uint32_t *dst, uint32_t value, size_t pixels);
+
+} // namespace esp_brookesia::gui::pixel
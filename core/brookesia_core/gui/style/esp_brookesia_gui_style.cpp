@@ -9,131 +9,43 @@
 
 namespace esp_brookesia::gui {
 
-bool StyleSize::calibrate(const StyleSize &parent)
+static bool check_calibrate_result(const StyleSize &size, StyleSize::CalibrateResult result)
 {
-    int parent_w = 0;
-    int parent_h = 0;
-
-    parent_w = parent.width;
-    parent_h = parent.height;
-
-    // Check width
-    if (flags.enable_width_auto) {
-        width = StyleSize::LENGTH_AUTO;
-    } else if (flags.enable_width_percent) {
-        ESP_UTILS_CHECK_VALUE_RETURN(width_percent, 1, 100, false, "Invalid width percent");
-        width = (parent_w != StyleSize::LENGTH_AUTO) ? (parent_w * width_percent) / 100 : StyleSize::LENGTH_AUTO;
-    } else if (width != StyleSize::LENGTH_AUTO) {
-        ESP_UTILS_CHECK_VALUE_RETURN(width, 1, parent_w, false, "Invalid width");
-    }
-
-    // Check height
-    if (flags.enable_height_auto) {
-        height = StyleSize::LENGTH_AUTO;
-    } else if (flags.enable_height_percent) {
-        ESP_UTILS_CHECK_VALUE_RETURN(height_percent, 1, 100, false, "Invalid Height percent");
-        height = (parent_h != StyleSize::LENGTH_AUTO) ? (parent_h * height_percent) / 100 : StyleSize::LENGTH_AUTO;
-    } else {
-        ESP_UTILS_CHECK_VALUE_RETURN(height, 1, parent_h, false, "Invalid Height");
+    switch (result) {
+    case StyleSize::CalibrateResult::OK:
+        return true;
+    case StyleSize::CalibrateResult::INVALID_WIDTH_PERCENT:
+        ESP_UTILS_LOGE("Invalid width percent(%d)", size.width_percent);
+        break;
+    case StyleSize::CalibrateResult::INVALID_WIDTH:
+        ESP_UTILS_LOGE("Invalid width(%d)", size.width);
+        break;
+    case StyleSize::CalibrateResult::INVALID_HEIGHT_PERCENT:
+        ESP_UTILS_LOGE("Invalid Height percent(%d)", size.height_percent);
+        break;
+    case StyleSize::CalibrateResult::INVALID_HEIGHT:
+        ESP_UTILS_LOGE("Invalid Height(%d)", size.height);
+        break;
+    default:
+        break;
     }
 
-    // Process special size
-    if (flags.enable_square || flags.enable_circle) {
-        width = std::min(width, height);
-        height = width;
-    }
-
-    // Process circle
-    if (flags.enable_circle) {
-        radius = StyleSize::RADIUS_CIRCLE;
-    }
+    return false;
+}
 
-    return true;
+bool StyleSize::calibrate(const StyleSize &parent)
+{
+    return check_calibrate_result(*this, tryCalibrate(parent));
 }
 
 bool StyleSize::calibrate(const StyleSize &parent, bool check_width, bool check_height)
 {
-    int parent_w = 0;
-    int parent_h = 0;
-
-    parent_w = parent.width;
-    parent_h = parent.height;
-
-    // Check width
-    if (flags.enable_width_auto) {
-        width = StyleSize::LENGTH_AUTO;
-    } else if (flags.enable_width_percent) {
-        ESP_UTILS_CHECK_VALUE_RETURN(width_percent, 1, 100, false, "Invalid width percent");
-        width = (parent_w * width_percent) / 100;
-    } else if (check_width) {
-        ESP_UTILS_CHECK_VALUE_RETURN(width, 1, parent_w, false, "Invalid width");
-    }
-
-    // Check height
-    if (flags.enable_height_auto) {
-        height = StyleSize::LENGTH_AUTO;
-    } else if (flags.enable_height_percent) {
-        ESP_UTILS_CHECK_VALUE_RETURN(height_percent, 1, 100, false, "Invalid Height percent");
-        height = (parent_h * height_percent) / 100;
-    } else if (check_height) {
-        ESP_UTILS_CHECK_VALUE_RETURN(height, 1, parent_h, false, "Invalid Height");
-    }
-
-    // Process special size
-    if (flags.enable_square || flags.enable_circle) {
-        width = std::min(width, height);
-        height = width;
-    }
-
-    // Process circle
-    if (flags.enable_circle) {
-        radius = StyleSize::RADIUS_CIRCLE;
-    }
-
-    return true;
+    return check_calibrate_result(*this, tryCalibrate(parent, check_width, check_height));
 }
 
 bool StyleSize::calibrate(const StyleSize &parent, bool allow_zero)
 {
-    int parent_w = 0;
-    int parent_h = 0;
-    int min_size = allow_zero ? 0 : 1;
-
-    parent_w = parent.width;
-    parent_h = parent.height;
-
-    // Check width
-    if (flags.enable_width_auto) {
-        width = StyleSize::LENGTH_AUTO;
-    } else if (flags.enable_width_percent) {
-        ESP_UTILS_CHECK_VALUE_RETURN(width_percent, min_size, 100, false, "Invalid width percent");
-        width = (parent_w * width_percent) / 100;
-    } else {
-        ESP_UTILS_CHECK_VALUE_RETURN(width, min_size, parent_w, false, "Invalid width");
-    }
-
-    // Check height
-    if (flags.enable_height_auto) {
-        height = StyleSize::LENGTH_AUTO;
-    } else if (flags.enable_height_percent) {
-        ESP_UTILS_CHECK_VALUE_RETURN(height_percent, min_size, 100, false, "Invalid Height percent");
-        height = (parent_h * height_percent) / 100;
-    } else {
-        ESP_UTILS_CHECK_VALUE_RETURN(height, min_size, parent_h, false, "Invalid Height");
-    }
-
-    // Process special size
-    if (flags.enable_square || flags.enable_circle) {
-        width = std::min(width, height);
-        height = width;
-    }
-
-    // Process circle
-    if (flags.enable_circle) {
-        radius = StyleSize::RADIUS_CIRCLE;
-    }
-
-    return true;
+    return check_calibrate_result(*this, tryCalibrate(parent, allow_zero));
 }
 
 bool StyleFont::calibrate(
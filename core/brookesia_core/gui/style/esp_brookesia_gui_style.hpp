@@ -5,6 +5,7 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <stdint.h>
@@ -157,6 +158,104 @@ struct StyleSize {
         };
     }
 
+    enum class CalibrateResult {
+        OK = 0,
+        INVALID_WIDTH_PERCENT,
+        INVALID_WIDTH,
+        INVALID_HEIGHT_PERCENT,
+        INVALID_HEIGHT,
+    };
+
+    struct CalibrateOptions {
+        int min_size;           /*!< Minimum of the width/height in pixels and of the percentages */
+        bool check_width;       /*!< If set, a width in pixels must be within [`min_size`, parent width] */
+        bool check_height;      /*!< If set, a height in pixels must be within [`min_size`, parent height] */
+        bool keep_parent_auto;  /*!< If set, a percentage of an auto parent length stays `LENGTH_AUTO` */
+    };
+
+    /**
+    * @brief Calibrate the size against the parent size without logging, so it can also be used in constant
+    *        expressions, e.g. to resolve the sizes of a stylesheet for a known resolution at build time.
+    *
+    * @param parent The parent size
+    * @param options The calibration options
+    *
+    * @return `CalibrateResult::OK` if success, otherwise the first invalid item. The size is only partially
+    *         calibrated on failure.
+    */
+    constexpr CalibrateResult tryCalibrate(const StyleSize &parent, const CalibrateOptions &options)
+    {
+        // Check width
+        if (flags.enable_width_auto) {
+            width = LENGTH_AUTO;
+        } else if (flags.enable_width_percent) {
+            if ((width_percent < options.min_size) || (width_percent > 100)) {
+                return CalibrateResult::INVALID_WIDTH_PERCENT;
+            }
+            width = (options.keep_parent_auto && (parent.width == LENGTH_AUTO)) ? LENGTH_AUTO :
+                    (parent.width * width_percent) / 100;
+        } else if (options.check_width && ((width < options.min_size) || (width > parent.width))) {
+            return CalibrateResult::INVALID_WIDTH;
+        }
+
+        // Check height
+        if (flags.enable_height_auto) {
+            height = LENGTH_AUTO;
+        } else if (flags.enable_height_percent) {
+            if ((height_percent < options.min_size) || (height_percent > 100)) {
+                return CalibrateResult::INVALID_HEIGHT_PERCENT;
+            }
+            height = (options.keep_parent_auto && (parent.height == LENGTH_AUTO)) ? LENGTH_AUTO :
+                     (parent.height * height_percent) / 100;
+        } else if (options.check_height && ((height < options.min_size) || (height > parent.height))) {
+            return CalibrateResult::INVALID_HEIGHT;
+        }
+
+        // Process special size
+        if (flags.enable_square || flags.enable_circle) {
+            width = std::min(width, height);
+            height = width;
+        }
+
+        // Process circle
+        if (flags.enable_circle) {
+            radius = RADIUS_CIRCLE;
+        }
+
+        return CalibrateResult::OK;
+    }
+
+    /**
+    * @brief Constexpr counterparts of the `calibrate()` overloads below, which use the same options
+    */
+    constexpr CalibrateResult tryCalibrate(const StyleSize &parent)
+    {
+        return tryCalibrate(parent, {
+            .min_size = 1,
+            .check_width = (width != LENGTH_AUTO),
+            .check_height = true,
+            .keep_parent_auto = true,
+        });
+    }
+    constexpr CalibrateResult tryCalibrate(const StyleSize &parent, bool check_width, bool check_height)
+    {
+        return tryCalibrate(parent, {
+            .min_size = 1,
+            .check_width = check_width,
+            .check_height = check_height,
+            .keep_parent_auto = false,
+        });
+    }
+    constexpr CalibrateResult tryCalibrate(const StyleSize &parent, bool allow_zero)
+    {
+        return tryCalibrate(parent, {
+            .min_size = allow_zero ? 0 : 1,
+            .check_width = true,
+            .check_height = true,
+            .keep_parent_auto = false,
+        });
+    }
+
     bool calibrate(const StyleSize &parent);
     bool calibrate(const StyleSize &parent, bool check_width, bool check_height);
     bool calibrate(const StyleSize &parent, bool allow_zero);
@@ -166,7 +265,7 @@ struct StyleSize {
     int radius;                        /*!< Radius in pixels */
     int width_percent;                  /*!< Percentage of the parent width */
     int height_percent;                 /*!< Percentage of the parent height */
-    struct {
+    struct Flags {
         int enable_width_percent: 1;    /*!< If set, the `width` will be calculated based on `width_percent` */
         int enable_width_auto: 1;       /*!< If set, the `width` will be ignored */
         int enable_height_percent: 1;   /*!< If set, the `height` will be calculated based on `height_percent` */
@@ -175,7 +274,9 @@ struct StyleSize {
         int enable_circle: 1;           /*!< If set, `width` and `height` will be equal, taking the smaller value,
                                               *  and `radius` will be set to `LV_RADIUS_CIRCLE`
                                               */
+        bool operator==(const Flags &) const = default;
     } flags;                                /*!< Style size flags */
+    bool operator==(const StyleSize &) const = default;
 };
 
 /**
@@ -259,10 +360,12 @@ struct StyleFont {
     int height;                         /*!< Font height in pixels */
     int height_percent;                 /*!< Font height as a percentage of the parent height */
     const void *font_resource;              /*!< Custom font resource */
-    struct {
+    struct Flags {
         int enable_height: 1;           /*!< If set, the `size` will be calculated based on `height` */
         int enable_height_percent: 1;   /*!< If set, the `size` will be calculated based on `height_percent` */
+        bool operator==(const Flags &) const = default;
     } flags;                                /*!< Style font flags */
+    bool operator==(const StyleFont &) const = default;
 };
 
 enum StyleFontType {
@@ -315,6 +418,7 @@ struct StyleColor {
 
     uint32_t color:  24;                    /*!< Color in 24-bit RGB format (R[7:0], G[7:0], B[7:0]) */
     uint32_t opacity: 8;                    /*!< Opacity value (0-255, where 0 is transparent and 255 is opaque) */
+    bool operator==(const StyleColor &) const = default;
 };
 
 /**
@@ -389,10 +493,12 @@ struct StyleImage {
     const void *resource;                   /*!< Pointer to the image resource */
     StyleColor recolor;                     /*!< Color to recolor the image */
     StyleColor container_color;             /*!< Color of the container */
-    struct {
+    struct Flags {
         int enable_recolor: 1;          /*!< Flag to enable image recoloring */
         int enable_container_color: 1;  /*!< Flag to enable container color */
+        bool operator==(const Flags &) const = default;
     } flags;                                /*!< Style image flags */
+    bool operator==(const StyleImage &) const = default;
 };
 
 /**
@@ -417,6 +523,7 @@ struct StyleAlign {
     StyleAlignType type;                    /*!< Alignment type */
     int offset_x;                           /*!< Horizontal offset in pixels */
     int offset_y;                           /*!< Vertical offset in pixels */
+    bool operator==(const StyleAlign &) const = default;
 };
 
 /**
@@ -471,6 +578,7 @@ struct StyleGap {
     int right;                              /*!< Gap at the right in pixels */
     int row;                                /*!< Gap between rows in pixels */
     int column;                             /*!< Gap between columns in pixels */
+    bool operator==(const StyleGap &) const = default;
 };
 
 /**
@@ -507,6 +615,7 @@ struct StyleLayoutFlex {
     AlignType main_place;              /*!< Alignment along the main axis */
     AlignType cross_place;             /*!< Alignment along the cross axis */
     AlignType track_place;             /*!< Alignment of tracks (for multi-line layouts) */
+    bool operator==(const StyleLayoutFlex &) const = default;
 };
 
 struct StyleAnimation {
@@ -529,6 +638,7 @@ struct StyleAnimation {
     int duration_ms;
     int delay_ms;
     AnimationPathType path_type;
+    bool operator==(const StyleAnimation &) const = default;
 };
 
 enum StyleFlag {
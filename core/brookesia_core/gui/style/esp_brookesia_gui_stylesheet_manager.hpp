@@ -21,7 +21,7 @@
 namespace esp_brookesia::gui {
 
 template <typename T>
-using NameStylesheetMap = std::unordered_map<std::string, std::shared_ptr<T>>;
+using NameStylesheetMap = std::unordered_map<std::string, std::shared_ptr<const T>>;
 
 template <typename T>
 using ResolutionNameStylesheetMap = std::map<uint32_t, NameStylesheetMap<T>>;
@@ -36,6 +36,19 @@ public:
     virtual bool calibrateScreenSize(StyleSize &size) = 0;
 
     bool addStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet);
+    /**
+     * @brief Add a stylesheet which was calibrated at build time for the screen size. Its sizes are not calibrated
+     *        again, only `calibrateStylesheetResource()` is called to resolve the resources which only exist at
+     *        runtime. Activating it by name is then a swap of the shared handle.
+     *
+     * @param name The name of the stylesheet
+     * @param screen_size The screen size of the stylesheet
+     * @param stylesheet The calibrated stylesheet
+     *
+     * @return `true` if success, otherwise `false`
+     *
+     */
+    bool addCalibratedStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet);
     bool activateStylesheet(const StyleSize &screen_size, const T &stylesheet);
     bool activateStylesheet(const char *name, const StyleSize &screen_size);
 
@@ -72,15 +85,54 @@ public:
      */
     const T *getStylesheet(const StyleSize &screen_size);
 
+    /**
+     * @brief Get the shared handle of the stylesheet which the active stylesheet was copied from. The handle is
+     *        immutable and stays valid after another stylesheet is activated, so it can be compared with the
+     *        active stylesheet to find out what a switch changed.
+     *
+     * @return stylesheet handle, or `nullptr` if no stylesheet is activated
+     *
+     */
+    std::shared_ptr<const T> getStylesheetHandle(void) const { return _active_stylesheet_handle; }
+
 protected:
     T _active_stylesheet;
 
     virtual bool calibrateStylesheet(const StyleSize &screen_size, T &stylesheet) = 0;
+    /**
+     * @brief Resolve the resources of a stylesheet calibrated at build time, e.g. fonts and images. Its sizes are
+     *        already calibrated and must not be calibrated again.
+     *
+     * @param screen_size The calibrated screen size
+     * @param stylesheet The stylesheet added by `addCalibratedStylesheet()`
+     *
+     * @return `true` if success, otherwise `false`
+     *
+     */
+    virtual bool calibrateStylesheetResource(const StyleSize &screen_size, T &stylesheet)
+    {
+        return true;
+    }
+    /**
+     * @brief Copy the stylesheet being activated into the active stylesheet. Override it to only copy the parts
+     *        which differ from the active stylesheet, as the widgets reference it.
+     *
+     * @param stylesheet The stylesheet being activated
+     *
+     */
+    virtual void updateActiveStylesheet(const T &stylesheet)
+    {
+        _active_stylesheet = stylesheet;
+    }
 
     bool del(void);
 
 private:
+    bool addStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet, bool is_calibrated);
+    void setActiveStylesheet(std::shared_ptr<const T> stylesheet);
+
     ResolutionNameStylesheetMap<T> _resolution_name_stylesheet_map;
+    std::shared_ptr<const T> _active_stylesheet_handle;
 
     uint32_t getResolution(const StyleSize &screen_size)
     {
@@ -106,6 +158,20 @@ StylesheetManager<T>::~StylesheetManager()
 
 template <typename T>
 bool StylesheetManager<T>::addStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet)
+{
+    return addStylesheet(name, screen_size, stylesheet, false);
+}
+
+template <typename T>
+bool StylesheetManager<T>::addCalibratedStylesheet(const char *name, const StyleSize &screen_size, const T &stylesheet)
+{
+    return addStylesheet(name, screen_size, stylesheet, true);
+}
+
+template <typename T>
+bool StylesheetManager<T>::addStylesheet(
+    const char *name, const StyleSize &screen_size, const T &stylesheet, bool is_calibrated
+)
 {
     uint32_t resolution = 0;
     StyleSize calibrate_size = screen_size;
@@ -124,7 +190,8 @@ bool StylesheetManager<T>::addStylesheet(const char *name, const StyleSize &scre
     }
 
     // ESP_UTILS_CHECK_FALSE_RETURN(calibrateStylesheet(calibrate_size, *calibration_stylesheet), false, "Invalid stylesheet");
-    if (!calibrateStylesheet(calibrate_size, *calibration_stylesheet)) {
+    if (is_calibrated ? !calibrateStylesheetResource(calibrate_size, *calibration_stylesheet) :
+            !calibrateStylesheet(calibrate_size, *calibration_stylesheet)) {
         return false;
     }
 
@@ -173,7 +240,7 @@ bool StylesheetManager<T>::activateStylesheet(const StyleSize &screen_size,
         return false;
     }
 
-    _active_stylesheet = *calibration_stylesheet;
+    setActiveStylesheet(calibration_stylesheet);
 
     return true;
 }
@@ -182,7 +249,6 @@ template <typename T>
 bool StylesheetManager<T>::activateStylesheet(const char *name, const StyleSize &screen_size)
 {
     StyleSize calibrate_size = screen_size;
-    const T *stylesheet = nullptr;
 
     // ESP_UTILS_CHECK_NULL_RETURN(name, false, "Invalid name");
     if (name == nullptr) {
@@ -195,13 +261,17 @@ bool StylesheetManager<T>::activateStylesheet(const char *name, const StyleSize
     }
     // ESP_UTILS_LOGD("Activate stylesheet(%s - %dx%d)", name, calibrate_size.width, calibrate_size.height);
 
-    stylesheet = getStylesheet(name, screen_size);
-    // ESP_UTILS_CHECK_NULL_RETURN(stylesheet, false, "Get stylesheet failed");
-    if (stylesheet == nullptr) {
+    auto it_resolution_map = _resolution_name_stylesheet_map.find(getResolution(calibrate_size));
+    if (it_resolution_map == _resolution_name_stylesheet_map.end()) {
+        return false;
+    }
+    auto it_name_map = it_resolution_map->second.find(name);
+    // ESP_UTILS_CHECK_FALSE_RETURN(it_name_map != it_resolution_map->second.end(), false, "Get stylesheet failed");
+    if (it_name_map == it_resolution_map->second.end()) {
         return false;
     }
 
-    _active_stylesheet = *stylesheet;
+    setActiveStylesheet(it_name_map->second);
 
     return true;
 }
@@ -299,7 +369,7 @@ const T *StylesheetManager<T>::getStylesheet(const StyleSize &screen_size)
         return nullptr;
     }
 
-    auto name_map = it_resolution_map->second;
+    auto &name_map = it_resolution_map->second;
     if (name_map.empty()) {
         return nullptr;
     }
@@ -312,10 +382,23 @@ bool StylesheetManager<T>::del(void)
 {
     _active_stylesheet = {};
     _resolution_name_stylesheet_map.clear();
+    _active_stylesheet_handle = nullptr;
 
     return true;
 }
 
+template <typename T>
+void StylesheetManager<T>::setActiveStylesheet(std::shared_ptr<const T> stylesheet)
+{
+    // The widgets reference the active stylesheet, so it is only updated when the handle changes
+    if (stylesheet == _active_stylesheet_handle) {
+        return;
+    }
+
+    updateActiveStylesheet(*stylesheet);
+    _active_stylesheet_handle = std::move(stylesheet);
+}
+
 } // namespace esp_brookesia::gui
 
 template <typename T>
@@ -0,0 +1,197 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "pixel/esp_brookesia_pixel_kernels.hpp"
+
+using namespace esp_brookesia::gui;
+using Clock = std::chrono::steady_clock;
+
+#define BENCH_ROUNDS                (50)
+#define BENCH_FILL_COLOR16          (0x1234)
+#define BENCH_FILL_COLOR32          (0xFF123456U)
+
+struct BenchResolution {
+    int width;
+    int height;
+};
+
+// The square screens of the speaker and the largest phone screen
+static const BenchResolution BENCH_RESOLUTIONS[] = {
+    {360, 360},
+    {800, 1280},
+};
+
+/**
+ * Per-pixel references, written like the loops of the underlying libraries
+ */
+__attribute__((noinline)) static void ref_swap16(uint16_t *dst, const uint16_t *src, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        dst[i] = static_cast<uint16_t>((src[i] << 8) | (src[i] >> 8));
+    }
+}
+
+__attribute__((noinline)) static void ref_rgb565_to_rgb888(uint8_t *dst, const uint16_t *src, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        uint32_t r = (src[i] >> 11) & 0x1F;
+        uint32_t g = (src[i] >> 5) & 0x3F;
+        uint32_t b = src[i] & 0x1F;
+        dst[i * 3] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        dst[i * 3 + 1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+        dst[i * 3 + 2] = static_cast<uint8_t>((r << 3) | (r >> 2));
+    }
+}
+
+__attribute__((noinline)) static void ref_rgb565_to_argb8888(uint32_t *dst, const uint16_t *src, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        uint32_t r = (src[i] >> 11) & 0x1F;
+        uint32_t g = (src[i] >> 5) & 0x3F;
+        uint32_t b = src[i] & 0x1F;
+        dst[i] = 0xFF000000U | (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+    }
+}
+
+__attribute__((noinline)) static void ref_rgb888_to_rgb565(uint16_t *dst, const uint8_t *src, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        uint32_t r = src[i * 3 + 2];
+        uint32_t g = src[i * 3 + 1];
+        uint32_t b = src[i * 3];
+        dst[i] = static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+    }
+}
+
+__attribute__((noinline)) static void ref_argb8888_to_rgb565(uint16_t *dst, const uint32_t *src, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        uint32_t r = (src[i] >> 16) & 0xFF;
+        uint32_t g = (src[i] >> 8) & 0xFF;
+        uint32_t b = src[i] & 0xFF;
+        dst[i] = static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+    }
+}
+
+__attribute__((noinline)) static void ref_fill16(uint16_t *dst, uint16_t value, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        dst[i] = value;
+    }
+}
+
+__attribute__((noinline)) static void ref_fill32(uint32_t *dst, uint32_t value, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        dst[i] = value;
+    }
+}
+
+static double measure_us(const std::function<void()> &kernel)
+{
+    // Warm up the caches and the buffers
+    kernel();
+
+    auto start = Clock::now();
+    for (int i = 0; i < BENCH_ROUNDS; i++) {
+        kernel();
+    }
+
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / BENCH_ROUNDS;
+}
+
+static bool bench_kernel(
+    const char *name, const std::function<void()> &kernel, const std::function<void()> &reference,
+    const void *result, const void *expected, size_t size
+)
+{
+    double kernel_us = measure_us(kernel);
+    double reference_us = measure_us(reference);
+    bool is_equal = (memcmp(result, expected, size) == 0);
+
+    printf(
+        "\t%-20s kernel(%8.1f us), per-pixel(%8.1f us), speedup(%.2fx)%s\n", name, kernel_us, reference_us,
+        reference_us / kernel_us, is_equal ? "" : ", MISMATCH"
+    );
+
+    return is_equal;
+}
+
+static bool bench_resolution(const BenchResolution &resolution)
+{
+    size_t pixels = static_cast<size_t>(resolution.width) * resolution.height;
+    std::vector<uint16_t> src16(pixels);
+    std::vector<uint8_t> src24(pixels * 3);
+    std::vector<uint32_t> src32(pixels);
+    for (size_t i = 0; i < pixels; i++) {
+        src16[i] = static_cast<uint16_t>(i * 2654435761U >> 16);
+        src32[i] = static_cast<uint32_t>(i * 2654435761U);
+    }
+    for (size_t i = 0; i < src24.size(); i++) {
+        src24[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    std::vector<uint16_t> dst16(pixels);
+    std::vector<uint16_t> ref16(pixels);
+    std::vector<uint8_t> dst24(pixels * 3);
+    std::vector<uint8_t> ref24(pixels * 3);
+    std::vector<uint32_t> dst32(pixels);
+    std::vector<uint32_t> ref32(pixels);
+
+    printf(
+        "%dx%d (%d pixels), %d rounds\n", resolution.width, resolution.height, static_cast<int>(pixels), BENCH_ROUNDS
+    );
+    bool is_ok = true;
+    is_ok &= bench_kernel("swap16", [&]() {
+        pixel::swap16(dst16.data(), src16.data(), pixels);
+    }, [&]() {
+        ref_swap16(ref16.data(), src16.data(), pixels);
+    }, dst16.data(), ref16.data(), pixels * sizeof(uint16_t));
+    is_ok &= bench_kernel("rgb565_to_rgb888", [&]() {
+        pixel::rgb565_to_rgb888(dst24.data(), src16.data(), pixels);
+    }, [&]() {
+        ref_rgb565_to_rgb888(ref24.data(), src16.data(), pixels);
+    }, dst24.data(), ref24.data(), pixels * 3);
+    is_ok &= bench_kernel("rgb565_to_argb8888", [&]() {
+        pixel::rgb565_to_argb8888(dst32.data(), src16.data(), pixels);
+    }, [&]() {
+        ref_rgb565_to_argb8888(ref32.data(), src16.data(), pixels);
+    }, dst32.data(), ref32.data(), pixels * sizeof(uint32_t));
+    is_ok &= bench_kernel("rgb888_to_rgb565", [&]() {
+        pixel::rgb888_to_rgb565(dst16.data(), src24.data(), pixels);
+    }, [&]() {
+        ref_rgb888_to_rgb565(ref16.data(), src24.data(), pixels);
+    }, dst16.data(), ref16.data(), pixels * sizeof(uint16_t));
+    is_ok &= bench_kernel("argb8888_to_rgb565", [&]() {
+        pixel::argb8888_to_rgb565(dst16.data(), src32.data(), pixels);
+    }, [&]() {
+        ref_argb8888_to_rgb565(ref16.data(), src32.data(), pixels);
+    }, dst16.data(), ref16.data(), pixels * sizeof(uint16_t));
+    is_ok &= bench_kernel("fill16", [&]() {
+        pixel::fill16(dst16.data(), BENCH_FILL_COLOR16, pixels);
+    }, [&]() {
+        ref_fill16(ref16.data(), BENCH_FILL_COLOR16, pixels);
+    }, dst16.data(), ref16.data(), pixels * sizeof(uint16_t));
+    is_ok &= bench_kernel("fill32", [&]() {
+        pixel::fill32(dst32.data(), BENCH_FILL_COLOR32, pixels);
+    }, [&]() {
+        ref_fill32(ref32.data(), BENCH_FILL_COLOR32, pixels);
+    }, dst32.data(), ref32.data(), pixels * sizeof(uint32_t));
+
+    return is_ok;
+}
+
+extern "C" void app_main(void)
+{
+    bool is_ok = true;
+    for (auto &resolution : BENCH_RESOLUTIONS) {
+        is_ok &= bench_resolution(resolution);
+    }
+    printf("%s\n", is_ok ? "Benchmark finished" : "Benchmark failed");
+}
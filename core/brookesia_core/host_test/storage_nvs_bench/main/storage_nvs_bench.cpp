@@ -0,0 +1,227 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "storage_nvs/esp_brookesia_service_storage_nvs.hpp"
+#include "storage_nvs/esp_brookesia_service_storage_nvs_file_backend.hpp"
+
+using namespace esp_brookesia::services;
+using Clock = std::chrono::steady_clock;
+
+#define BENCH_FILE_PATH             "storage_nvs_bench.bin"
+// Typical timings of an ESP32-S3 writing to SPI flash
+#define BENCH_ENTRY_WRITE_US        (40)
+#define BENCH_PAGE_ERASE_US         (20000)
+#define BENCH_COMMIT_US             (0)
+
+#define BENCH_KEY_NUM               (32)
+#define BENCH_SET_ROUNDS            (20)
+#define BENCH_GET_TIMES             (200000)
+#define BENCH_MIXED_DURATION_MS     (3000)
+#define BENCH_MIXED_READERS         (4)
+#define BENCH_MIXED_WRITERS         (2)
+#define BENCH_MIXED_WRITE_INTERVAL_MS   (2)
+#define BENCH_WAIT_TIMEOUT_MS       (10000)
+
+static std::string get_key(int index)
+{
+    return "key_" + std::to_string(index);
+}
+
+static double get_elapsed_ms(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool wait_future(StorageNVS::EventFuture &future)
+{
+    return (future.wait_for(std::chrono::milliseconds(BENCH_WAIT_TIMEOUT_MS)) == std::future_status::ready) &&
+           future.get();
+}
+
+static void print_stats(const char *phase, StorageNVS &storage, StorageNVSFileBackend &backend)
+{
+    auto stats = storage.getStats();
+    auto backend_stats = backend.getStats();
+    double latency_avg_us = (stats.events > 0) ? (static_cast<double>(stats.queue_latency_us_total) / stats.events) : 0;
+
+    printf(
+        "[%s]\n"
+        "\tservice: update_requests(%" PRIu32 "), flash_writes(%" PRIu32 "), commits(%" PRIu32 ")\n"
+        "\tqueue: events(%" PRIu32 "), latency_avg(%.1f us), latency_max(%" PRIu32 " us)\n"
+        "\tbackend: sets(%" PRIu32 "), gets(%" PRIu32 "), erases(%" PRIu32 "), commits(%" PRIu32 "), "
+        "entry_writes(%" PRIu32 "), page_erases(%" PRIu32 "), bytes(%" PRIu64 "), simulated(%.1f ms)\n",
+        phase, stats.update_requests, stats.flash_writes, stats.commits, stats.events, latency_avg_us,
+        stats.queue_latency_us_max, backend_stats.sets, backend_stats.gets, backend_stats.erases,
+        backend_stats.commits, backend_stats.entry_writes, backend_stats.page_erases, backend_stats.bytes_written,
+        backend_stats.simulated_us / 1000.0
+    );
+
+    storage.resetStats();
+    backend.resetStats();
+}
+
+static bool bench_set(StorageNVS &storage, StorageNVSFileBackend &backend)
+{
+    auto start = Clock::now();
+    for (int round = 0; round < BENCH_SET_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_KEY_NUM; i++) {
+            // Mix the value types the settings usually store
+            StorageNVS::Value value = round;
+            if (i % 4 == 1) {
+                value = "value_" + std::to_string(round);
+            } else if (i % 4 == 2) {
+                value = (round % 2) == 0;
+            } else if (i % 4 == 3) {
+                value = round * 0.5f;
+            }
+            if (!storage.setLocalParam(get_key(i), value)) {
+                return false;
+            }
+        }
+    }
+    double set_ms = get_elapsed_ms(start);
+
+    StorageNVS::EventFuture future;
+    if (!storage.flush(nullptr, &future) || !wait_future(future)) {
+        return false;
+    }
+    double total_ms = get_elapsed_ms(start);
+
+    int sets = BENCH_KEY_NUM * BENCH_SET_ROUNDS;
+    printf(
+        "set: %d sets in %.1f ms (%.0f sets/s), persisted in %.1f ms\n", sets, set_ms, sets * 1000 / set_ms, total_ms
+    );
+    print_stats("set", storage, backend);
+
+    return true;
+}
+
+static bool bench_get(StorageNVS &storage, StorageNVSFileBackend &backend)
+{
+    StorageNVS::Value value;
+    auto start = Clock::now();
+    for (int i = 0; i < BENCH_GET_TIMES; i++) {
+        if (!storage.getLocalParam(get_key(i % BENCH_KEY_NUM), value)) {
+            return false;
+        }
+    }
+    double get_ms = get_elapsed_ms(start);
+
+    printf("get: %d gets in %.1f ms (%.0f gets/s)\n", BENCH_GET_TIMES, get_ms, BENCH_GET_TIMES * 1000 / get_ms);
+    print_stats("get", storage, backend);
+
+    return true;
+}
+
+static bool bench_erase(StorageNVS &storage, StorageNVSFileBackend &backend)
+{
+    StorageNVS::EventFuture future;
+    auto start = Clock::now();
+    if (!storage.eraseNVS(nullptr, &future) || !wait_future(future)) {
+        return false;
+    }
+    double erase_ms = get_elapsed_ms(start);
+
+    printf("erase: %d keys in %.1f ms\n", BENCH_KEY_NUM, erase_ms);
+    print_stats("erase", storage, backend);
+
+    return true;
+}
+
+static bool bench_mixed(StorageNVS &storage, StorageNVSFileBackend &backend)
+{
+    std::atomic<bool> is_running = true;
+    std::atomic<bool> is_failed = false;
+    std::atomic<uint64_t> reads = 0;
+    std::atomic<uint64_t> writes = 0;
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < BENCH_MIXED_READERS; i++) {
+        threads.emplace_back([&, i]() {
+            StorageNVS::Value value;
+            uint64_t count = 0;
+            while (is_running) {
+                if (!storage.getLocalParam(get_key((i + count) % BENCH_KEY_NUM), value)) {
+                    is_failed = true;
+                    break;
+                }
+                count++;
+            }
+            reads += count;
+        });
+    }
+    // Writers behave like UI sliders, updating a few keys in bursts
+    for (int i = 0; i < BENCH_MIXED_WRITERS; i++) {
+        threads.emplace_back([&, i]() {
+            uint64_t count = 0;
+            while (is_running) {
+                if (!storage.setLocalParam(get_key((i * 7 + count) % 4), static_cast<int>(count))) {
+                    is_failed = true;
+                    break;
+                }
+                count++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(BENCH_MIXED_WRITE_INTERVAL_MS));
+            }
+            writes += count;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(BENCH_MIXED_DURATION_MS));
+    is_running = false;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    StorageNVS::EventFuture future;
+    if (is_failed || !storage.flush(nullptr, &future) || !wait_future(future)) {
+        return false;
+    }
+
+    printf(
+        "mixed: %d readers, %d writers for %d ms: %.0f reads/s, %.0f writes/s\n", BENCH_MIXED_READERS,
+        BENCH_MIXED_WRITERS, BENCH_MIXED_DURATION_MS, reads * 1000.0 / BENCH_MIXED_DURATION_MS,
+        writes * 1000.0 / BENCH_MIXED_DURATION_MS
+    );
+    print_stats("mixed", storage, backend);
+
+    return true;
+}
+
+extern "C" void app_main(void)
+{
+    remove(BENCH_FILE_PATH);
+
+    auto backend = std::make_shared<StorageNVSFileBackend>(StorageNVSFileBackend::Config{
+        .path = BENCH_FILE_PATH,
+        .entry_write_us = BENCH_ENTRY_WRITE_US,
+        .page_erase_us = BENCH_PAGE_ERASE_US,
+        .commit_us = BENCH_COMMIT_US,
+    });
+    auto &storage = StorageNVS::requestInstance();
+    if (!storage.setBackend(backend) || !storage.begin()) {
+        printf("Begin storage failed\n");
+        return;
+    }
+    storage.resetStats();
+    backend->resetStats();
+
+    printf(
+        "write-back: debounce(%d ms), max_latency(%d ms)\n", ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_DEBOUNCE_MS,
+        ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_MAX_LATENCY_MS
+    );
+    bool is_ok = bench_set(storage, *backend) && bench_get(storage, *backend) &&
+                 bench_mixed(storage, *backend) && bench_erase(storage, *backend);
+    printf("%s\n", is_ok ? "Benchmark finished" : "Benchmark failed");
+
+    storage.del();
+}
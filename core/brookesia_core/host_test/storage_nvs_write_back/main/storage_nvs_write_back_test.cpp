@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include "storage_nvs/esp_brookesia_service_storage_nvs.hpp"
+#include "storage_nvs/esp_brookesia_service_storage_nvs_file_backend.hpp"
+
+using namespace esp_brookesia::services;
+
+#define TEST_FILE_PATH              "storage_nvs_write_back.bin"
+#define TEST_KEY_NUM                (8)
+#define TEST_SET_ROUNDS             (50)
+#define TEST_WAIT_TIMEOUT_MS        (10000)
+
+#define TEST_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("Check failed at line %d: %s\n", __LINE__, #condition); \
+            return false; \
+        } \
+    } while (0)
+
+static std::string get_key(int index)
+{
+    return "key_" + std::to_string(index);
+}
+
+static bool wait_future(StorageNVS::EventFuture &future)
+{
+    return (future.wait_for(std::chrono::milliseconds(TEST_WAIT_TIMEOUT_MS)) == std::future_status::ready) &&
+           future.get();
+}
+
+static bool flush(StorageNVS &storage)
+{
+    return storage.flush(std::chrono::milliseconds(TEST_WAIT_TIMEOUT_MS));
+}
+
+static std::shared_ptr<StorageNVSFileBackend> create_backend()
+{
+    return std::make_shared<StorageNVSFileBackend>(StorageNVSFileBackend::Config{
+        .path = TEST_FILE_PATH,
+    });
+}
+
+static bool check_value(StorageNVS &storage, const StorageNVS::Key &key, const StorageNVS::Value &expected)
+{
+    StorageNVS::Value value;
+    TEST_CHECK(storage.getLocalParam(key, value));
+    TEST_CHECK(value == expected);
+
+    return true;
+}
+
+// Repeated sets of a key within the debounce window are written to NVS once
+static bool test_coalesce_writes(StorageNVS &storage, StorageNVSFileBackend &backend)
+{
+    storage.resetStats();
+    backend.resetStats();
+    for (int round = 0; round < TEST_SET_ROUNDS; round++) {
+        for (int i = 0; i < TEST_KEY_NUM; i++) {
+            TEST_CHECK(storage.setLocalParam(get_key(i), round));
+        }
+    }
+    TEST_CHECK(storage.getStats().flash_writes == 0);
+    TEST_CHECK(flush(storage));
+
+    auto stats = storage.getStats();
+    printf(
+        "coalesce: %d sets, flash_writes(%" PRIu32 "), commits(%" PRIu32 ")\n", TEST_KEY_NUM * TEST_SET_ROUNDS,
+        stats.flash_writes, stats.commits
+    );
+    TEST_CHECK(stats.flash_writes <= TEST_KEY_NUM);
+    TEST_CHECK(backend.getStats().sets <= TEST_KEY_NUM);
+    for (int i = 0; i < TEST_KEY_NUM; i++) {
+        TEST_CHECK(check_value(storage, get_key(i), TEST_SET_ROUNDS - 1));
+    }
+
+    return true;
+}
+
+// The local parameters are updated at once, before they are written back
+static bool test_read_after_write(StorageNVS &storage)
+{
+    TEST_CHECK(storage.setLocalParam("int", 42));
+    TEST_CHECK(check_value(storage, "int", 42));
+    TEST_CHECK(storage.setLocalParam("string", std::string("value")));
+    TEST_CHECK(check_value(storage, "string", std::string("value")));
+    TEST_CHECK(storage.setLocalParam("bool", true));
+    TEST_CHECK(check_value(storage, "bool", true));
+    TEST_CHECK(storage.setLocalParam("int", 43));
+    TEST_CHECK(check_value(storage, "int", 43));
+
+    return true;
+}
+
+// Reloading the parameters from NVS keeps the pending values, which are newer than the flash
+static bool test_reload_keeps_pending(StorageNVS &storage)
+{
+    StorageNVS::EventFuture future;
+    TEST_CHECK(flush(storage));
+    TEST_CHECK(storage.setLocalParam("int", 44));
+    TEST_CHECK(storage.sendEvent({
+        .operation = StorageNVS::Operation::UpdateParam,
+    }, &future));
+    TEST_CHECK(wait_future(future));
+    TEST_CHECK(check_value(storage, "int", 44));
+
+    TEST_CHECK(flush(storage));
+    TEST_CHECK(storage.sendEvent({
+        .operation = StorageNVS::Operation::UpdateParam,
+    }, &future));
+    TEST_CHECK(wait_future(future));
+    TEST_CHECK(check_value(storage, "int", 44));
+
+    return true;
+}
+
+// Pending parameters are dropped by `del()`, so a restart must be preceded by a flush
+static bool test_flush_before_restart(StorageNVS &storage)
+{
+    TEST_CHECK(storage.setLocalParam("restart", 1));
+    TEST_CHECK(flush(storage));
+    TEST_CHECK(storage.del());
+
+    TEST_CHECK(storage.setBackend(create_backend()) && storage.begin());
+    TEST_CHECK(check_value(storage, "restart", 1));
+    TEST_CHECK(check_value(storage, "int", 44));
+    TEST_CHECK(check_value(storage, "string", std::string("value")));
+    TEST_CHECK(check_value(storage, "bool", true));
+    for (int i = 0; i < TEST_KEY_NUM; i++) {
+        TEST_CHECK(check_value(storage, get_key(i), TEST_SET_ROUNDS - 1));
+    }
+
+    return true;
+}
+
+extern "C" void app_main(void)
+{
+    remove(TEST_FILE_PATH);
+
+    auto backend = create_backend();
+    auto &storage = StorageNVS::requestInstance();
+    if (!storage.setBackend(backend) || !storage.begin()) {
+        printf("Begin storage failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    bool is_ok = test_coalesce_writes(storage, *backend) && test_read_after_write(storage) &&
+                 test_reload_keeps_pending(storage) && test_flush_before_restart(storage);
+    storage.del();
+    remove(TEST_FILE_PATH);
+
+    printf("%s\n", is_ok ? "Test passed" : "Test failed");
+    exit(is_ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -30,4 +30,22 @@
 #           define ESP_BROOKESIA_STORAGE_NVS_ENABLE_DEBUG_LOG  (0)
 #       endif
 #   endif
+
+#   if !defined(ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_DEBOUNCE_MS)
+#       if defined(CONFIG_ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_DEBOUNCE_MS)
+#           define ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_DEBOUNCE_MS \
+                CONFIG_ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_DEBOUNCE_MS
+#       else
+#           define ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_DEBOUNCE_MS  (300)
+#       endif
+#   endif
+
+#   if !defined(ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_MAX_LATENCY_MS)
+#       if defined(CONFIG_ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_MAX_LATENCY_MS)
+#           define ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_MAX_LATENCY_MS \
+                CONFIG_ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_MAX_LATENCY_MS
+#       else
+#           define ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_MAX_LATENCY_MS  (2000)
+#       endif
+#   endif
 #endif
@@ -3,52 +3,445 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <chrono>
-#include "nvs_flash.h"
-#include "nvs.h"
 #include "private/esp_brookesia_service_storage_nvs_utils.hpp"
 #include "esp_brookesia_service_storage_nvs.hpp"
+#include "esp_brookesia_service_storage_nvs_flash_backend.hpp"
 
-#define STORAGE_NVS_PARTITION_NAME          NVS_DEFAULT_PART_NAME
 #define STORAGE_NVS_NAMESPACE               "storage"
+// Strings longer than this are stored as blobs in a separate namespace, NVS splits them into chunks across pages
+#define STORAGE_NVS_LONG_STR_NAMESPACE      "storage_lstr"
+#define STORAGE_NVS_SHORT_STR_LEN_MAX       (1024)
+// Long strings of the other namespaces are stored in `<namespace>` + this suffix
+#define STORAGE_NVS_LONG_STR_SUFFIX         ":l"
+// Approximate flash usage of a value, used by the namespace quotas
+#define STORAGE_NVS_ENTRY_SIZE              (32)
+// A transaction is first written as one blob, which NVS writes atomically, and removed after all keys are applied
+#define STORAGE_NVS_JOURNAL_NAMESPACE       "storage_txn"
+#define STORAGE_NVS_JOURNAL_KEY             "journal"
 
 #define EVENT_THREAD_NAME                   "storage_nvs"
 #define EVENT_THREAD_STACK_SIZE             (4 * 1024)
 #define EVENT_THREAD_STACK_CAPS_EXT         (false)
 #define EVENT_WAIT_FINISH_TIMEOUT_MS_MAX    (60 * 60 * 1000)
 
+#define WRITE_BACK_DEBOUNCE_MS              (ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_DEBOUNCE_MS)
+#define WRITE_BACK_MAX_LATENCY_MS           (ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_MAX_LATENCY_MS)
+
 namespace esp_brookesia::services {
 
-static const std::map<nvs_type_t, const char *> type_str_pair = {
-    { NVS_TYPE_I8, "i8" },
-    { NVS_TYPE_U8, "u8" },
-    { NVS_TYPE_U16, "u16" },
-    { NVS_TYPE_I16, "i16" },
-    { NVS_TYPE_U32, "u32" },
-    { NVS_TYPE_I32, "i32" },
-    { NVS_TYPE_U64, "u64" },
-    { NVS_TYPE_I64, "i64" },
-    { NVS_TYPE_STR, "str" },
-    { NVS_TYPE_BLOB, "blob" },
-    { NVS_TYPE_ANY, "any" },
+using BackendType = StorageNVSBackend::Type;
+using BackendHandle = StorageNVSBackend::Handle;
+
+static const std::map<BackendType, const char *> type_str_pair = {
+    { BackendType::I32, "i32" },
+    { BackendType::I64, "i64" },
+    { BackendType::U8, "u8" },
+    { BackendType::U32, "u32" },
+    { BackendType::Str, "str" },
+    { BackendType::Blob, "blob" },
+};
+
+/**
+ * Storage layout of each value type. The NVS types are only used by this service, so `u8` and `u32` are reused for
+ * `bool` and `float`.
+ */
+enum NVSLayout : uint8_t {
+    NVS_LAYOUT_I32,
+    NVS_LAYOUT_I64,
+    NVS_LAYOUT_BOOL,
+    NVS_LAYOUT_FLOAT,
+    NVS_LAYOUT_STR,
+    NVS_LAYOUT_BLOB,
+    NVS_LAYOUT_LONG_STR,
+};
+
+static NVSLayout get_value_layout(const StorageNVS::Value &value)
+{
+    if (std::holds_alternative<int64_t>(value)) {
+        return NVS_LAYOUT_I64;
+    } else if (std::holds_alternative<bool>(value)) {
+        return NVS_LAYOUT_BOOL;
+    } else if (std::holds_alternative<float>(value)) {
+        return NVS_LAYOUT_FLOAT;
+    } else if (std::holds_alternative<std::string>(value)) {
+        return (std::get<std::string>(value).size() > STORAGE_NVS_SHORT_STR_LEN_MAX) ? NVS_LAYOUT_LONG_STR :
+               NVS_LAYOUT_STR;
+    } else if (std::holds_alternative<StorageNVS::Blob>(value)) {
+        return NVS_LAYOUT_BLOB;
+    }
+    return NVS_LAYOUT_I32;
+}
+
+static void split_key(const StorageNVS::Key &key, std::string &name_space, std::string &nvs_key)
+{
+    auto pos = key.find(StorageNVS::NAMESPACE_SEPARATOR);
+    if (pos == std::string::npos) {
+        name_space = STORAGE_NVS_NAMESPACE;
+        nvs_key = key;
+    } else {
+        name_space = key.substr(0, pos);
+        nvs_key = key.substr(pos + 1);
+    }
+}
+
+static std::string get_long_str_namespace(const std::string &name_space)
+{
+    if (name_space == STORAGE_NVS_NAMESPACE) {
+        return STORAGE_NVS_LONG_STR_NAMESPACE;
+    }
+    return name_space + STORAGE_NVS_LONG_STR_SUFFIX;
+}
+
+static bool is_valid_namespace(const std::string &name_space)
+{
+    return !name_space.empty() && (name_space.size() <= StorageNVS::NAMESPACE_LEN_MAX) &&
+           (name_space.find(StorageNVS::NAMESPACE_SEPARATOR) == std::string::npos) &&
+           (name_space != STORAGE_NVS_NAMESPACE) && (name_space != STORAGE_NVS_LONG_STR_NAMESPACE) &&
+           (name_space != STORAGE_NVS_JOURNAL_NAMESPACE);
+}
+
+static bool is_valid_key(const StorageNVS::Key &key)
+{
+    std::string name_space;
+    std::string nvs_key;
+    split_key(key, name_space, nvs_key);
+
+    bool is_qualified = (key.find(StorageNVS::NAMESPACE_SEPARATOR) != std::string::npos);
+    return !nvs_key.empty() && (nvs_key.size() <= StorageNVSBackend::KEY_LEN_MAX) &&
+           (!is_qualified || is_valid_namespace(name_space));
+}
+
+static size_t get_value_flash_size(const StorageNVS::Value &value)
+{
+    size_t data_len = 0;
+    if (std::holds_alternative<std::string>(value)) {
+        data_len = std::get<std::string>(value).size();
+    } else if (std::holds_alternative<StorageNVS::Blob>(value)) {
+        auto &blob = std::get<StorageNVS::Blob>(value);
+        data_len = (blob == nullptr) ? 0 : blob->size();
+    }
+
+    // One header entry, strings and blobs are followed by their data entries
+    return STORAGE_NVS_ENTRY_SIZE + (data_len + STORAGE_NVS_ENTRY_SIZE - 1) / STORAGE_NVS_ENTRY_SIZE *
+           STORAGE_NVS_ENTRY_SIZE;
+}
+
+static size_t get_namespace_flash_size(const StorageNVS::ParamMap &params, const std::string &name_space)
+{
+    // Keys of a namespace share the same prefix, so they are adjacent in the map
+    auto prefix = name_space + StorageNVS::NAMESPACE_SEPARATOR;
+    size_t size = 0;
+    for (auto it = params.lower_bound(prefix); it != params.end(); it++) {
+        if (it->first.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+        size += get_value_flash_size(it->second);
+    }
+
+    return size;
+}
+
+/**
+ * Opens each namespace once for a batch of writes, commits them together and closes them when destroyed
+ */
+class BackendHandles {
+public:
+    BackendHandles(StorageNVSBackend &backend): _backend(backend) {}
+    ~BackendHandles()
+    {
+        for (auto &[name_space, handle] : _handles) {
+            _backend.close(handle);
+        }
+    }
+
+    esp_err_t get(const std::string &name_space, BackendHandle &handle)
+    {
+        auto it = _handles.find(name_space);
+        if (it != _handles.end()) {
+            handle = it->second;
+            return ESP_OK;
+        }
+
+        esp_err_t ret = _backend.open(name_space.c_str(), false, handle);
+        if (ret == ESP_OK) {
+            _handles.emplace(name_space, handle);
+        }
+        return ret;
+    }
+
+    esp_err_t commit()
+    {
+        for (auto &[name_space, handle] : _handles) {
+            esp_err_t ret = _backend.commit(handle);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+        }
+        return ESP_OK;
+    }
+
+private:
+    StorageNVSBackend &_backend;
+    std::map<std::string, BackendHandle> _handles;
 };
 
+static esp_err_t backend_set_value(
+    StorageNVSBackend &backend, BackendHandle handle, const char *key, const StorageNVS::Value &value
+)
+{
+    if (std::holds_alternative<int>(value)) {
+        int32_t value_i32 = std::get<int>(value);
+        return backend.set(handle, key, BackendType::I32, &value_i32, sizeof(value_i32));
+    } else if (std::holds_alternative<int64_t>(value)) {
+        return backend.set(handle, key, BackendType::I64, &std::get<int64_t>(value), sizeof(int64_t));
+    } else if (std::holds_alternative<bool>(value)) {
+        uint8_t value_u8 = std::get<bool>(value) ? 1 : 0;
+        return backend.set(handle, key, BackendType::U8, &value_u8, sizeof(value_u8));
+    } else if (std::holds_alternative<float>(value)) {
+        uint32_t bits;
+        auto value_float = std::get<float>(value);
+        memcpy(&bits, &value_float, sizeof(bits));
+        return backend.set(handle, key, BackendType::U32, &bits, sizeof(bits));
+    } else if (std::holds_alternative<std::string>(value)) {
+        auto &value_str = std::get<std::string>(value);
+        auto type = (value_str.size() > STORAGE_NVS_SHORT_STR_LEN_MAX) ? BackendType::Blob : BackendType::Str;
+        return backend.set(handle, key, type, value_str.data(), value_str.size());
+    } else if (std::holds_alternative<StorageNVS::Blob>(value)) {
+        auto &blob = std::get<StorageNVS::Blob>(value);
+        if ((blob == nullptr) || blob->empty()) {
+            return backend.set(handle, key, BackendType::Blob, nullptr, 0);
+        }
+        return backend.set(handle, key, BackendType::Blob, blob->data(), blob->size());
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+static esp_err_t backend_get_value(
+    StorageNVSBackend &backend, BackendHandle handle, const StorageNVSBackend::Entry &entry, StorageNVS::Value &value
+)
+{
+    const char *key = entry.key.c_str();
+    esp_err_t ret = ESP_OK;
+    switch (entry.type) {
+    case BackendType::I32: {
+        int32_t value_int = 0;
+        size_t len = sizeof(value_int);
+        ret = backend.get(handle, key, entry.type, &value_int, len);
+        value = static_cast<int>(value_int);
+        break;
+    }
+    case BackendType::I64: {
+        int64_t value_int64 = 0;
+        size_t len = sizeof(value_int64);
+        ret = backend.get(handle, key, entry.type, &value_int64, len);
+        value = value_int64;
+        break;
+    }
+    case BackendType::U8: {
+        uint8_t value_u8 = 0;
+        size_t len = sizeof(value_u8);
+        ret = backend.get(handle, key, entry.type, &value_u8, len);
+        value = (value_u8 != 0);
+        break;
+    }
+    case BackendType::U32: {
+        uint32_t bits = 0;
+        float value_float = 0;
+        size_t len = sizeof(bits);
+        ret = backend.get(handle, key, entry.type, &bits, len);
+        memcpy(&value_float, &bits, sizeof(value_float));
+        value = value_float;
+        break;
+    }
+    case BackendType::Str: {
+        // Probe the length first so the string is read with its exact size
+        size_t len = 0;
+        ret = backend.get(handle, key, entry.type, nullptr, len);
+        if (ret != ESP_OK) {
+            break;
+        }
+        std::string value_str(len, '\0');
+        ret = backend.get(handle, key, entry.type, value_str.data(), len);
+        value = std::move(value_str);
+        break;
+    }
+    case BackendType::Blob: {
+        size_t len = 0;
+        ret = backend.get(handle, key, entry.type, nullptr, len);
+        if (ret != ESP_OK) {
+            break;
+        }
+        auto blob = std::make_shared<std::vector<uint8_t>>(len);
+        ret = backend.get(handle, key, entry.type, blob->data(), len);
+        value = StorageNVS::Blob(std::move(blob));
+        break;
+    }
+    default:
+        ret = ESP_ERR_NOT_SUPPORTED;
+        break;
+    }
+
+    return ret;
+}
+
+/**
+ * Journal entry layout: layout(u8), key_len(u8), key, data_len(u32), data
+ */
+static void journal_append(std::vector<uint8_t> &journal, const std::string &key, const StorageNVS::Value &value)
+{
+    auto layout = get_value_layout(value);
+    const void *data = nullptr;
+    uint32_t data_len = 0;
+    int32_t value_i32 = 0;
+    uint8_t value_u8 = 0;
+    if (std::holds_alternative<int>(value)) {
+        value_i32 = std::get<int>(value);
+        data = &value_i32;
+        data_len = sizeof(value_i32);
+    } else if (std::holds_alternative<int64_t>(value)) {
+        data = &std::get<int64_t>(value);
+        data_len = sizeof(int64_t);
+    } else if (std::holds_alternative<bool>(value)) {
+        value_u8 = std::get<bool>(value) ? 1 : 0;
+        data = &value_u8;
+        data_len = sizeof(value_u8);
+    } else if (std::holds_alternative<float>(value)) {
+        data = &std::get<float>(value);
+        data_len = sizeof(float);
+    } else if (std::holds_alternative<std::string>(value)) {
+        data = std::get<std::string>(value).data();
+        data_len = std::get<std::string>(value).size();
+    } else if (auto &blob = std::get<StorageNVS::Blob>(value); blob != nullptr) {
+        data = blob->data();
+        data_len = blob->size();
+    }
+
+    auto header_pos = journal.size();
+    journal.resize(header_pos + 2 + key.size() + sizeof(data_len) + data_len);
+    auto ptr = journal.data() + header_pos;
+    *ptr++ = layout;
+    *ptr++ = static_cast<uint8_t>(key.size());
+    memcpy(ptr, key.data(), key.size());
+    ptr += key.size();
+    memcpy(ptr, &data_len, sizeof(data_len));
+    ptr += sizeof(data_len);
+    if (data_len > 0) {
+        memcpy(ptr, data, data_len);
+    }
+}
+
+static bool journal_parse(
+    const std::vector<uint8_t> &journal, std::vector<std::pair<std::string, StorageNVS::Value>> &entries
+)
+{
+    size_t pos = 0;
+    while (pos < journal.size()) {
+        if (pos + 2 > journal.size()) {
+            return false;
+        }
+        uint8_t layout = journal[pos];
+        size_t key_len = journal[pos + 1];
+        pos += 2;
+        uint32_t data_len = 0;
+        if (pos + key_len + sizeof(data_len) > journal.size()) {
+            return false;
+        }
+        std::string key(reinterpret_cast<const char *>(journal.data() + pos), key_len);
+        pos += key_len;
+        memcpy(&data_len, journal.data() + pos, sizeof(data_len));
+        pos += sizeof(data_len);
+        if (pos + data_len > journal.size()) {
+            return false;
+        }
+        auto data = journal.data() + pos;
+        pos += data_len;
+
+        StorageNVS::Value value;
+        switch (layout) {
+        case NVS_LAYOUT_I32: {
+            int32_t value_i32 = 0;
+            memcpy(&value_i32, data, std::min<size_t>(data_len, sizeof(value_i32)));
+            value = static_cast<int>(value_i32);
+            break;
+        }
+        case NVS_LAYOUT_I64: {
+            int64_t value_i64 = 0;
+            memcpy(&value_i64, data, std::min<size_t>(data_len, sizeof(value_i64)));
+            value = value_i64;
+            break;
+        }
+        case NVS_LAYOUT_BOOL:
+            value = (data_len > 0) && (data[0] != 0);
+            break;
+        case NVS_LAYOUT_FLOAT: {
+            float value_float = 0;
+            memcpy(&value_float, data, std::min<size_t>(data_len, sizeof(value_float)));
+            value = value_float;
+            break;
+        }
+        case NVS_LAYOUT_STR:
+        case NVS_LAYOUT_LONG_STR:
+            value = std::string(reinterpret_cast<const char *>(data), data_len);
+            break;
+        case NVS_LAYOUT_BLOB:
+            value = StorageNVS::makeBlob(data, data_len);
+            break;
+        default:
+            return false;
+        }
+        entries.emplace_back(std::move(key), std::move(value));
+    }
+
+    return true;
+}
+
 void StorageNVS::Event::dump() const
 {
     ESP_UTILS_LOGI(
         "{Event}:\n"
         "\t-Operation(%d)\n"
-        "\t-Key(%s)\n",
+        "\t-Key(%s)\n"
+        "\t-Key ID(%d)\n"
+        "\t-Keys(%d)\n",
         static_cast<int>(operation),
-        key.empty() ? "None" : key.c_str()
+        key.empty() ? "None" : key.c_str(),
+        static_cast<int>(key_id),
+        static_cast<int>(keys.size())
     );
 }
 
+bool StorageNVS::setBackend(std::shared_ptr<StorageNVSBackend> backend)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: backend(%p)", backend.get());
+    ESP_UTILS_CHECK_NULL_RETURN(backend, false, "Invalid backend");
+    ESP_UTILS_CHECK_FALSE_RETURN(!_event_thread.joinable(), false, "Should be called before begin");
+
+    _backend = std::move(backend);
+
+    return true;
+}
+
 bool StorageNVS::begin()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
+    if (_event_thread.joinable()) {
+        ESP_UTILS_LOGW("Already begun");
+        return true;
+    }
+
+    if (_backend == nullptr) {
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            _backend = std::make_shared<StorageNVSFlashBackend>(), false, "Create NVS flash backend failed"
+        );
+    }
+
     {
         esp_utils::thread_config_guard thread_config(esp_utils::ThreadConfig{
             .name = EVENT_THREAD_NAME,
@@ -58,38 +451,47 @@ bool StorageNVS::begin()
         _event_thread = boost::thread([this]() {
             ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-            // Initialize NVS flash
-            esp_err_t ret = nvs_flash_init();
-            if ((ret == ESP_ERR_NVS_NO_FREE_PAGES) || (ret == ESP_ERR_NVS_NEW_VERSION_FOUND)) {
-                ESP_UTILS_CHECK_FALSE_RETURN(nvs_flash_erase() == ESP_OK, false, "Erase NVS flash failed");
-                ESP_UTILS_CHECK_FALSE_RETURN(nvs_flash_init() == ESP_OK, false, "Init NVS flash failed");
-            } else {
-                ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Initialize NVS flash failed");
-            }
+            ESP_UTILS_CHECK_ERROR_RETURN(_backend->init(), false, "Initialize NVS backend failed");
 
             // Create NVS namespace if not exists
             {
-                nvs_handle_t nvs_handle;
+                BackendHandle nvs_handle;
                 ESP_UTILS_CHECK_ERROR_RETURN(
-                    nvs_open(STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle), false, "Open NVS namespace failed"
+                    _backend->open(STORAGE_NVS_NAMESPACE, false, nvs_handle), false, "Open NVS namespace failed"
                 );
                 esp_utils::function_guard nvs_close_guard([&]() {
-                    nvs_close(nvs_handle);
+                    _backend->close(nvs_handle);
                 });
-                ESP_UTILS_CHECK_ERROR_RETURN(nvs_commit(nvs_handle), false, "Commit NVS failed");
+                ESP_UTILS_CHECK_ERROR_RETURN(_backend->commit(nvs_handle), false, "Commit NVS failed");
+            }
+
+            // Finish a transaction which was interrupted by a reset
+            if (!recoverJournal()) {
+                ESP_UTILS_LOGE("Recover NVS journal failed");
             }
 
+            auto has_event = [this] {
+                return !_event_queue.empty() || _event_thread_need_exit;
+            };
             while (true) {
                 std::unique_lock<std::mutex> lock(_event_mutex);
-                _event_cv.wait(lock, [this] {
-                    return !_event_queue.empty();
-                });
+                if (_dirty_keys.empty()) {
+                    _event_cv.wait(lock, has_event);
+                } else if (!_event_cv.wait_until(lock, getFlushDeadline(), has_event)) {
+                    // The write-back window has expired, write all pending parameters in one commit
+                    lock.unlock();
+                    if (!doEventOperationFlush()) {
+                        ESP_UTILS_LOGE("Flush NVS failed");
+                    }
+                    continue;
+                }
 
                 while (!_event_queue.empty()) {
                     auto event_wrapper = _event_queue.front();
                     _event_queue.pop();
 
                     lock.unlock();
+                    updateQueueLatency(event_wrapper.send_time);
                     auto ret = processEvent(event_wrapper.event);
                     lock.lock();
 
@@ -97,7 +499,17 @@ bool StorageNVS::begin()
                         event_wrapper.promise->set_value(ret);
                     }
                 }
+
+                if (_event_thread_need_exit) {
+                    lock.unlock();
+                    if (!_dirty_keys.empty() && !doEventOperationFlush()) {
+                        ESP_UTILS_LOGE("Flush NVS failed");
+                    }
+                    break;
+                }
             }
+
+            return true;
         });
     }
 
@@ -114,6 +526,43 @@ bool StorageNVS::begin()
     return true;
 }
 
+bool StorageNVS::del()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (!_event_thread.joinable()) {
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_event_mutex);
+        _event_thread_need_exit = true;
+        _event_cv.notify_one();
+    }
+    _event_thread.join();
+
+    {
+        std::lock_guard<std::mutex> lock(_event_mutex);
+        _event_thread_need_exit = false;
+        _event_queue = {};
+    }
+    {
+        std::lock_guard<std::mutex> lock(_params_mutex);
+        _params_snapshot.store(std::make_shared<const ParamMap>());
+    }
+    {
+        std::lock_guard<std::mutex> lock(_namespaces_mutex);
+        for (auto &[name_space, info] : _namespaces) {
+            info.is_loaded = false;
+        }
+    }
+    _dirty_keys.clear();
+    _nvs_layouts.clear();
+    ESP_UTILS_CHECK_ERROR_RETURN(_backend->deinit(), false, "Deinitialize NVS backend failed");
+
+    return true;
+}
+
 bool StorageNVS::sendEvent(const Event &event, EventFuture *future)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -125,7 +574,11 @@ bool StorageNVS::sendEvent(const Event &event, EventFuture *future)
 
     EventWrapper event_wrapper = {
         .event = event,
+        .send_time = Clock::now(),
     };
+    if (!event.key.empty() && (event.key_id == KEY_ID_INVALID)) {
+        event_wrapper.event.key_id = internKey(event.key);
+    }
     if (future != nullptr) {
         ESP_UTILS_CHECK_EXCEPTION_RETURN(
             event_wrapper.promise = std::make_shared<EventPromise>(), false, "Make event promise failed"
@@ -147,14 +600,15 @@ bool StorageNVS::setLocalParam(const Key &key, const Value &value, const void *s
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     ESP_UTILS_LOGD(
-        "Param: key(%s), value(%s), future(%p)", key.c_str(), std::holds_alternative<int>(value) ?
-        std::to_string(std::get<int>(value)).c_str() : std::get<std::string>(value).c_str(), future
+        "Param: key(%s), value(%s), future(%p)", key.c_str(), valueToString(value).c_str(), future
     );
+    ESP_UTILS_CHECK_FALSE_RETURN(is_valid_key(key), false, "Invalid NVS key(%s)", key.c_str());
+    ESP_UTILS_CHECK_FALSE_RETURN(loadNamespaceOfKey(key), false, "Load namespace of key(%s) failed", key.c_str());
 
-    {
-        std::lock_guard<std::mutex> lock(_params_mutex);
-        _local_params[key] = value;
-    }
+    ESP_UTILS_CHECK_FALSE_RETURN(updateLocalParams([&](ParamMap & params) {
+        params[key] = value;
+        return checkNamespaceQuotas(params, {key});
+    }), false, "Update local param failed");
 
     ESP_UTILS_CHECK_FALSE_RETURN(sendEvent({
         .sender = sender,
@@ -167,10 +621,12 @@ bool StorageNVS::setLocalParam(const Key &key, const Value &value, const void *s
 
 bool StorageNVS::getLocalParam(const Key &key, Value &value)
 {
-    std::lock_guard<std::mutex> lock(_params_mutex);
+    ESP_UTILS_CHECK_FALSE_RETURN(loadNamespaceOfKey(key), false, "Load namespace of key(%s) failed", key.c_str());
+
+    auto params = _params_snapshot.load();
 
-    auto it = _local_params.find(key);
-    if (it == _local_params.end()) {
+    auto it = params->find(key);
+    if (it == params->end()) {
         ESP_UTILS_LOGW("NVS key(%s) not found", key.c_str());
         return false;
     }
@@ -180,6 +636,98 @@ bool StorageNVS::getLocalParam(const Key &key, Value &value)
     return true;
 }
 
+bool StorageNVS::Transaction::commit(const void *sender, EventFuture *future)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _storage.commitTransaction(_params, sender, future), false, "Commit transaction failed"
+    );
+    _params.clear();
+
+    return true;
+}
+
+bool StorageNVS::commitTransaction(const ParamMap &params, const void *sender, EventFuture *future)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: params(%d), future(%p)", static_cast<int>(params.size()), future);
+    ESP_UTILS_CHECK_FALSE_RETURN(!params.empty(), false, "Empty transaction");
+
+    std::vector<Key> keys;
+    keys.reserve(params.size());
+    for (auto &[key, value] : params) {
+        ESP_UTILS_CHECK_FALSE_RETURN(is_valid_key(key), false, "Invalid NVS key(%s)", key.c_str());
+        ESP_UTILS_CHECK_FALSE_RETURN(loadNamespaceOfKey(key), false, "Load namespace of key(%s) failed", key.c_str());
+        keys.push_back(key);
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(updateLocalParams([&](ParamMap & local_params) {
+        for (auto &[key, value] : params) {
+            local_params[key] = value;
+        }
+        return checkNamespaceQuotas(local_params, keys);
+    }), false, "Update local params failed");
+
+    ESP_UTILS_CHECK_FALSE_RETURN(sendEvent({
+        .sender = sender,
+        .operation = Operation::CommitTransaction,
+        .keys = std::move(keys),
+    }, future), false, "Send commit transaction event failed");
+
+    return true;
+}
+
+bool StorageNVS::registerNamespace(const std::string &name_space, size_t quota_bytes)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: name_space(%s), quota_bytes(%d)", name_space.c_str(), static_cast<int>(quota_bytes));
+    ESP_UTILS_CHECK_FALSE_RETURN(is_valid_namespace(name_space), false, "Invalid namespace(%s)", name_space.c_str());
+
+    std::lock_guard<std::mutex> lock(_namespaces_mutex);
+    _namespaces[name_space].quota_bytes = quota_bytes;
+
+    return true;
+}
+
+bool StorageNVS::loadNamespace(const std::string &name_space)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(is_valid_namespace(name_space), false, "Invalid namespace(%s)", name_space.c_str());
+
+    {
+        std::lock_guard<std::mutex> lock(_namespaces_mutex);
+        auto &info = _namespaces[name_space];
+        if (info.is_loaded) {
+            return true;
+        }
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_event_thread.joinable(), false, "Not begun");
+
+    // Slots are called in the event thread, waiting for it there would never finish
+    if (boost::this_thread::get_id() == _event_thread.get_id()) {
+        return doEventOperationLoadNamespace(name_space);
+    }
+
+    EventFuture future;
+    ESP_UTILS_CHECK_FALSE_RETURN(sendEvent({
+        .operation = Operation::LoadNamespace,
+        .name_space = name_space,
+    }, &future), false, "Send load namespace event failed");
+
+    auto status = future.wait_for(std::chrono::milliseconds(EVENT_WAIT_FINISH_TIMEOUT_MS_MAX));
+    ESP_UTILS_CHECK_FALSE_RETURN(status == std::future_status::ready, false, "Wait for load namespace timeout");
+
+    return future.get();
+}
+
+size_t StorageNVS::getNamespaceUsage(const std::string &name_space)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(loadNamespace(name_space), 0, "Load namespace(%s) failed", name_space.c_str());
+
+    return get_namespace_flash_size(*_params_snapshot.load(), name_space);
+}
+
 bool StorageNVS::eraseNVS(const void *sender, EventFuture *future)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -194,6 +742,83 @@ bool StorageNVS::eraseNVS(const void *sender, EventFuture *future)
     return true;
 }
 
+bool StorageNVS::flush(const void *sender, EventFuture *future)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: future(%p)", future);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(sendEvent({
+        .sender = sender,
+        .operation = Operation::Flush,
+    }, future), false, "Send flush event failed");
+
+    return true;
+}
+
+bool StorageNVS::flush(std::chrono::milliseconds timeout)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: timeout(%d ms)", static_cast<int>(timeout.count()));
+    ESP_UTILS_CHECK_FALSE_RETURN(_event_thread.joinable(), false, "Not begun");
+
+    // Slots are called in the event thread, waiting for it there would never finish
+    if (boost::this_thread::get_id() == _event_thread.get_id()) {
+        return doEventOperationFlush();
+    }
+
+    EventFuture future;
+    ESP_UTILS_CHECK_FALSE_RETURN(flush(nullptr, &future), false, "Flush failed");
+
+    auto status = future.wait_for(timeout);
+    ESP_UTILS_CHECK_FALSE_RETURN(status == std::future_status::ready, false, "Wait for flush timeout");
+
+    return future.get();
+}
+
+StorageNVS::Stats StorageNVS::getStats()
+{
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+
+    return _stats;
+}
+
+void StorageNVS::resetStats()
+{
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+
+    _stats = {};
+}
+
+StorageNVS::Blob StorageNVS::makeBlob(const void *data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t *>(data);
+    if (bytes == nullptr) {
+        return std::make_shared<const std::vector<uint8_t>>();
+    }
+
+    return std::make_shared<const std::vector<uint8_t>>(bytes, bytes + size);
+}
+
+std::string StorageNVS::valueToString(const Value &value)
+{
+    if (std::holds_alternative<int>(value)) {
+        return std::to_string(std::get<int>(value));
+    } else if (std::holds_alternative<int64_t>(value)) {
+        return std::to_string(std::get<int64_t>(value));
+    } else if (std::holds_alternative<float>(value)) {
+        return std::to_string(std::get<float>(value));
+    } else if (std::holds_alternative<bool>(value)) {
+        return std::get<bool>(value) ? "true" : "false";
+    } else if (std::holds_alternative<std::string>(value)) {
+        return std::get<std::string>(value);
+    }
+
+    auto &blob = std::get<Blob>(value);
+    return "blob(" + std::to_string((blob == nullptr) ? 0 : blob->size()) + ")";
+}
+
 boost::signals2::connection StorageNVS::connectEventSignal(EventSignal::slot_type slot)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -201,6 +826,39 @@ boost::signals2::connection StorageNVS::connectEventSignal(EventSignal::slot_typ
     return _event_signal.connect(slot);
 }
 
+boost::signals2::connection StorageNVS::subscribe(const Key &key, EventSignal::slot_type slot)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: key(%s)", key.c_str());
+
+    auto key_id = internKey(key);
+
+    std::lock_guard<std::mutex> lock(_keys_mutex);
+    auto &signal = _key_signals[key_id - 1];
+    if (signal == nullptr) {
+        signal = std::make_unique<EventSignal>();
+    }
+
+    return signal->connect(slot);
+}
+
+StorageNVS::KeyId StorageNVS::internKey(const Key &key)
+{
+    std::lock_guard<std::mutex> lock(_keys_mutex);
+
+    auto it = _key_ids.find(key);
+    if (it != _key_ids.end()) {
+        return it->second;
+    }
+
+    _key_signals.emplace_back(nullptr);
+    auto key_id = static_cast<KeyId>(_key_signals.size());
+    _key_ids.emplace(key, key_id);
+
+    return key_id;
+}
+
 bool StorageNVS::processEvent(const Event &event)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
@@ -223,159 +881,543 @@ bool StorageNVS::processEvent(const Event &event)
         ESP_UTILS_CHECK_FALSE_RETURN(doEventOperationEraseNVS(), false, "Erase NVS failed");
         break;
     }
+    case Operation::Flush: {
+        ESP_UTILS_CHECK_FALSE_RETURN(doEventOperationFlush(), false, "Flush NVS failed");
+        break;
+    }
+    case Operation::CommitTransaction: {
+        ESP_UTILS_CHECK_FALSE_RETURN(doEventOperationCommitTransaction(event), false, "Commit transaction failed");
+        break;
+    }
+    case Operation::LoadNamespace: {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            doEventOperationLoadNamespace(event.name_space), false, "Load namespace(%s) failed",
+            event.name_space.c_str()
+        );
+        break;
+    }
     default:
         ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Invalid operation(%d)", static_cast<int>(event.operation));
     }
 
-    _event_signal(event);
+    emitEventSignals(event);
 
     return true;
 }
 
+void StorageNVS::emitEventSignals(const Event &event)
+{
+    _event_signal(event);
+
+    if ((event.operation == Operation::UpdateNVS) && (event.key_id != KEY_ID_INVALID)) {
+        auto key_signal = getKeySignal(event.key_id);
+        if (key_signal != nullptr) {
+            (*key_signal)(event);
+        }
+    }
+}
+
 bool StorageNVS::doEventOperationUpdateNVS(const Key &key)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
     ESP_UTILS_LOGD("Param: key(%s)", key.c_str());
 
-    std::lock_guard<std::mutex> lock(_params_mutex);
+    auto params = _params_snapshot.load();
+    ESP_UTILS_CHECK_FALSE_RETURN(params->find(key) != params->end(), false, "Invalid NVS key(%s)", key.c_str());
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        _stats.update_requests++;
+    }
 
-    auto it = _local_params.find(key);
-    ESP_UTILS_CHECK_FALSE_RETURN(
-        it != _local_params.end(), false, "Invalid NVS key(%s)", key.c_str()
-    );
-    ESP_UTILS_LOGD("Update key(%s) NVS parameter", key.c_str());
+    if (WRITE_BACK_DEBOUNCE_MS <= 0) {
+        ESP_UTILS_CHECK_FALSE_RETURN(writeKeysToNVS({key}), false, "Write key(%s) to NVS failed", key.c_str());
+        return true;
+    }
 
-    nvs_handle_t nvs_handle;
-    ESP_UTILS_CHECK_ERROR_RETURN(
-        nvs_open(STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle), false, "Open NVS namespace failed"
-    );
+    // Defer the write, all keys updated within the write-back window are committed together
+    auto now = Clock::now();
+    if (_dirty_keys.empty()) {
+        _dirty_first_time = now;
+    }
+    _dirty_last_time = now;
+    _dirty_keys.insert(key);
+    ESP_UTILS_LOGD("Mark key(%s) dirty, pending(%d)", key.c_str(), static_cast<int>(_dirty_keys.size()));
 
-    esp_utils::function_guard nvs_close_guard([&]() {
-        nvs_close(nvs_handle);
-    });
+    return true;
+}
 
-    auto &value = it->second;
-    const char *key_str = key.c_str();
+bool StorageNVS::doEventOperationUpdateParam()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    if (std::holds_alternative<int>(value)) {
-        auto value_int = std::get<int>(value);
-        ESP_UTILS_LOGD("Set key(%s) value(%d)", key_str, value_int);
+    // Read the flash without holding `_params_mutex`, then publish all found keys at once
+    ParamMap nvs_params;
 
-        ESP_UTILS_CHECK_ERROR_RETURN(
-            nvs_set_i32(nvs_handle, key_str, static_cast<int32_t>(value_int)), false, "Set NVS parameter failed"
-        );
-    } else if (std::holds_alternative<std::string>(value)) {
-        auto value_str = std::get<std::string>(value);
-        ESP_UTILS_LOGD("Set key(%s) value(%s)", key_str, value_str.c_str());
+    ESP_UTILS_LOGI("Finding keys in NVS...");
 
-        ESP_UTILS_CHECK_ERROR_RETURN(
-            nvs_set_str(nvs_handle, key_str, value_str.c_str()), false, "Set NVS parameter failed"
+    for (auto &name_space : getLoadedNamespaces()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            readNamespace(name_space, nvs_params), false, "Read namespace(%s) failed", name_space.c_str()
         );
-    } else {
-        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Invalid NVS key(%s) value type", key_str);
     }
 
-    ESP_UTILS_CHECK_ERROR_RETURN(nvs_commit(nvs_handle), false, "Commit NVS failed");
+    ESP_UTILS_LOGI("Found %d keys in NVS", static_cast<int>(nvs_params.size()));
+
+    ESP_UTILS_CHECK_FALSE_RETURN(updateLocalParams([&](ParamMap & params) {
+        for (auto &[key, value] : nvs_params) {
+            // The pending values are newer than the flash, they would be lost by the next write-back
+            if (_dirty_keys.count(key) == 0) {
+                params[key] = std::move(value);
+            }
+        }
+        return true;
+    }), false, "Update local params failed");
 
     return true;
 }
 
-bool StorageNVS::doEventOperationUpdateParam()
+bool StorageNVS::doEventOperationEraseNVS()
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    std::lock_guard<std::mutex> lock(_params_mutex);
+    ESP_UTILS_LOGI("Erase NVS...");
 
-    nvs_handle_t nvs_handle;
-    ESP_UTILS_CHECK_ERROR_RETURN(
-        nvs_open(STORAGE_NVS_NAMESPACE, NVS_READONLY, &nvs_handle), false, "Open NVS namespace failed"
-    );
+    // Pending parameters would be written back after the erase, drop them
+    _dirty_keys.clear();
+    _nvs_layouts.clear();
 
-    esp_utils::function_guard nvs_close_guard([&]() {
-        nvs_close(nvs_handle);
-    });
+    std::vector<std::string> namespaces = {STORAGE_NVS_NAMESPACE};
+    {
+        std::lock_guard<std::mutex> lock(_namespaces_mutex);
+        for (auto &[name_space, info] : _namespaces) {
+            namespaces.push_back(name_space);
+        }
+    }
 
-    ESP_UTILS_LOGI("Finding keys in NVS...");
+    BackendHandles handles(*_backend);
+    for (auto &name_space : namespaces) {
+        for (auto &namespace_name : {name_space, get_long_str_namespace(name_space)}) {
+            BackendHandle nvs_handle;
+            ESP_UTILS_CHECK_ERROR_RETURN(
+                handles.get(namespace_name, nvs_handle), false, "Open NVS namespace(%s) failed",
+                namespace_name.c_str()
+            );
+            ESP_UTILS_CHECK_ERROR_RETURN(_backend->eraseAll(nvs_handle), false, "Erase NVS failed");
+        }
+    }
+    ESP_UTILS_CHECK_ERROR_RETURN(handles.commit(), false, "Commit NVS failed");
 
-    nvs_iterator_t it = NULL;
-    esp_err_t res = nvs_entry_find(STORAGE_NVS_PARTITION_NAME, STORAGE_NVS_NAMESPACE, NVS_TYPE_ANY, &it);
-    while (res == ESP_OK) {
-        nvs_entry_info_t info;
-        res = nvs_entry_info(it, &info);
-        if (res != ESP_OK) {
-            ESP_UTILS_LOGE("Get key info failed");
-            break;
+    return true;
+}
+
+bool StorageNVS::doEventOperationFlush()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    if (_dirty_keys.empty()) {
+        return true;
+    }
+
+    // Always drop the pending keys, otherwise a failed write would be retried without any delay
+    auto keys = std::move(_dirty_keys);
+    _dirty_keys.clear();
+    ESP_UTILS_CHECK_FALSE_RETURN(writeKeysToNVS(keys), false, "Write keys to NVS failed");
+
+    return true;
+}
+
+bool StorageNVS::doEventOperationCommitTransaction(const Event &event)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: keys(%d)", static_cast<int>(event.keys.size()));
+
+    std::set<Key> keys(event.keys.begin(), event.keys.end());
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        _stats.update_requests += keys.size();
+    }
+
+    // The keys are written now with their latest values, so they are no longer pending
+    for (auto &key : keys) {
+        _dirty_keys.erase(key);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(writeKeysToNVS(keys, true), false, "Write transaction to NVS failed");
+
+    // Notify every key as a normal update
+    for (auto &key : event.keys) {
+        emitEventSignals(Event{
+            .sender = event.sender,
+            .operation = Operation::UpdateNVS,
+            .key = key,
+            .key_id = internKey(key),
+        });
+    }
+
+    return true;
+}
+
+bool StorageNVS::doEventOperationLoadNamespace(const std::string &name_space)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: name_space(%s)", name_space.c_str());
+
+    // Several accesses may request the same namespace before it is loaded
+    {
+        std::lock_guard<std::mutex> lock(_namespaces_mutex);
+        if (_namespaces[name_space].is_loaded) {
+            return true;
+        }
+    }
+
+    ParamMap nvs_params;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        readNamespace(name_space, nvs_params), false, "Read namespace(%s) failed", name_space.c_str()
+    );
+    ESP_UTILS_LOGI("Loaded %d keys of namespace(%s)", static_cast<int>(nvs_params.size()), name_space.c_str());
+
+    ESP_UTILS_CHECK_FALSE_RETURN(updateLocalParams([&](ParamMap & params) {
+        for (auto &[key, value] : nvs_params) {
+            params[key] = std::move(value);
         }
+        return true;
+    }), false, "Update local params failed");
+
+    // Only mark it loaded once the keys are published, so readers never see a partially loaded namespace
+    {
+        std::lock_guard<std::mutex> lock(_namespaces_mutex);
+        _namespaces[name_space].is_loaded = true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        _stats.namespace_loads++;
+    }
+
+    return true;
+}
+
+bool StorageNVS::loadNamespaceOfKey(const Key &key)
+{
+    // Keys of the default namespace are loaded by `begin()`
+    auto pos = key.find(NAMESPACE_SEPARATOR);
+    if (pos == std::string::npos) {
+        return true;
+    }
+
+    return loadNamespace(key.substr(0, pos));
+}
 
-        auto type_str_it = type_str_pair.find(info.type);
-        if (type_str_it == type_str_pair.end()) {
-            ESP_UTILS_LOGE("\t- Invalid NVS key(%s) type(%d)", info.key, static_cast<int>(info.type));
-            res = nvs_entry_next(&it);
+bool StorageNVS::readNamespace(const std::string &name_space, ParamMap &params)
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: name_space(%s)", name_space.c_str());
+
+    bool is_default = (name_space == STORAGE_NVS_NAMESPACE);
+    auto long_str_namespace = get_long_str_namespace(name_space);
+    for (auto &namespace_name : {name_space, long_str_namespace}) {
+        bool is_long_str = (namespace_name == long_str_namespace);
+
+        BackendHandle nvs_handle;
+        esp_err_t ret = _backend->open(namespace_name.c_str(), true, nvs_handle);
+        if (ret == ESP_ERR_NOT_FOUND) {
+            // Namespaces are only created when their first key is written
             continue;
         }
+        ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Open NVS namespace(%s) failed", namespace_name.c_str());
 
-        esp_err_t ret = ESP_OK;
-        switch (info.type) {
-        case NVS_TYPE_I32: {
-            int32_t value_int;
-            ret = nvs_get_i32(nvs_handle, info.key, &value_int);
-            if (ret != ESP_OK) {
-                ESP_UTILS_LOGE("\t- Get key(%s) value failed", info.key);
+        esp_utils::function_guard nvs_close_guard([&]() {
+            _backend->close(nvs_handle);
+        });
+
+        std::vector<StorageNVSBackend::Entry> entries;
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            _backend->listEntries(namespace_name.c_str(), entries), false, "List NVS namespace(%s) failed",
+            namespace_name.c_str()
+        );
+        for (auto &entry : entries) {
+            auto key = is_default ? entry.key : makeKey(name_space, entry.key);
+            auto type_str = type_str_pair.at(entry.type);
+
+            Value value;
+            ret = backend_get_value(*_backend, nvs_handle, entry, value);
+            if (ret == ESP_ERR_NOT_SUPPORTED) {
+                ESP_UTILS_LOGI("\t- Skip key(%s): type(%s)", key.c_str(), type_str);
+            } else if (ret != ESP_OK) {
+                ESP_UTILS_LOGE("\t- Get key(%s) value failed", key.c_str());
             } else {
+                if (is_long_str) {
+                    if (!std::holds_alternative<Blob>(value)) {
+                        ESP_UTILS_LOGE("\t- Invalid long string key(%s) type(%s)", key.c_str(), type_str);
+                        continue;
+                    }
+                    auto &blob = std::get<Blob>(value);
+                    value = std::string(blob->begin(), blob->end());
+                    _nvs_layouts[key] = NVS_LAYOUT_LONG_STR;
+                } else {
+                    _nvs_layouts[key] = get_value_layout(value);
+                }
                 ESP_UTILS_LOGI(
-                    "\t- Found key(%s): type(%s), value(%d)", info.key, type_str_it->second, static_cast<int>(value_int)
+                    "\t- Found key(%s): type(%s), value(%s)", key.c_str(), type_str, valueToString(value).c_str()
                 );
-                _local_params[info.key] = Value(static_cast<int>(value_int));
+                params[key] = std::move(value);
             }
-            break;
         }
-        case NVS_TYPE_STR: {
-            size_t len = NVS_VALUE_STR_MAX_LEN;
-            std::unique_ptr<char[]> value_str(new char[len]);
-            ret = nvs_get_str(nvs_handle, info.key, value_str.get(), &len);
-            if (ret != ESP_OK) {
-                ESP_UTILS_LOGE("\t- Get key(%s) value failed", info.key);
-            } else {
-                ESP_UTILS_LOGI(
-                    "\t- Found key(%s): type(%s), value(%s)", info.key, type_str_it->second, value_str.get()
+    }
+
+    return true;
+}
+
+bool StorageNVS::checkNamespaceQuotas(const ParamMap &params, const std::vector<Key> &keys)
+{
+    std::lock_guard<std::mutex> lock(_namespaces_mutex);
+
+    std::string name_space;
+    std::string nvs_key;
+    for (auto &key : keys) {
+        split_key(key, name_space, nvs_key);
+        auto it = _namespaces.find(name_space);
+        if ((it == _namespaces.end()) || (it->second.quota_bytes == 0)) {
+            continue;
+        }
+
+        auto size = get_namespace_flash_size(params, name_space);
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            size <= it->second.quota_bytes, false, "Namespace(%s) exceeds its quota: %d/%d bytes",
+            name_space.c_str(), static_cast<int>(size), static_cast<int>(it->second.quota_bytes)
+        );
+    }
+
+    return true;
+}
+
+std::vector<std::string> StorageNVS::getLoadedNamespaces()
+{
+    std::lock_guard<std::mutex> lock(_namespaces_mutex);
+
+    std::vector<std::string> namespaces = {STORAGE_NVS_NAMESPACE};
+    for (auto &[name_space, info] : _namespaces) {
+        if (info.is_loaded) {
+            namespaces.push_back(name_space);
+        }
+    }
+
+    return namespaces;
+}
+
+bool StorageNVS::recoverJournal()
+{
+    ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+    BackendHandle journal_handle;
+    esp_err_t ret = _backend->open(STORAGE_NVS_JOURNAL_NAMESPACE, false, journal_handle);
+    ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Open NVS journal namespace failed");
+
+    esp_utils::function_guard journal_close_guard([&]() {
+        _backend->close(journal_handle);
+    });
+
+    size_t len = 0;
+    ret = _backend->get(journal_handle, STORAGE_NVS_JOURNAL_KEY, BackendType::Blob, nullptr, len);
+    if (ret == ESP_ERR_NOT_FOUND) {
+        return true;
+    }
+    ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Get NVS journal length failed");
+
+    std::vector<uint8_t> journal(len);
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        _backend->get(journal_handle, STORAGE_NVS_JOURNAL_KEY, BackendType::Blob, journal.data(), len), false,
+        "Get NVS journal failed"
+    );
+
+    std::vector<std::pair<std::string, Value>> entries;
+    if (journal_parse(journal, entries)) {
+        ESP_UTILS_LOGW("Replay %d keys from NVS journal", static_cast<int>(entries.size()));
+
+        BackendHandles handles(*_backend);
+        std::string name_space;
+        std::string nvs_key;
+        for (auto &[key, value] : entries) {
+            split_key(key, name_space, nvs_key);
+
+            BackendHandle nvs_handle;
+            BackendHandle long_str_handle;
+            ESP_UTILS_CHECK_ERROR_RETURN(
+                handles.get(name_space, nvs_handle), false, "Open NVS namespace(%s) failed", name_space.c_str()
+            );
+            ESP_UTILS_CHECK_ERROR_RETURN(
+                handles.get(get_long_str_namespace(name_space), long_str_handle), false,
+                "Open NVS long string namespace of (%s) failed", name_space.c_str()
+            );
+
+            // The previous layout of each key is unknown, remove it from both namespaces before writing it again
+            for (auto handle : {nvs_handle, long_str_handle}) {
+                ret = _backend->eraseKey(handle, nvs_key.c_str());
+                ESP_UTILS_CHECK_FALSE_RETURN(
+                    (ret == ESP_OK) || (ret == ESP_ERR_NOT_FOUND), false, "Erase key(%s) failed", key.c_str()
                 );
-                _local_params[info.key] = Value(std::string(value_str.get()));
             }
-            break;
-        }
-        default:
-            ESP_UTILS_LOGI("\t- Skip key(%s): type(%s)", info.key, type_str_it->second);
-            break;
+            auto handle = (get_value_layout(value) == NVS_LAYOUT_LONG_STR) ? long_str_handle : nvs_handle;
+            ESP_UTILS_CHECK_ERROR_RETURN(
+                backend_set_value(*_backend, handle, nvs_key.c_str(), value), false, "Set key(%s) failed", key.c_str()
+            );
         }
-        res = nvs_entry_next(&it);
+        ESP_UTILS_CHECK_ERROR_RETURN(handles.commit(), false, "Commit NVS failed");
+    } else {
+        ESP_UTILS_LOGE("Invalid NVS journal, discard it");
     }
-    nvs_release_iterator(it);
 
-    ESP_UTILS_LOGI("Found %d keys in NVS", static_cast<int>(_local_params.size()));
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        _backend->eraseKey(journal_handle, STORAGE_NVS_JOURNAL_KEY), false, "Erase NVS journal failed"
+    );
+    ESP_UTILS_CHECK_ERROR_RETURN(_backend->commit(journal_handle), false, "Commit NVS journal failed");
 
     return true;
 }
 
-bool StorageNVS::doEventOperationEraseNVS()
+bool StorageNVS::updateLocalParams(const std::function<bool(ParamMap &params)> &modifier)
+{
+    std::lock_guard<std::mutex> lock(_params_mutex);
+
+    std::shared_ptr<ParamMap> params;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        params = std::make_shared<ParamMap>(*_params_snapshot.load()), false, "Copy local params failed"
+    );
+    if (!modifier(*params)) {
+        return false;
+    }
+    _params_snapshot.store(std::move(params));
+
+    return true;
+}
+
+bool StorageNVS::writeKeysToNVS(const std::set<Key> &keys, bool use_journal)
 {
     ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
 
-    ESP_UTILS_LOGI("Erase NVS...");
+    ESP_UTILS_LOGD("Param: keys(%d), use_journal(%d)", static_cast<int>(keys.size()), use_journal);
 
-    nvs_handle_t nvs_handle;
-    ESP_UTILS_CHECK_ERROR_RETURN(
-        nvs_open(STORAGE_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle), false, "Open NVS namespace failed"
-    );
+    auto params = _params_snapshot.load();
 
-    esp_utils::function_guard nvs_close_guard([&]() {
-        nvs_close(nvs_handle);
+    // A single key is already written atomically by NVS
+    BackendHandle journal_handle = 0;
+    bool is_journal_opened = false;
+    esp_utils::function_guard journal_close_guard([&]() {
+        if (is_journal_opened) {
+            _backend->close(journal_handle);
+        }
     });
+    if (use_journal && (keys.size() > 1)) {
+        std::vector<uint8_t> journal;
+        for (auto &key : keys) {
+            auto it = params->find(key);
+            if (it != params->end()) {
+                journal_append(journal, key, it->second);
+            }
+        }
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            _backend->open(STORAGE_NVS_JOURNAL_NAMESPACE, false, journal_handle), false,
+            "Open NVS journal namespace failed"
+        );
+        is_journal_opened = true;
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            _backend->set(journal_handle, STORAGE_NVS_JOURNAL_KEY, BackendType::Blob, journal.data(), journal.size()),
+            false, "Write NVS journal failed"
+        );
+        ESP_UTILS_CHECK_ERROR_RETURN(_backend->commit(journal_handle), false, "Commit NVS journal failed");
+    }
 
-    ESP_UTILS_CHECK_ERROR_RETURN(nvs_erase_all(nvs_handle), false, "Erase NVS failed");
-    ESP_UTILS_CHECK_ERROR_RETURN(nvs_commit(nvs_handle), false, "Commit NVS failed");
+    // Namespaces are only opened when one of their keys is written
+    BackendHandles handles(*_backend);
+    std::string name_space;
+    std::string nvs_key;
+    auto get_handle = [&](uint8_t layout, BackendHandle &handle) {
+        return handles.get((layout == NVS_LAYOUT_LONG_STR) ? get_long_str_namespace(name_space) : name_space, handle);
+    };
+
+    uint32_t write_count = 0;
+    for (auto &key : keys) {
+        auto it = params->find(key);
+        if (it == params->end()) {
+            ESP_UTILS_LOGW("NVS key(%s) not found, skip", key.c_str());
+            continue;
+        }
+
+        auto &value = it->second;
+        auto layout = get_value_layout(value);
+        split_key(key, name_space, nvs_key);
+        ESP_UTILS_LOGD("Set key(%s) value(%s)", key.c_str(), valueToString(value).c_str());
+
+        // Remove the old entry if the key changes its layout, otherwise both would be loaded
+        auto layout_it = _nvs_layouts.find(key);
+        if ((layout_it != _nvs_layouts.end()) && (layout_it->second != layout)) {
+            BackendHandle old_handle;
+            ESP_UTILS_CHECK_ERROR_RETURN(get_handle(layout_it->second, old_handle), false, "Open NVS failed");
+            esp_err_t ret = _backend->eraseKey(old_handle, nvs_key.c_str());
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                (ret == ESP_OK) || (ret == ESP_ERR_NOT_FOUND), false, "Erase old key(%s) failed", key.c_str()
+            );
+        }
+
+        BackendHandle handle;
+        ESP_UTILS_CHECK_ERROR_RETURN(get_handle(layout, handle), false, "Open NVS failed");
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            backend_set_value(*_backend, handle, nvs_key.c_str(), value), false, "Set NVS parameter failed"
+        );
+        _nvs_layouts[key] = layout;
+        write_count++;
+    }
+
+    ESP_UTILS_CHECK_ERROR_RETURN(handles.commit(), false, "Commit NVS failed");
+    if (is_journal_opened) {
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            _backend->eraseKey(journal_handle, STORAGE_NVS_JOURNAL_KEY), false, "Erase NVS journal failed"
+        );
+        ESP_UTILS_CHECK_ERROR_RETURN(_backend->commit(journal_handle), false, "Commit NVS journal failed");
+    }
+
+    {
+        std::lock_guard<std::mutex> stats_lock(_stats_mutex);
+        _stats.flash_writes += write_count;
+        _stats.commits++;
+    }
+    ESP_UTILS_LOGD("Committed %d keys to NVS", static_cast<int>(write_count));
 
     return true;
 }
 
+StorageNVS::EventSignal *StorageNVS::getKeySignal(KeyId key_id)
+{
+    std::lock_guard<std::mutex> lock(_keys_mutex);
+
+    if ((key_id == KEY_ID_INVALID) || (key_id > _key_signals.size())) {
+        return nullptr;
+    }
+
+    // Signals are never removed, so the pointer stays valid after unlocking
+    return _key_signals[key_id - 1].get();
+}
+
+void StorageNVS::updateQueueLatency(Clock::time_point send_time)
+{
+    auto latency_us = static_cast<uint32_t>(
+                          std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - send_time).count()
+                      );
+
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+    _stats.events++;
+    _stats.queue_latency_us_total += latency_us;
+    _stats.queue_latency_us_max = std::max(_stats.queue_latency_us_max, latency_us);
+}
+
+StorageNVS::Clock::time_point StorageNVS::getFlushDeadline() const
+{
+    auto debounce_deadline = _dirty_last_time + std::chrono::milliseconds(WRITE_BACK_DEBOUNCE_MS);
+    auto latency_deadline = _dirty_first_time + std::chrono::milliseconds(WRITE_BACK_MAX_LATENCY_MS);
+
+    return std::min(debounce_deadline, latency_deadline);
+}
+
 } // namespace esp_brookesia::services
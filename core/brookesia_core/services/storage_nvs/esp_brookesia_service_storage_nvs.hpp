@@ -5,27 +5,46 @@
  */
 #pragma once
 
+#include <atomic>
 #include <bitset>
+#include <chrono>
 #include <queue>
+#include <set>
+#include <functional>
 #include <future>
+#include <map>
+#include <memory>
 #include <variant>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "boost/thread.hpp"
 #include "boost/signals2.hpp"
+#include "esp_brookesia_service_storage_nvs_backend.hpp"
 
 namespace esp_brookesia::services {
 
-constexpr size_t NVS_VALUE_STR_MAX_LEN = 128;
-
 class StorageNVS {
 public:
     using Key = std::string;
-    using Value = std::variant<int, std::string>;
+    // Shared so that reading a blob only copies the pointer
+    using Blob = std::shared_ptr<const std::vector<uint8_t>>;
+    using Value = std::variant<int, std::string, int64_t, float, bool, Blob>;
+    using ParamMap = std::map<Key, Value>;
+    using ParamSnapshot = std::shared_ptr<const ParamMap>;
+    using KeyId = uint32_t;                 // Interned key, `KEY_ID_INVALID` means not interned
+    static constexpr KeyId KEY_ID_INVALID = 0;
+    // Keys of other namespaces than the default one are qualified as `<namespace>:<key>`, see `makeKey()`
+    static constexpr char NAMESPACE_SEPARATOR = ':';
+    static constexpr size_t NAMESPACE_LEN_MAX = 13;     // Leaves room for the suffix of its long string namespace
 
     enum class Operation {
         UpdateNVS,
         UpdateParam,
         EraseNVS,
+        Flush,
+        CommitTransaction,
+        LoadNamespace,
         Max,
     };
 
@@ -35,10 +54,44 @@ public:
         const void *sender;
         Operation operation;
         Key key;
+        KeyId key_id;   // Filled by `sendEvent()` if not set
+        std::vector<Key> keys;  // Keys of `CommitTransaction`
+        std::string name_space; // Namespace of `LoadNamespace`
     };
     using EventFuture = std::future<bool>;
     using EventSignal = boost::signals2::signal<void(const Event &event)>;
 
+    struct Stats {
+        uint32_t update_requests;   // Number of `UpdateNVS` events
+        uint32_t flash_writes;      // Number of keys written to NVS
+        uint32_t commits;           // Number of NVS commits
+        uint32_t events;            // Number of processed events
+        uint64_t queue_latency_us_total;    // Time from sending to processing, summed over all events
+        uint32_t queue_latency_us_max;
+        uint32_t namespace_loads;   // Number of namespaces loaded on first access
+    };
+
+    /**
+     * @brief Group several parameters so that they are written to NVS together and survive a reset all or none
+     */
+    class Transaction {
+    public:
+        Transaction &set(const Key &key, const Value &value)
+        {
+            _params[key] = value;
+            return *this;
+        }
+        bool commit(const void *sender = nullptr, EventFuture *future = nullptr);
+
+    private:
+        friend class StorageNVS;
+
+        Transaction(StorageNVS &storage): _storage(storage) {}
+
+        StorageNVS &_storage;
+        ParamMap _params;
+    };
+
     StorageNVS(const StorageNVS &) = delete;
     StorageNVS(StorageNVS &&) = delete;
     ~StorageNVS() = default;
@@ -46,15 +99,64 @@ public:
     StorageNVS &operator=(const StorageNVS &) = delete;
     StorageNVS &operator=(StorageNVS &&) = delete;
 
+    /**
+     * @brief Set the backend before `begin()`, the default NVS partition is used if not set
+     */
+    bool setBackend(std::shared_ptr<StorageNVSBackend> backend);
     bool begin();
+    bool del();
 
     bool sendEvent(const Event &event, EventFuture *future = nullptr);
 
     bool setLocalParam(const Key &key, const Value &value, const void *sender = nullptr, EventFuture *future = nullptr);
     bool getLocalParam(const Key &key, Value &value);
+    Transaction beginTransaction()
+    {
+        return Transaction(*this);
+    }
+    /**
+     * @brief Get an immutable snapshot of all local parameters. It never blocks and is not affected by later updates.
+     */
+    ParamSnapshot getLocalParamSnapshot() const
+    {
+        return _params_snapshot.load();
+    }
+    /**
+     * @brief Only the default namespace is loaded by `begin()`, the others are loaded on the first access of their
+     *        keys. Registering a namespace is only needed to limit its flash usage, `quota_bytes` of 0 means no limit.
+     */
+    bool registerNamespace(const std::string &name_space, size_t quota_bytes = 0);
+    bool loadNamespace(const std::string &name_space);
+    size_t getNamespaceUsage(const std::string &name_space);
+    /**
+     * @brief Erase the default namespace and all registered or loaded namespaces
+     */
     bool eraseNVS(const void *sender = nullptr, EventFuture *future = nullptr);
+    /**
+     * @brief Write all pending parameters to NVS immediately, should be called before power off or restart
+     */
+    bool flush(const void *sender = nullptr, EventFuture *future = nullptr);
+    /**
+     * @brief Same as `flush()`, but block until all pending parameters are written or the timeout expires
+     */
+    bool flush(std::chrono::milliseconds timeout);
+
+    Stats getStats();
+    void resetStats();
+
+    static Key makeKey(const std::string &name_space, const Key &key)
+    {
+        return name_space + NAMESPACE_SEPARATOR + key;
+    }
+    static Blob makeBlob(const void *data, size_t size);
+    static std::string valueToString(const Value &value);
 
     boost::signals2::connection connectEventSignal(EventSignal::slot_type slot);
+    /**
+     * @brief Connect a slot which is only called for the `UpdateNVS` events of the given key
+     */
+    boost::signals2::connection subscribe(const Key &key, EventSignal::slot_type slot);
+    KeyId internKey(const Key &key);
 
     static StorageNVS &requestInstance()
     {
@@ -64,26 +166,70 @@ public:
 
 private:
     using EventPromise = std::promise<bool>;
+    using Clock = std::chrono::steady_clock;
+
+    struct NamespaceInfo {
+        size_t quota_bytes;
+        bool is_loaded;
+    };
+
     struct EventWrapper {
         Event event;
         std::shared_ptr<EventPromise> promise;
+        Clock::time_point send_time;
     };
 
     StorageNVS() = default;
 
     bool processEvent(const Event &event);
+    void emitEventSignals(const Event &event);
     bool doEventOperationUpdateNVS(const Key &key);
     bool doEventOperationUpdateParam();
     bool doEventOperationEraseNVS();
-
-    std::map<Key, Value> _local_params;
+    bool doEventOperationFlush();
+    bool doEventOperationCommitTransaction(const Event &event);
+    bool doEventOperationLoadNamespace(const std::string &name_space);
+    bool loadNamespaceOfKey(const Key &key);
+    bool readNamespace(const std::string &name_space, ParamMap &params);
+    bool checkNamespaceQuotas(const ParamMap &params, const std::vector<Key> &keys);
+    std::vector<std::string> getLoadedNamespaces();
+    bool commitTransaction(const ParamMap &params, const void *sender, EventFuture *future);
+    bool recoverJournal();
+    // The new parameters are dropped if `modifier` returns false
+    bool updateLocalParams(const std::function<bool(ParamMap &params)> &modifier);
+    bool writeKeysToNVS(const std::set<Key> &keys, bool use_journal = false);
+    void updateQueueLatency(Clock::time_point send_time);
+    Clock::time_point getFlushDeadline() const;
+    EventSignal *getKeySignal(KeyId key_id);
+
+    std::shared_ptr<StorageNVSBackend> _backend;
+
+    // Readers load the published snapshot, writers copy it and publish a new one under `_params_mutex`
+    std::atomic<ParamSnapshot> _params_snapshot = std::make_shared<const ParamMap>();
     std::mutex _params_mutex;
 
     std::queue<EventWrapper> _event_queue;
     std::mutex _event_mutex;
     std::condition_variable _event_cv;
     boost::thread _event_thread;
+    bool _event_thread_need_exit = false;
     EventSignal _event_signal;
+
+    std::unordered_map<Key, KeyId> _key_ids;
+    std::vector<std::unique_ptr<EventSignal>> _key_signals;  // Indexed by `key_id - 1`, created on subscription
+    std::mutex _keys_mutex;
+
+    std::map<std::string, NamespaceInfo> _namespaces;   // Other namespaces than the default one
+    std::mutex _namespaces_mutex;
+
+    // Only accessed by the event thread
+    std::set<Key> _dirty_keys;
+    std::map<Key, uint8_t> _nvs_layouts;    // How each key is currently stored in NVS
+    Clock::time_point _dirty_first_time;
+    Clock::time_point _dirty_last_time;
+
+    Stats _stats = {};
+    std::mutex _stats_mutex;
 };
 
 } // namespace esp_brookesia::services
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "esp_err.h"
+
+namespace esp_brookesia::services {
+
+/**
+ * @brief Key-value store used by `StorageNVS`. It follows the NVS model: items are typed, grouped in namespaces and
+ *        only guaranteed to be persistent after `commit()`. All functions are called from the storage thread.
+ *
+ *        Missing namespaces (when opened read-only) and missing keys are reported as `ESP_ERR_NOT_FOUND`.
+ */
+class StorageNVSBackend {
+public:
+    using Handle = uint32_t;
+    static constexpr size_t KEY_LEN_MAX = 15;
+
+    enum class Type : uint8_t {
+        I32,
+        I64,
+        U8,
+        U32,
+        Str,    // `len` never includes a terminator
+        Blob,
+    };
+
+    struct Entry {
+        std::string key;
+        Type type;
+    };
+
+    virtual ~StorageNVSBackend() = default;
+
+    virtual esp_err_t init() = 0;
+    virtual esp_err_t deinit() = 0;
+
+    virtual esp_err_t open(const char *name_space, bool read_only, Handle &handle) = 0;
+    virtual void close(Handle handle) = 0;
+    virtual esp_err_t commit(Handle handle) = 0;
+
+    virtual esp_err_t set(Handle handle, const char *key, Type type, const void *data, size_t len) = 0;
+    /**
+     * @brief Read an item. If `data` is `nullptr`, only its length is returned in `len`, otherwise `len` is the size
+     *        of `data` on input and the item length on output.
+     */
+    virtual esp_err_t get(Handle handle, const char *key, Type type, void *data, size_t &len) = 0;
+    virtual esp_err_t eraseKey(Handle handle, const char *key) = 0;
+    virtual esp_err_t eraseAll(Handle handle) = 0;
+    virtual esp_err_t listEntries(const char *name_space, std::vector<Entry> &entries) = 0;
+};
+
+} // namespace esp_brookesia::services
@@ -0,0 +1,348 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "private/esp_brookesia_service_storage_nvs_utils.hpp"
+#include "esp_brookesia_service_storage_nvs_file_backend.hpp"
+
+/**
+ * File layout: magic(u32), then for each namespace: name_len(u8), name, item_num(u32), and for each item:
+ * key_len(u8), key, type(u8), data_len(u32), data
+ */
+#define FILE_MAGIC                  (0x564E5342)    // "BSNV"
+#define FILE_TEMP_SUFFIX            ".tmp"
+
+namespace esp_brookesia::services {
+
+static void append_bytes(std::vector<uint8_t> &buffer, const void *data, size_t len)
+{
+    auto bytes = static_cast<const uint8_t *>(data);
+    buffer.insert(buffer.end(), bytes, bytes + len);
+}
+
+template <typename T>
+static void append_value(std::vector<uint8_t> &buffer, T value)
+{
+    append_bytes(buffer, &value, sizeof(value));
+}
+
+template <typename T>
+static bool read_value(const std::vector<uint8_t> &buffer, size_t &pos, T &value)
+{
+    if (pos + sizeof(value) > buffer.size()) {
+        return false;
+    }
+    memcpy(&value, buffer.data() + pos, sizeof(value));
+    pos += sizeof(value);
+
+    return true;
+}
+
+static bool read_string(const std::vector<uint8_t> &buffer, size_t &pos, std::string &str)
+{
+    uint8_t len = 0;
+    if (!read_value(buffer, pos, len) || (pos + len > buffer.size())) {
+        return false;
+    }
+    str.assign(reinterpret_cast<const char *>(buffer.data() + pos), len);
+    pos += len;
+
+    return true;
+}
+
+esp_err_t StorageNVSFileBackend::init()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_is_initialized) {
+        return ESP_OK;
+    }
+
+    if (!_config.path.empty()) {
+        _namespaces.clear();
+        if (!load()) {
+            ESP_UTILS_LOGE("Invalid file(%s), discard it", _config.path.c_str());
+            _namespaces.clear();
+        }
+    }
+    _is_initialized = true;
+
+    return ESP_OK;
+}
+
+esp_err_t StorageNVSFileBackend::deinit()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Without a file, the items are kept until the backend is destroyed, like a flash which is never powered off
+    if (!_config.path.empty()) {
+        _namespaces.clear();
+    }
+    _handles.clear();
+    _is_initialized = false;
+
+    return ESP_OK;
+}
+
+esp_err_t StorageNVSFileBackend::open(const char *name_space, bool read_only, Handle &handle)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_is_initialized, ESP_ERR_INVALID_STATE, "Not initialized");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (name_space != nullptr) && (strlen(name_space) <= KEY_LEN_MAX), ESP_ERR_INVALID_ARG, "Invalid namespace"
+    );
+
+    if (_namespaces.find(name_space) == _namespaces.end()) {
+        if (read_only) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        // Like NVS, a new namespace takes one entry
+        _namespaces[name_space] = {};
+        simulateEntryWrites(1);
+    }
+
+    handle = _next_handle++;
+    _handles[handle] = OpenedHandle{name_space, read_only};
+
+    return ESP_OK;
+}
+
+void StorageNVSFileBackend::close(Handle handle)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _handles.erase(handle);
+}
+
+esp_err_t StorageNVSFileBackend::commit(Handle handle)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_handles.find(handle) != _handles.end(), ESP_ERR_INVALID_ARG, "Invalid handle");
+
+    _stats.commits++;
+    _stats.simulated_us += _config.commit_us;
+    if (_config.commit_us > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(_config.commit_us));
+    }
+    if (!_config.path.empty()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(save(), ESP_FAIL, "Save file(%s) failed", _config.path.c_str());
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t StorageNVSFileBackend::set(Handle handle, const char *key, Type type, const void *data, size_t len)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (key != nullptr) && (strlen(key) > 0) && (strlen(key) <= KEY_LEN_MAX), ESP_ERR_INVALID_ARG, "Invalid key"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN((data != nullptr) || (len == 0), ESP_ERR_INVALID_ARG, "Invalid data");
+
+    auto name_space = getNamespace(handle, true);
+    ESP_UTILS_CHECK_NULL_RETURN(name_space, ESP_ERR_INVALID_ARG, "Invalid handle");
+
+    auto &item = (*name_space)[key];
+    item.type = type;
+    item.data.assign(static_cast<const uint8_t *>(data), static_cast<const uint8_t *>(data) + len);
+
+    // Primitive items fit in one entry, strings and blobs take one header entry plus their data entries
+    bool is_variable = (type == Type::Str) || (type == Type::Blob);
+    _stats.sets++;
+    _stats.bytes_written += len;
+    simulateEntryWrites(is_variable ? (1 + (len + ENTRY_SIZE - 1) / ENTRY_SIZE) : 1);
+
+    return ESP_OK;
+}
+
+esp_err_t StorageNVSFileBackend::get(Handle handle, const char *key, Type type, void *data, size_t &len)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto name_space = getNamespace(handle, false);
+    ESP_UTILS_CHECK_NULL_RETURN(name_space, ESP_ERR_INVALID_ARG, "Invalid handle");
+
+    _stats.gets++;
+    auto it = name_space->find(key);
+    if ((it == name_space->end()) || (it->second.type != type)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    auto &item_data = it->second.data;
+    if (data != nullptr) {
+        memcpy(data, item_data.data(), std::min(len, item_data.size()));
+    }
+    len = item_data.size();
+
+    return ESP_OK;
+}
+
+esp_err_t StorageNVSFileBackend::eraseKey(Handle handle, const char *key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto name_space = getNamespace(handle, true);
+    ESP_UTILS_CHECK_NULL_RETURN(name_space, ESP_ERR_INVALID_ARG, "Invalid handle");
+
+    _stats.erases++;
+    // NVS only marks the entries as erased in the page header, which is not simulated
+    return (name_space->erase(key) > 0) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t StorageNVSFileBackend::eraseAll(Handle handle)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto name_space = getNamespace(handle, true);
+    ESP_UTILS_CHECK_NULL_RETURN(name_space, ESP_ERR_INVALID_ARG, "Invalid handle");
+
+    _stats.erases += name_space->size();
+    name_space->clear();
+
+    return ESP_OK;
+}
+
+esp_err_t StorageNVSFileBackend::listEntries(const char *name_space, std::vector<Entry> &entries)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _namespaces.find(name_space);
+    if (it == _namespaces.end()) {
+        return ESP_OK;
+    }
+    for (auto &[key, item] : it->second) {
+        entries.push_back(Entry{key, item.type});
+    }
+
+    return ESP_OK;
+}
+
+StorageNVSFileBackend::Stats StorageNVSFileBackend::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _stats;
+}
+
+void StorageNVSFileBackend::resetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _stats = {};
+}
+
+bool StorageNVSFileBackend::load()
+{
+    FILE *file = fopen(_config.path.c_str(), "rb");
+    if (file == nullptr) {
+        // Nothing has been committed yet
+        return true;
+    }
+
+    std::vector<uint8_t> buffer;
+    uint8_t chunk[256];
+    size_t read_len = 0;
+    while ((read_len = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        append_bytes(buffer, chunk, read_len);
+    }
+    fclose(file);
+
+    size_t pos = 0;
+    uint32_t magic = 0;
+    ESP_UTILS_CHECK_FALSE_RETURN(read_value(buffer, pos, magic) && (magic == FILE_MAGIC), false, "Invalid magic");
+    while (pos < buffer.size()) {
+        std::string name;
+        uint32_t item_num = 0;
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            read_string(buffer, pos, name) && read_value(buffer, pos, item_num), false, "Invalid namespace"
+        );
+
+        auto &name_space = _namespaces[name];
+        for (uint32_t i = 0; i < item_num; i++) {
+            std::string key;
+            uint8_t type = 0;
+            uint32_t data_len = 0;
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                read_string(buffer, pos, key) && read_value(buffer, pos, type) &&
+                read_value(buffer, pos, data_len) && (pos + data_len <= buffer.size()), false, "Invalid item"
+            );
+            auto &item = name_space[key];
+            item.type = static_cast<Type>(type);
+            item.data.assign(buffer.begin() + pos, buffer.begin() + pos + data_len);
+            pos += data_len;
+        }
+    }
+
+    return true;
+}
+
+bool StorageNVSFileBackend::save()
+{
+    std::vector<uint8_t> buffer;
+    append_value<uint32_t>(buffer, FILE_MAGIC);
+    for (auto &[name, name_space] : _namespaces) {
+        append_value<uint8_t>(buffer, name.size());
+        append_bytes(buffer, name.data(), name.size());
+        append_value<uint32_t>(buffer, name_space.size());
+        for (auto &[key, item] : name_space) {
+            append_value<uint8_t>(buffer, key.size());
+            append_bytes(buffer, key.data(), key.size());
+            append_value<uint8_t>(buffer, static_cast<uint8_t>(item.type));
+            append_value<uint32_t>(buffer, item.data.size());
+            append_bytes(buffer, item.data.data(), item.data.size());
+        }
+    }
+
+    // Write a temporary file and rename it, so an interrupted save keeps the previous content
+    auto temp_path = _config.path + FILE_TEMP_SUFFIX;
+    FILE *file = fopen(temp_path.c_str(), "wb");
+    ESP_UTILS_CHECK_NULL_RETURN(file, false, "Open file(%s) failed", temp_path.c_str());
+    bool is_written = (fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size());
+    is_written = (fclose(file) == 0) && is_written;
+    ESP_UTILS_CHECK_FALSE_RETURN(is_written, false, "Write file(%s) failed", temp_path.c_str());
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        rename(temp_path.c_str(), _config.path.c_str()) == 0, false, "Rename file(%s) failed", temp_path.c_str()
+    );
+
+    return true;
+}
+
+StorageNVSFileBackend::Namespace *StorageNVSFileBackend::getNamespace(Handle handle, bool need_write)
+{
+    auto handle_it = _handles.find(handle);
+    if ((handle_it == _handles.end()) || (need_write && handle_it->second.read_only)) {
+        return nullptr;
+    }
+
+    auto it = _namespaces.find(handle_it->second.name_space);
+    return (it == _namespaces.end()) ? nullptr : &it->second;
+}
+
+void StorageNVSFileBackend::simulateEntryWrites(size_t entry_num)
+{
+    uint64_t cost_us = static_cast<uint64_t>(entry_num) * _config.entry_write_us;
+
+    _stats.entry_writes += entry_num;
+    _page_used_entries += entry_num;
+    while (_page_used_entries >= PAGE_ENTRY_NUM) {
+        _page_used_entries -= PAGE_ENTRY_NUM;
+        _stats.page_erases++;
+        cost_us += _config.page_erase_us;
+    }
+    _stats.simulated_us += cost_us;
+
+    if (cost_us > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(cost_us));
+    }
+}
+
+} // namespace esp_brookesia::services
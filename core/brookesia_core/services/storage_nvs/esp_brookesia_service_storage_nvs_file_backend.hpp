@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "esp_brookesia_service_storage_nvs_backend.hpp"
+
+namespace esp_brookesia::services {
+
+/**
+ * @brief Backend which keeps the items in memory and saves them to a file on every commit. It can simulate the cost
+ *        of NVS flash writes, so the service can be profiled off-target (e.g. with the `linux` target).
+ *
+ *        Like NVS, every item write appends 32-byte entries to the current page, and a page is erased once all its
+ *        entries are used.
+ */
+class StorageNVSFileBackend: public StorageNVSBackend {
+public:
+    static constexpr size_t ENTRY_SIZE = 32;
+    static constexpr size_t PAGE_ENTRY_NUM = 126;
+
+    struct Config {
+        std::string path;           // Empty to keep the items in memory only, they survive `deinit()`
+        uint32_t entry_write_us;    // Simulated cost of writing one entry
+        uint32_t page_erase_us;     // Simulated cost of erasing one page
+        uint32_t commit_us;         // Simulated cost of one commit, excluding the file write
+    };
+
+    struct Stats {
+        uint32_t sets;
+        uint32_t gets;
+        uint32_t erases;
+        uint32_t commits;
+        uint32_t entry_writes;
+        uint32_t page_erases;
+        uint64_t bytes_written;
+        uint64_t simulated_us;      // Total simulated flash time
+    };
+
+    StorageNVSFileBackend(const Config &config): _config(config) {}
+
+    esp_err_t init() override;
+    esp_err_t deinit() override;
+
+    esp_err_t open(const char *name_space, bool read_only, Handle &handle) override;
+    void close(Handle handle) override;
+    esp_err_t commit(Handle handle) override;
+
+    esp_err_t set(Handle handle, const char *key, Type type, const void *data, size_t len) override;
+    esp_err_t get(Handle handle, const char *key, Type type, void *data, size_t &len) override;
+    esp_err_t eraseKey(Handle handle, const char *key) override;
+    esp_err_t eraseAll(Handle handle) override;
+    esp_err_t listEntries(const char *name_space, std::vector<Entry> &entries) override;
+
+    Stats getStats();
+    void resetStats();
+
+private:
+    struct Item {
+        Type type;
+        std::vector<uint8_t> data;
+    };
+    using Namespace = std::map<std::string, Item>;
+    struct OpenedHandle {
+        std::string name_space;
+        bool read_only;
+    };
+
+    bool load();
+    bool save();
+    Namespace *getNamespace(Handle handle, bool need_write);
+    void simulateEntryWrites(size_t entry_num);
+
+    Config _config = {};
+    std::mutex _mutex;
+    bool _is_initialized = false;
+    std::map<std::string, Namespace> _namespaces;
+    std::map<Handle, OpenedHandle> _handles;
+    Handle _next_handle = 1;
+    size_t _page_used_entries = 0;
+    Stats _stats = {};
+};
+
+} // namespace esp_brookesia::services
@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "private/esp_brookesia_service_storage_nvs_utils.hpp"
+#include "esp_brookesia_service_storage_nvs_flash_backend.hpp"
+
+#define STORAGE_NVS_PARTITION_NAME          NVS_DEFAULT_PART_NAME
+
+namespace esp_brookesia::services {
+
+static esp_err_t to_backend_err(esp_err_t ret)
+{
+    return (ret == ESP_ERR_NVS_NOT_FOUND) ? ESP_ERR_NOT_FOUND : ret;
+}
+
+esp_err_t StorageNVSFlashBackend::init()
+{
+    esp_err_t ret = nvs_flash_init();
+    if ((ret == ESP_ERR_NVS_NO_FREE_PAGES) || (ret == ESP_ERR_NVS_NEW_VERSION_FOUND)) {
+        ESP_UTILS_CHECK_ERROR_RETURN(nvs_flash_erase(), ret, "Erase NVS flash failed");
+        ret = nvs_flash_init();
+    }
+
+    return ret;
+}
+
+esp_err_t StorageNVSFlashBackend::deinit()
+{
+    // The partition is shared with other components (e.g. Wi-Fi), keep it initialized
+    return ESP_OK;
+}
+
+esp_err_t StorageNVSFlashBackend::open(const char *name_space, bool read_only, Handle &handle)
+{
+    nvs_handle_t nvs_handle = 0;
+    esp_err_t ret = nvs_open(name_space, read_only ? NVS_READONLY : NVS_READWRITE, &nvs_handle);
+    handle = static_cast<Handle>(nvs_handle);
+
+    return to_backend_err(ret);
+}
+
+void StorageNVSFlashBackend::close(Handle handle)
+{
+    nvs_close(handle);
+}
+
+esp_err_t StorageNVSFlashBackend::commit(Handle handle)
+{
+    return nvs_commit(handle);
+}
+
+esp_err_t StorageNVSFlashBackend::set(Handle handle, const char *key, Type type, const void *data, size_t len)
+{
+    switch (type) {
+    case Type::I32: {
+        int32_t value = 0;
+        memcpy(&value, data, std::min(len, sizeof(value)));
+        return nvs_set_i32(handle, key, value);
+    }
+    case Type::I64: {
+        int64_t value = 0;
+        memcpy(&value, data, std::min(len, sizeof(value)));
+        return nvs_set_i64(handle, key, value);
+    }
+    case Type::U8: {
+        uint8_t value = 0;
+        memcpy(&value, data, std::min(len, sizeof(value)));
+        return nvs_set_u8(handle, key, value);
+    }
+    case Type::U32: {
+        uint32_t value = 0;
+        memcpy(&value, data, std::min(len, sizeof(value)));
+        return nvs_set_u32(handle, key, value);
+    }
+    case Type::Str:
+        return nvs_set_str(handle, key, std::string(static_cast<const char *>(data), len).c_str());
+    case Type::Blob:
+        return nvs_set_blob(handle, key, (len > 0) ? data : "", len);
+    default:
+        break;
+    }
+
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t StorageNVSFlashBackend::get(Handle handle, const char *key, Type type, void *data, size_t &len)
+{
+    esp_err_t ret = ESP_ERR_INVALID_ARG;
+    switch (type) {
+    case Type::I32: {
+        int32_t value = 0;
+        ret = nvs_get_i32(handle, key, &value);
+        if ((ret == ESP_OK) && (data != nullptr)) {
+            memcpy(data, &value, std::min(len, sizeof(value)));
+        }
+        len = sizeof(value);
+        break;
+    }
+    case Type::I64: {
+        int64_t value = 0;
+        ret = nvs_get_i64(handle, key, &value);
+        if ((ret == ESP_OK) && (data != nullptr)) {
+            memcpy(data, &value, std::min(len, sizeof(value)));
+        }
+        len = sizeof(value);
+        break;
+    }
+    case Type::U8: {
+        uint8_t value = 0;
+        ret = nvs_get_u8(handle, key, &value);
+        if ((ret == ESP_OK) && (data != nullptr)) {
+            memcpy(data, &value, std::min(len, sizeof(value)));
+        }
+        len = sizeof(value);
+        break;
+    }
+    case Type::U32: {
+        uint32_t value = 0;
+        ret = nvs_get_u32(handle, key, &value);
+        if ((ret == ESP_OK) && (data != nullptr)) {
+            memcpy(data, &value, std::min(len, sizeof(value)));
+        }
+        len = sizeof(value);
+        break;
+    }
+    case Type::Str: {
+        // The length reported by NVS includes the terminator
+        size_t str_len = 0;
+        ret = nvs_get_str(handle, key, nullptr, &str_len);
+        if ((ret == ESP_OK) && (data != nullptr) && (str_len > 1)) {
+            std::string value(str_len - 1, '\0');
+            ret = nvs_get_str(handle, key, value.data(), &str_len);
+            memcpy(data, value.data(), std::min(len, value.size()));
+        }
+        len = (str_len > 0) ? (str_len - 1) : 0;
+        break;
+    }
+    case Type::Blob:
+        if (data == nullptr) {
+            len = 0;
+        }
+        ret = nvs_get_blob(handle, key, data, &len);
+        break;
+    default:
+        break;
+    }
+
+    return to_backend_err(ret);
+}
+
+esp_err_t StorageNVSFlashBackend::eraseKey(Handle handle, const char *key)
+{
+    return to_backend_err(nvs_erase_key(handle, key));
+}
+
+esp_err_t StorageNVSFlashBackend::eraseAll(Handle handle)
+{
+    return nvs_erase_all(handle);
+}
+
+esp_err_t StorageNVSFlashBackend::listEntries(const char *name_space, std::vector<Entry> &entries)
+{
+    nvs_iterator_t it = NULL;
+    esp_err_t ret = nvs_entry_find(STORAGE_NVS_PARTITION_NAME, name_space, NVS_TYPE_ANY, &it);
+    while (ret == ESP_OK) {
+        nvs_entry_info_t info;
+        ret = nvs_entry_info(it, &info);
+        if (ret != ESP_OK) {
+            break;
+        }
+
+        Type type;
+        bool is_supported = true;
+        switch (info.type) {
+        case NVS_TYPE_I32:
+            type = Type::I32;
+            break;
+        case NVS_TYPE_I64:
+            type = Type::I64;
+            break;
+        case NVS_TYPE_U8:
+            type = Type::U8;
+            break;
+        case NVS_TYPE_U32:
+            type = Type::U32;
+            break;
+        case NVS_TYPE_STR:
+            type = Type::Str;
+            break;
+        case NVS_TYPE_BLOB:
+            type = Type::Blob;
+            break;
+        default:
+            is_supported = false;
+            break;
+        }
+        if (is_supported) {
+            entries.push_back(Entry{info.key, type});
+        } else {
+            ESP_UTILS_LOGI("Skip key(%s): type(%d)", info.key, static_cast<int>(info.type));
+        }
+        ret = nvs_entry_next(&it);
+    }
+    nvs_release_iterator(it);
+
+    // The iterator reports the end of the entries as not found
+    return (ret == ESP_ERR_NVS_NOT_FOUND) ? ESP_OK : ret;
+}
+
+} // namespace esp_brookesia::services
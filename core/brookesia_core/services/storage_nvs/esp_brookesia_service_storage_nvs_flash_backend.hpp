@@ -0,0 +1,31 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include "esp_brookesia_service_storage_nvs_backend.hpp"
+
+namespace esp_brookesia::services {
+
+/**
+ * @brief Backend of the default NVS partition, used by `StorageNVS` unless another backend is set
+ */
+class StorageNVSFlashBackend: public StorageNVSBackend {
+public:
+    esp_err_t init() override;
+    esp_err_t deinit() override;
+
+    esp_err_t open(const char *name_space, bool read_only, Handle &handle) override;
+    void close(Handle handle) override;
+    esp_err_t commit(Handle handle) override;
+
+    esp_err_t set(Handle handle, const char *key, Type type, const void *data, size_t len) override;
+    esp_err_t get(Handle handle, const char *key, Type type, void *data, size_t &len) override;
+    esp_err_t eraseKey(Handle handle, const char *key) override;
+    esp_err_t eraseAll(Handle handle) override;
+    esp_err_t listEntries(const char *name_space, std::vector<Entry> &entries) override;
+};
+
+} // namespace esp_brookesia::services
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <cstring>
+#include <utility>
 #include "esp_brookesia_systems_internal.h"
 #if !ESP_BROOKESIA_BASE_CORE_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
@@ -97,12 +98,77 @@ bool Context::sendDataUpdateEvent(void *param)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(checkCoreInitialized(), false, "Context is not initialized");
 
-    ESP_UTILS_CHECK_FALSE_RETURN(lv_obj_send_event(_event_obj.get(), _data_update_event_code, param) == LV_RES_OK, false,
-                                 "Send data update event failed");
+    // All the data is updated, restore the partial state after, in case this is sent by a listener
+    bool is_partially_updated = std::exchange(_is_data_partially_updated, false);
+    bool ret = (lv_obj_send_event(_event_obj.get(), _data_update_event_code, param) == LV_RES_OK);
+    _is_data_partially_updated = is_partially_updated;
+    ESP_UTILS_CHECK_FALSE_RETURN(ret, false, "Send data update event failed");
 
     return true;
 }
 
+bool Context::sendDataUpdateEvent(const std::vector<DataRange> &updated_ranges, void *param)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(checkCoreInitialized(), false, "Context is not initialized");
+
+    if (updated_ranges.empty()) {
+        ESP_UTILS_LOGD("No data updated, skip");
+        return true;
+    }
+    ESP_UTILS_LOGD("Send data update event for %d ranges", static_cast<int>(updated_ranges.size()));
+
+    bool is_partially_updated = std::exchange(_is_data_partially_updated, true);
+    auto last_updated_ranges = std::exchange(_data_updated_ranges, updated_ranges);
+    bool ret = (lv_obj_send_event(_event_obj.get(), _data_update_event_code, param) == LV_RES_OK);
+    _is_data_partially_updated = is_partially_updated;
+    _data_updated_ranges = std::move(last_updated_ranges);
+    ESP_UTILS_CHECK_FALSE_RETURN(ret, false, "Send data update event failed");
+
+    return true;
+}
+
+bool Context::postDataUpdateEvent(void *param)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(checkCoreInitialized(), false, "Context is not initialized");
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _event.postEvent(this, _data_update_event_id, param), false, "Post data update event failed"
+    );
+
+    return true;
+}
+
+bool Context::checkDataUpdated(const void *data, size_t size) const
+{
+    if (!_is_data_partially_updated) {
+        return true;
+    }
+
+    // The widgets are calibrated against the screen size and use the default fonts, the rest of the display data
+    // (background, container styles) is only used by the display itself
+    if (checkDataRangesOverlap(&_data.screen_size, sizeof(_data.screen_size)) ||
+            checkDataRangesOverlap(&_data.display.text, sizeof(_data.display.text))) {
+        return true;
+    }
+
+    return checkDataRangesOverlap(data, size);
+}
+
+bool Context::checkDataRangesOverlap(const void *data, size_t size) const
+{
+    auto begin = static_cast<const uint8_t *>(data);
+    auto end = begin + size;
+    for (auto &range : _data_updated_ranges) {
+        auto range_begin = static_cast<const uint8_t *>(range.data);
+        auto range_end = range_begin + range.size;
+        if ((begin < range_end) && (range_begin < end)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool Context::registerNavigateEventCallback(lv_event_cb_t callback, void *user_data)
 {
     ESP_UTILS_CHECK_NULL_RETURN(callback, false, "Invalid callback function");
@@ -134,6 +200,18 @@ bool Context::sendNavigateEvent(Manager::NavigateType type)
     return true;
 }
 
+bool Context::postNavigateEvent(Manager::NavigateType type)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(checkCoreInitialized(), false, "Context is not initialized");
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _event.postEvent(this, Event::ID::NAVIGATION, reinterpret_cast<void *>(static_cast<intptr_t>(type))), false,
+        "Post navigate event failed"
+    );
+
+    return true;
+}
+
 bool Context::registerAppEventCallback(lv_event_cb_t callback, void *user_data)
 {
     ESP_UTILS_CHECK_NULL_RETURN(callback, false, "Invalid callback function");
@@ -220,6 +298,33 @@ bool Context::begin(void)
     _navigate_event_code = navigate_event_code;
     _app_event_code = app_event_code;
 
+    // The posted events are dispatched in the next LVGL timer run, the timer is paused while the queue is empty
+    _event_dispatch_timer = std::make_unique<LvTimer>([this](void *) {
+        _event.dispatchPendingEvents();
+        if (_event.getPendingEventsCount() == 0) {
+            _event_dispatch_timer->pause();
+        }
+    }, 0, nullptr);
+    ESP_UTILS_CHECK_FALSE_GOTO(_event_dispatch_timer->isValid(), err, "Create event dispatch timer failed");
+    ESP_UTILS_CHECK_FALSE_GOTO(_event_dispatch_timer->pause(), err, "Pause event dispatch timer failed");
+    _event.setDispatchRequestCallback([this]() {
+        ESP_UTILS_CHECK_FALSE_EXIT(_event_dispatch_timer->resume(), "Resume event dispatch timer failed");
+    });
+    // The posted events are forwarded to the LVGL event object, so the listeners are the same as for the sent ones
+    _data_update_event_id = _event.getFreeEventID();
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        _event.registerEvent(this, onDataUpdateEventPosted, _data_update_event_id), err,
+        "Register posted data update event failed"
+    );
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        _event.setCoalescePolicy(_data_update_event_id, Event::CoalescePolicy::KEEP_LAST), err,
+        "Set data update event coalesce policy failed"
+    );
+    ESP_UTILS_CHECK_FALSE_GOTO(
+        _event.registerEvent(this, onNavigateEventPosted, Event::ID::NAVIGATION), err,
+        "Register posted navigate event failed"
+    );
+
     // Initialize cores
     ESP_UTILS_CHECK_FALSE_GOTO(_display.begin(), err, "Begin core display failed");
     ESP_UTILS_CHECK_FALSE_GOTO(_manager.begin(), err, "Begin core manager failed");
@@ -256,6 +361,11 @@ bool Context::del(void)
         ret = false;
     }
 
+    _event.setDispatchRequestCallback(nullptr);
+    _event.unregisterEvent(this, onDataUpdateEventPosted, _data_update_event_id);
+    _event.unregisterEvent(this, onNavigateEventPosted, Event::ID::NAVIGATION);
+    _event.clearPendingEvents();
+    _event_dispatch_timer.reset();
     _display_device = nullptr;
     _touch_device = nullptr;
     _free_event_code = _LV_EVENT_LAST;
@@ -263,6 +373,7 @@ bool Context::del(void)
     _data_update_event_code = _LV_EVENT_LAST;
     _navigate_event_code = _LV_EVENT_LAST;
     _app_event_code = _LV_EVENT_LAST;
+    _data_update_event_id = Event::ID::CUSTOM;
 
     return ret;
 }
@@ -277,10 +388,16 @@ bool Context::calibrateCoreData(Data &data)
     };
 
     /* Basic */
-    ESP_UTILS_CHECK_NULL_RETURN(data.name, false, "Context name is invalid");
-    ESP_UTILS_CHECK_FALSE_RETURN(_display.calibrateCoreObjectSize(display_size, data.screen_size), false,
-                                 "Invalid Context screen_size");
+    const char *error = tryCalibrateCoreData(display_size, data);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "%s", error);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateCoreDataResource(data), false, "Invalid Context resources");
 
+    return true;
+}
+
+bool Context::calibrateCoreDataResource(Data &data)
+{
     // Display
     ESP_UTILS_CHECK_FALSE_RETURN(_display.calibrateCoreData(data.display), false, "Invalid Context display data");
 
@@ -297,6 +414,9 @@ void Context::onCoreDataUpdateEventCallback(lv_event_t *event)
     core = (Context *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(core, "Invalid core object");
 
+    if (!core->checkDataUpdated(core->_data.display)) {
+        return;
+    }
     ESP_UTILS_CHECK_FALSE_EXIT(core->_display.updateByNewData(), "Context display update failed");
 }
 
@@ -331,4 +451,21 @@ void Context::onCoreNavigateEventCallback(lv_event_t *event)
     }
 }
 
+bool Context::onDataUpdateEventPosted(const Event::HandlerData &data)
+{
+    auto core = static_cast<Context *>(data.object);
+    ESP_UTILS_CHECK_FALSE_RETURN(core->sendDataUpdateEvent(data.param), false, "Send data update event failed");
+
+    return true;
+}
+
+bool Context::onNavigateEventPosted(const Event::HandlerData &data)
+{
+    auto core = static_cast<Context *>(data.object);
+    auto type = static_cast<Manager::NavigateType>(reinterpret_cast<intptr_t>(data.param));
+    ESP_UTILS_CHECK_FALSE_RETURN(core->sendNavigateEvent(type), false, "Send navigate event failed");
+
+    return true;
+}
+
 } // namespace esp_brookesia::systems::base
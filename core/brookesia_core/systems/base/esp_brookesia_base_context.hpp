@@ -6,7 +6,9 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include "style/esp_brookesia_gui_style.hpp"
+#include "lvgl/esp_brookesia_lv_timer.hpp"
 #include "esp_brookesia_base_display.hpp"
 #include "esp_brookesia_base_manager.hpp"
 #include "esp_brookesia_base_event.hpp"
@@ -20,6 +22,7 @@ public:
         gui::StyleSize screen_size;
         Display::Data display;
         Manager::Data manager;
+        bool operator==(const Data &) const = default;
     };
 
     enum class AppEventType : uint8_t {
@@ -35,6 +38,12 @@ public:
         void *data;
     };
 
+    // A part of the system data (e.g. the data of a widget in the active stylesheet) which has been updated
+    struct DataRange {
+        const void *data;
+        size_t size;
+    };
+
     Context(const Context &) = delete;
     Context(Context &&) = delete;
     Context &operator=(const Context &) = delete;
@@ -90,6 +99,27 @@ public:
     bool registerDateUpdateEventCallback(lv_event_cb_t callback, void *user_data);
     bool unregisterDateUpdateEventCallback(lv_event_cb_t callback, void *user_data);
     bool sendDataUpdateEvent(void *param = nullptr);
+    /**
+     * @brief Send the data update event for the given parts of the data only, the listeners can skip their work if
+     *        `checkDataUpdated()` returns false. It can't be posted, as coalescing would drop the ranges of the
+     *        earlier updates.
+     */
+    bool sendDataUpdateEvent(const std::vector<DataRange> &updated_ranges, void *param = nullptr);
+    /**
+     * @brief Send the data update event in the next LVGL timer run, the posts before then are coalesced into one
+     *        with the last `param`
+     */
+    bool postDataUpdateEvent(void *param = nullptr);
+    /**
+     * @brief Check if the data has been updated by the data update event being sent, always true out of the event.
+     *        Any data is updated along with the screen size or the default fonts, which every widget depends on.
+     */
+    bool checkDataUpdated(const void *data, size_t size) const;
+    template <typename T>
+    bool checkDataUpdated(const T &data) const
+    {
+        return checkDataUpdated(&data, sizeof(T));
+    }
     lv_event_code_t getDataUpdateEventCode(void) const
     {
         return _data_update_event_code;
@@ -98,6 +128,11 @@ public:
     bool registerNavigateEventCallback(lv_event_cb_t callback, void *user_data);
     bool unregisterNavigateEventCallback(lv_event_cb_t callback, void *user_data);
     bool sendNavigateEvent(Manager::NavigateType type);
+    /**
+     * @brief Send the navigate event in the next LVGL timer run. The posts are not coalesced, since two `BACK`
+     *        events are not the same as one.
+     */
+    bool postNavigateEvent(Manager::NavigateType type);
     lv_event_code_t getNavigateEventCode(void) const
     {
         return _navigate_event_code;
@@ -157,6 +192,24 @@ protected:
     bool begin(void);
     bool del(void);
     bool calibrateCoreData(Data &data);
+    bool calibrateCoreDataResource(Data &data);
+
+    /**
+     * @brief Calibrate the core data except its fonts without logging, so it can be done at build time
+     *
+     * @return `nullptr` if success, otherwise the description of the first invalid item
+     */
+    static constexpr const char *tryCalibrateCoreData(const gui::StyleSize &display_size, Data &data)
+    {
+        if (data.name == nullptr) {
+            return "Context name is invalid";
+        }
+        if (!Display::tryCalibrateCoreObjectSize(display_size, data.screen_size)) {
+            return "Invalid Context screen_size";
+        }
+
+        return nullptr;
+    }
 
     // Context
     const Data &_data;
@@ -170,13 +223,20 @@ protected:
 private:
     static void onCoreDataUpdateEventCallback(lv_event_t *event);
     static void onCoreNavigateEventCallback(lv_event_t *event);
+    static bool onDataUpdateEventPosted(const Event::HandlerData &data);
+    static bool onNavigateEventPosted(const Event::HandlerData &data);
+    bool checkDataRangesOverlap(const void *data, size_t size) const;
 
     // Event
     uint32_t _free_event_code;
     esp_brookesia::gui::LvObjSharedPtr _event_obj;
     lv_event_code_t _data_update_event_code;
+    bool _is_data_partially_updated = false;
+    std::vector<DataRange> _data_updated_ranges;
     lv_event_code_t _navigate_event_code;
     lv_event_code_t _app_event_code;
+    gui::LvTimerUniquePtr _event_dispatch_timer;
+    Event::ID _data_update_event_id = Event::ID::CUSTOM;
 };
 
 } // namespace esp_brookesia::systems::base
@@ -309,21 +309,6 @@ void Display::loadLvScreens(void)
     lv_scr_load(_lv_main_screen);
 }
 
-bool Display::calibrateStyleSizeInternal(StyleSize &target) const
-{
-    if (target.width == StyleSize::LENGTH_AUTO) {
-        target.width = LV_SIZE_CONTENT;
-    }
-    if (target.height == StyleSize::LENGTH_AUTO) {
-        target.height = LV_SIZE_CONTENT;
-    }
-    if (target.radius == StyleSize::RADIUS_CIRCLE) {
-        target.radius = LV_RADIUS_CIRCLE;
-    }
-
-    return true;
-}
-
 const lv_font_t *Display::getFontBySize(int size_px) const
 {
     ESP_UTILS_CHECK_VALUE_RETURN(
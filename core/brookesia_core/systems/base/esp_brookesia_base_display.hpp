@@ -33,22 +33,27 @@ public:
     static constexpr int DEBUG_STYLES_NUM = 6;
 
     struct Data {
-        struct {
+        struct Background {
             gui::StyleColor color;
             gui::StyleImage wallpaper_image_resource;
+            bool operator==(const Background &) const = default;
         } background;
-        struct {
+        struct Text {
             uint8_t default_fonts_num;
             gui::StyleFont default_fonts[gui::StyleFont::FONT_SIZE_NUM];
+            bool operator==(const Text &) const = default;
         } text;
-        struct {
-            struct {
+        struct Container {
+            struct DebugStyle {
                 uint8_t outline_width;
                 gui::StyleColor outline_color;
+                bool operator==(const DebugStyle &) const = default;
             } styles[DEBUG_STYLES_NUM];
+            bool operator==(const Container &) const = default;
         } container;
         // std::array<DisplayFonts, gui::STYLE_FONT_TYPE_MAX> fonts{};
         // std::array<DisplayDebugStyles, DEBUG_STYLES_NUM> debug_styles{};
+        bool operator==(const Data &) const = default;
     };
 
     /**
@@ -116,6 +121,35 @@ public:
     bool calibrateCoreFont(const esp_brookesia::gui::StyleSize *parent, esp_brookesia::gui::StyleFont &target) const;
     bool calibrateCoreIconImage(const esp_brookesia::gui::StyleImage &target) const;
 
+    /**
+     * @brief Constexpr counterparts of `calibrateCoreObjectSize()` which don't log, so the sizes of a stylesheet for
+     *        a known resolution can be calibrated at build time.
+     *
+     * @return `true` if success, otherwise `false`
+     */
+    static constexpr bool tryCalibrateCoreObjectSize(
+        const esp_brookesia::gui::StyleSize &parent, esp_brookesia::gui::StyleSize &target
+    )
+    {
+        return (target.tryCalibrate(parent) == esp_brookesia::gui::StyleSize::CalibrateResult::OK) &&
+               calibrateStyleSizeInternal(target);
+    }
+    static constexpr bool tryCalibrateCoreObjectSize(
+        const esp_brookesia::gui::StyleSize &parent, esp_brookesia::gui::StyleSize &target,
+        bool check_width, bool check_height
+    )
+    {
+        return (target.tryCalibrate(parent, check_width, check_height) ==
+                esp_brookesia::gui::StyleSize::CalibrateResult::OK) && calibrateStyleSizeInternal(target);
+    }
+    static constexpr bool tryCalibrateCoreObjectSize(
+        const esp_brookesia::gui::StyleSize &parent, esp_brookesia::gui::StyleSize &target, bool allow_zero
+    )
+    {
+        return (target.tryCalibrate(parent, allow_zero) == esp_brookesia::gui::StyleSize::CalibrateResult::OK) &&
+               calibrateStyleSizeInternal(target);
+    }
+
 protected:
     Context &_system_context;
     const Data &_core_data;
@@ -149,7 +183,20 @@ private:
     void saveLvScreens(void);
     void loadLvScreens(void);
 
-    bool calibrateStyleSizeInternal(esp_brookesia::gui::StyleSize &target) const;
+    static constexpr bool calibrateStyleSizeInternal(esp_brookesia::gui::StyleSize &target)
+    {
+        if (target.width == esp_brookesia::gui::StyleSize::LENGTH_AUTO) {
+            target.width = LV_SIZE_CONTENT;
+        }
+        if (target.height == esp_brookesia::gui::StyleSize::LENGTH_AUTO) {
+            target.height = LV_SIZE_CONTENT;
+        }
+        if (target.radius == esp_brookesia::gui::StyleSize::RADIUS_CIRCLE) {
+            target.radius = LV_RADIUS_CIRCLE;
+        }
+
+        return true;
+    }
     const lv_font_t *getFontBySize(int size) const;
     const lv_font_t *getFontByHeight(int height, int *size_px) const;
 
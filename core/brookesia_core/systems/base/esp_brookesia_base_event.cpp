@@ -4,7 +4,11 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <algorithm>
+#include <atomic>
 #include "esp_brookesia_systems_internal.h"
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+#   include "esp_timer.h"
+#endif
 #if !ESP_BROOKESIA_BASE_EVENT_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
 #endif
@@ -15,9 +19,78 @@ using namespace std;
 
 namespace esp_brookesia::systems::base {
 
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+enum TraceSlotState : uint32_t {
+    TRACE_SLOT_EMPTY = 0,
+    TRACE_SLOT_CLAIMED,
+    TRACE_SLOT_READY,
+};
+
+// A slot is claimed once and keeps its key, so the hot path never takes a lock
+struct TraceSlot {
+    std::atomic<uint32_t> state;
+    Event::ID id;
+    Event::Handler handler;
+    std::atomic<uint32_t> calls;
+    std::atomic<uint32_t> total_us;     // Wraps after about 71 minutes of accumulated execution time
+    std::atomic<uint32_t> max_us;
+};
+
+static TraceSlot trace_slots[ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE];
+static std::atomic<uint32_t> trace_dropped_calls = 0;
+static std::atomic<uint32_t> trace_slow_handler_us = ESP_BROOKESIA_BASE_EVENT_TRACE_SLOW_HANDLER_US;
+
+static TraceSlot *get_trace_slot(Event::ID id, Event::Handler handler)
+{
+    size_t hash = (reinterpret_cast<uintptr_t>(handler) >> 2) * 31 + static_cast<size_t>(id);
+    for (size_t i = 0; i < ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE; i++) {
+        auto &slot = trace_slots[(hash + i) % ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE];
+        uint32_t state = slot.state.load(std::memory_order_acquire);
+        if (state == TRACE_SLOT_EMPTY) {
+            if (slot.state.compare_exchange_strong(state, TRACE_SLOT_CLAIMED, std::memory_order_acq_rel)) {
+                slot.id = id;
+                slot.handler = handler;
+                slot.state.store(TRACE_SLOT_READY, std::memory_order_release);
+
+                return &slot;
+            }
+        }
+        // A slot being claimed by another thread is skipped, so a racing first call may take two slots
+        if ((state == TRACE_SLOT_READY) && (slot.id == id) && (slot.handler == handler)) {
+            return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+static void trace_handler(Event::ID id, Event::Handler handler, uint32_t elapsed_us)
+{
+    auto slot = get_trace_slot(id, handler);
+    if (slot == nullptr) {
+        trace_dropped_calls.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        slot->calls.fetch_add(1, std::memory_order_relaxed);
+        slot->total_us.fetch_add(elapsed_us, std::memory_order_relaxed);
+        uint32_t max_us = slot->max_us.load(std::memory_order_relaxed);
+        while ((elapsed_us > max_us) &&
+                !slot->max_us.compare_exchange_weak(max_us, elapsed_us, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint32_t threshold_us = trace_slow_handler_us.load(std::memory_order_relaxed);
+    if ((threshold_us > 0) && (elapsed_us > threshold_us)) {
+        ESP_UTILS_LOGW("Slow handler(0x%p) for ID(%d): %d us, budget %d us", handler, static_cast<int>(id),
+                       static_cast<int>(elapsed_us), static_cast<int>(threshold_us));
+    }
+}
+#endif
+
 Event::Event():
     _free_event_id(ID::CUSTOM)
 {
+    _pending_events.reserve(ESP_BROOKESIA_BASE_EVENT_QUEUE_SIZE);
+    _dispatching_events.reserve(ESP_BROOKESIA_BASE_EVENT_QUEUE_SIZE);
 }
 
 Event::~Event()
@@ -42,8 +115,11 @@ Event::ID operator++(Event::ID &id, int)
 void Event::reset(void)
 {
     _free_event_id = ID::CUSTOM;
-    _event_handlers.clear();
+    _handlers_count = 0;
+    _id_slots.clear();
+    _object_ids.clear();
     _available_event_ids.clear();
+    clearPendingEvents();
 }
 
 bool Event::registerEvent(void *object, Handler handler, ID id, void *user_data)
@@ -51,9 +127,17 @@ bool Event::registerEvent(void *object, Handler handler, ID id, void *user_data)
     ESP_UTILS_LOGD("Register event for object(0x%p) ID(%d) handler(0x%p), user_data(0x%p)", object, static_cast<int>(id),
                    handler, user_data);
     ESP_UTILS_CHECK_NULL_RETURN(handler, false, "Invalid handler");
+    ESP_UTILS_CHECK_FALSE_RETURN(static_cast<int>(id) >= 0, false, "Invalid ID(%d)", static_cast<int>(id));
 
-    auto &handlers_for_object = _event_handlers[object];
-    handlers_for_object[id].emplace_back(handler, user_data);
+    auto &slot = getIDSlot(id);
+    auto &handlers = slot.object_handlers[object];
+    if (handlers.empty()) {
+        addObjectID(object, id);
+    }
+    handlers.push_back({handler, user_data});
+    // The ID is used again, its stale entry in `_available_event_ids` will be skipped
+    slot.is_available = false;
+    _handlers_count++;
 
     return true;
 }
@@ -62,28 +146,32 @@ bool Event::sendEvent(void *object, ID id, void *param) const
 {
     ESP_UTILS_LOGD("Send event for object(0x%p) ID(%d) param(0x%p)", object, static_cast<int>(id), param);
 
-    auto object_it = _event_handlers.find(object);
-    if (object_it == _event_handlers.end()) {
-        return true;
-    }
-
-    auto &handlers_for_object = object_it->second;
-    auto handler_it = handlers_for_object.find(id);
-    if (handler_it == handlers_for_object.end()) {
-        return true;
-    }
-
     HandlerData data = {};
     bool ret = true;
-    for (auto &handler_data_pair : handler_it->second) {
-        auto &handler = handler_data_pair.first;
-        auto &user_data = handler_data_pair.second;
-        if (handler == nullptr) {
+    // Handlers may register or unregister events, so look the bucket up again on every loop
+    for (size_t i = 0; ; i++) {
+        auto slot = findIDSlot(id);
+        if (slot == nullptr) {
+            break;
+        }
+        auto handlers_it = slot->object_handlers.find(object);
+        if ((handlers_it == slot->object_handlers.end()) || (i >= handlers_it->second.size())) {
+            break;
+        }
+        HandlerEntry entry = handlers_it->second[i];
+        if (entry.handler == nullptr) {
             ESP_UTILS_LOGE("Handler is nullptr");
             continue;
         }
-        data = {id, object, param, user_data};
-        if (!handler(data)) {
+        data = {id, object, param, entry.user_data};
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+        int64_t start_us = esp_timer_get_time();
+#endif
+        bool is_handled = entry.handler(data);
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+        trace_handler(id, entry.handler, static_cast<uint32_t>(esp_timer_get_time() - start_us));
+#endif
+        if (!is_handled) {
             ret = false;
             ESP_UTILS_LOGE("Do handler failed");
         }
@@ -96,28 +184,32 @@ void Event::unregisterEvent(void *object)
 {
     ESP_UTILS_LOGD("Unregister event for object(0x%p)", object);
 
-    auto object_it = _event_handlers.find(object);
-    if (object_it == _event_handlers.end()) {
+    // The object may be deleted after this, so its params must not be dispatched
+    cancelPendingEvents([&](const PendingEvent & event) {
+        return event.object == object;
+    });
+
+    auto object_it = _object_ids.find(object);
+    if (object_it == _object_ids.end()) {
         return;
     }
 
-    // Save event IDs to be removed
-    std::unordered_set<ID> event_ids;
-    for (auto &id_handlers_pair : object_it->second) {
-        event_ids.insert(id_handlers_pair.first);
-    }
+    // Take the IDs out first, so removing the handlers doesn't update the reverse index
+    std::vector<ID> event_ids = std::move(object_it->second);
+    _object_ids.erase(object_it);
 
     // Remove handlers for the given object
     size_t handlers_count = getEventHandlersCount();
-    _event_handlers.erase(object_it);
+    for (const auto &id : event_ids) {
+        removeHandlers(id, object, [](const HandlerEntry &) {
+            return true;
+        });
+    }
     ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
 
     // Add removed event IDs to available event IDs
     for (const auto &id : event_ids) {
-        if (!checkUsedEventID(id)) {
-            ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
-            _available_event_ids.insert(id);
-        }
+        recycleEventID(id);
     }
 }
 
@@ -125,172 +217,386 @@ void Event::unregisterEvent(void *object, ID id)
 {
     ESP_UTILS_LOGD("Unregister event for object(0x%p) ID(%d)", object, static_cast<int>(id));
 
-    auto object_it = _event_handlers.find(object);
-    if (object_it == _event_handlers.end()) {
+    size_t removed_count = removeHandlers(id, object, [](const HandlerEntry &) {
+        return true;
+    });
+    if (removed_count == 0) {
         return;
     }
-
-    auto &handlers_for_object = object_it->second;
-    size_t handlers_count = getEventHandlersCount();
-    if (handlers_for_object.erase(id) == 0) {
-        return;
-    }
-    if (handlers_for_object.empty()) {
-        _event_handlers.erase(object_it);
-    }
-    ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
+    ESP_UTILS_LOGD("Remove %d event handlers", (int)removed_count);
 
     // Add removed event IDs to available event IDs
-    if (!checkUsedEventID(id)) {
-        ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
-        _available_event_ids.insert(id);
-    }
+    recycleEventID(id);
 }
 
 void Event::unregisterEvent(void *object, Handler handler, ID id)
 {
     ESP_UTILS_LOGD("Unregister event for object(0x%p) ID(%d) handler(0x%p)", object, static_cast<int>(id), handler);
 
-    auto object_it = _event_handlers.find(object);
-    if (object_it == _event_handlers.end()) {
-        return;
-    }
-
-    auto &handlers_for_object = object_it->second;
-    auto handler_it = handlers_for_object.find(id);
-    if (handler_it == handlers_for_object.end()) {
-        return;
-    }
-
-    auto &handlers = handler_it->second;
-    auto it = std::remove_if(handlers.begin(), handlers.end(),
-    [&](const std::pair<Handler, void *> &pair) {
-        return handler == pair.first;
+    size_t removed_count = removeHandlers(id, object, [&](const HandlerEntry & entry) {
+        return entry.handler == handler;
     });
-    if (it == handlers.end()) {
+    if (removed_count == 0) {
         return;
     }
-
-    size_t handlers_count = getEventHandlersCount();
-    handlers.erase(it, handlers.end());
-    if (handlers.empty()) {
-        handlers_for_object.erase(handler_it);
-    }
-    if (handlers_for_object.empty()) {
-        _event_handlers.erase(object_it);
-    }
-    ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
+    ESP_UTILS_LOGD("Remove %d event handlers", (int)removed_count);
 
     // Add removed event IDs to available event IDs
-    if (!checkUsedEventID(id)) {
-        _available_event_ids.insert(id);
-    }
+    recycleEventID(id);
 }
 
 void Event::unregisterEvent(ID id)
 {
     ESP_UTILS_LOGD("Unregister event for ID(%d)", static_cast<int>(id));
 
-    size_t handlers_count = getEventHandlersCount();
-    for (auto &object_handler_pair : _event_handlers) {
-        auto &handlers_for_object = object_handler_pair.second;
-        if (handlers_for_object.find(id) != handlers_for_object.end()) {
-            handlers_for_object.erase(id);
-        }
-    }
-    cleanEmptyHandlers();
-    ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
+    // The ID may be handed out again, so its pending events must not be dispatched
+    cancelPendingEvents([&](const PendingEvent & event) {
+        return event.id == id;
+    });
+
+    size_t removed_count = removeHandlers(id, [](const HandlerEntry &) {
+        return true;
+    });
+    ESP_UTILS_LOGD("Remove %d event handlers", (int)removed_count);
 
     // Add removed event IDs to available event IDs
-    ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
-    _available_event_ids.insert(id);
+    recycleEventID(id);
 }
 
 void Event::unregisterEvent(Handler handler)
 {
     ESP_UTILS_LOGD("Unregister event for handler(0x%p)", handler);
 
-    // Save event IDs to be removed
-    std::unordered_set<ID> event_ids;
     size_t handlers_count = getEventHandlersCount();
-    for (auto &object_handler_pair : _event_handlers) {
-        auto &handlers_for_object = object_handler_pair.second;
-        for (auto &id_handlers_pair : handlers_for_object) {
-            auto &handlers = id_handlers_pair.second;
-            auto it = std::remove_if(handlers.begin(), handlers.end(),
-            [&](const std::pair<Handler, void *> &pair) {
-                return handler == pair.first;
-            });
-            if (it != handlers.end()) {
-                event_ids.insert(id_handlers_pair.first);
-                handlers.erase(it, handlers.end());
-            }
+    auto match = [&](const HandlerEntry & entry) {
+        return entry.handler == handler;
+    };
+    for (size_t index = 0; index < _id_slots.size(); index++) {
+        ID id = static_cast<ID>(index);
+        if (removeHandlers(id, match) > 0) {
+            // Add removed event IDs to available event IDs
+            recycleEventID(id);
         }
     }
-    cleanEmptyHandlers();
     ESP_UTILS_LOGD("Remove %d event handlers", (int)(handlers_count - getEventHandlersCount() ));
+}
 
-    // Add removed event IDs to available event IDs
-    for (const auto &id : event_ids) {
-        if (!checkUsedEventID(id)) {
-            ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
-            _available_event_ids.insert(id);
+Event::ID Event::getFreeEventID()
+{
+    while (!_available_event_ids.empty()) {
+        ID id = _available_event_ids.back();
+        _available_event_ids.pop_back();
+
+        // Skip the IDs which have been registered again since they were recycled
+        auto &slot = getIDSlot(id);
+        if (slot.is_available) {
+            slot = {};
+            return id;
         }
     }
+
+    ID id = ++_free_event_id;
+    // Reserve the slot now, so the ID can be recycled even if no handler is registered for it
+    getIDSlot(id);
+
+    return id;
 }
 
-bool Event::checkUsedEventID(ID id) const
+bool Event::postEvent(void *object, ID id, void *param)
 {
-    for (auto &object_handler_pair : _event_handlers) {
-        auto &handlers_for_object = object_handler_pair.second;
-        if (handlers_for_object.find(id) != handlers_for_object.end()) {
+    ESP_UTILS_LOGD("Post event for object(0x%p) ID(%d) param(0x%p)", object, static_cast<int>(id), param);
+
+    auto slot = findIDSlot(id);
+    if ((slot != nullptr) && (slot->policy != CoalescePolicy::KEEP_ALL)) {
+        // Only the events still in the queue can be coalesced, the ones being dispatched are left untouched
+        for (auto it = _pending_events.rbegin(); it != _pending_events.rend(); ++it) {
+            if ((it->object != object) || (it->id != id) || it->is_cancelled) {
+                continue;
+            }
+            it->param = (slot->policy == CoalescePolicy::MERGE) ? slot->merger(it->param, param) : param;
+            ESP_UTILS_LOGD("Coalesce with the pending event, param(0x%p)", it->param);
+
             return true;
         }
     }
-    return false;
+
+    if (_pending_events.size() >= ESP_BROOKESIA_BASE_EVENT_QUEUE_SIZE) {
+        if (_is_dispatching) {
+            ESP_UTILS_LOGW("Event queue is full while dispatching, send the event directly");
+            return sendEvent(object, id, param);
+        }
+        ESP_UTILS_LOGD("Event queue is full, dispatch the pending events first");
+        dispatchPendingEvents();
+    }
+
+    bool is_first = _pending_events.empty();
+    _pending_events.push_back({object, id, param, false});
+    // The events posted by the handlers are dispatched in the next round, which is already requested
+    if (is_first && !_is_dispatching && _dispatch_request_callback) {
+        _dispatch_request_callback();
+    }
+
+    return true;
 }
 
-Event::ID Event::getFreeEventID()
+bool Event::setCoalescePolicy(ID id, CoalescePolicy policy, Merger merger)
 {
-    if (!_available_event_ids.empty()) {
-        ID id = *_available_event_ids.begin();
-        _available_event_ids.erase(id);
+    ESP_UTILS_LOGD("Set coalesce policy(%d) for ID(%d) merger(0x%p)", static_cast<int>(policy), static_cast<int>(id),
+                   merger);
+    ESP_UTILS_CHECK_FALSE_RETURN(static_cast<int>(id) >= 0, false, "Invalid ID(%d)", static_cast<int>(id));
+    ESP_UTILS_CHECK_FALSE_RETURN((policy != CoalescePolicy::MERGE) || (merger != nullptr), false,
+                                 "Merge policy requires a merger");
 
-        return id;
+    auto &slot = getIDSlot(id);
+    slot.policy = policy;
+    slot.merger = merger;
+
+    return true;
+}
+
+size_t Event::dispatchPendingEvents(void)
+{
+    if (_is_dispatching || _pending_events.empty()) {
+        return 0;
     }
 
-    return ++_free_event_id;
+    ESP_UTILS_LOGD("Dispatch %d pending events", static_cast<int>(_pending_events.size()));
+
+    // Swap the queues, so the handlers can post events for the next round
+    _is_dispatching = true;
+    _dispatching_events.swap(_pending_events);
+    size_t dispatched_count = 0;
+    // The handlers may cancel the events behind, so index the queue again on every loop
+    for (size_t i = 0; i < _dispatching_events.size(); i++) {
+        PendingEvent event = _dispatching_events[i];
+        if (event.is_cancelled) {
+            continue;
+        }
+        sendEvent(event.object, event.id, event.param);
+        dispatched_count++;
+    }
+    _dispatching_events.clear();
+    _is_dispatching = false;
+
+    // Request another round for the events posted by the handlers
+    if (!_pending_events.empty() && _dispatch_request_callback) {
+        _dispatch_request_callback();
+    }
+
+    return dispatched_count;
 }
 
-size_t Event::getEventHandlersCount(void) const
+void Event::clearPendingEvents(void)
 {
-    size_t count = 0;
-    for (auto &object_handler_pair : _event_handlers) {
-        for (auto &id_handlers_pair : object_handler_pair.second) {
-            count += id_handlers_pair.second.size();
+    ESP_UTILS_LOGD("Clear pending events");
+
+    _pending_events.clear();
+    for (auto &event : _dispatching_events) {
+        event.is_cancelled = true;
+    }
+}
+
+bool Event::getHandlerTraces(std::vector<HandlerTrace> &traces)
+{
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+    traces.clear();
+    for (auto &slot : trace_slots) {
+        if ((slot.state.load(std::memory_order_acquire) != TRACE_SLOT_READY) ||
+                (slot.calls.load(std::memory_order_relaxed) == 0)) {
+            continue;
         }
+        traces.push_back({
+            slot.id, slot.handler, slot.calls.load(std::memory_order_relaxed),
+            slot.total_us.load(std::memory_order_relaxed), slot.max_us.load(std::memory_order_relaxed)
+        });
     }
 
-    return count;
+    return true;
+#else
+    traces.clear();
+
+    return false;
+#endif
 }
 
-void Event::cleanEmptyHandlers()
+void Event::dumpHandlerTraces(void)
 {
-    for (auto it = _event_handlers.begin(); it != _event_handlers.end(); ) {
-        auto &id_map = it->second;
-        for (auto id_it = id_map.begin(); id_it != id_map.end(); ) {
-            if (id_it->second.empty()) {
-                id_it = id_map.erase(id_it);
-            } else {
-                ++id_it;
-            }
+    std::vector<HandlerTrace> traces;
+    ESP_UTILS_CHECK_FALSE_EXIT(
+        getHandlerTraces(traces), "Handler tracing is disabled, enable `ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE` first"
+    );
+
+    // The most expensive handlers first
+    std::sort(traces.begin(), traces.end(), [](const HandlerTrace & a, const HandlerTrace & b) {
+        return a.total_us > b.total_us;
+    });
+    ESP_UTILS_LOGI("Event handler traces: %d handlers", static_cast<int>(traces.size()));
+    for (const auto &trace : traces) {
+        ESP_UTILS_LOGI(
+            "\tID(%d) handler(0x%p): calls(%d), total(%d us), avg(%d us), max(%d us)", static_cast<int>(trace.id),
+            trace.handler, static_cast<int>(trace.calls), static_cast<int>(trace.total_us),
+            static_cast<int>(trace.total_us / trace.calls), static_cast<int>(trace.max_us)
+        );
+    }
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+    uint32_t dropped_calls = trace_dropped_calls.load(std::memory_order_relaxed);
+    if (dropped_calls > 0) {
+        ESP_UTILS_LOGW("%d calls are not traced, increase `ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE`",
+                       static_cast<int>(dropped_calls));
+    }
+#endif
+}
+
+void Event::resetHandlerTraces(void)
+{
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+    // Only the counters are cleared, the claimed slots keep their handlers
+    for (auto &slot : trace_slots) {
+        slot.calls.store(0, std::memory_order_relaxed);
+        slot.total_us.store(0, std::memory_order_relaxed);
+        slot.max_us.store(0, std::memory_order_relaxed);
+    }
+    trace_dropped_calls.store(0, std::memory_order_relaxed);
+#endif
+}
+
+void Event::setSlowHandlerThreshold(uint32_t threshold_us)
+{
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+    trace_slow_handler_us.store(threshold_us, std::memory_order_relaxed);
+#else
+    (void)threshold_us;
+#endif
+}
+
+Event::IDSlot &Event::getIDSlot(ID id)
+{
+    size_t index = static_cast<size_t>(id);
+    if (index >= _id_slots.size()) {
+        _id_slots.resize(index + 1);
+    }
+
+    return _id_slots[index];
+}
+
+const Event::IDSlot *Event::findIDSlot(ID id) const
+{
+    size_t index = static_cast<size_t>(id);
+
+    return (index < _id_slots.size()) ? &_id_slots[index] : nullptr;
+}
+
+void Event::addObjectID(void *object, ID id)
+{
+    _object_ids[object].push_back(id);
+}
+
+void Event::removeObjectID(void *object, ID id)
+{
+    auto object_it = _object_ids.find(object);
+    if (object_it == _object_ids.end()) {
+        return;
+    }
+
+    auto &event_ids = object_it->second;
+    auto id_it = std::find(event_ids.begin(), event_ids.end(), id);
+    if (id_it != event_ids.end()) {
+        // The order doesn't matter, swap with the last one to avoid shifting
+        *id_it = event_ids.back();
+        event_ids.pop_back();
+    }
+    if (event_ids.empty()) {
+        _object_ids.erase(object_it);
+    }
+}
+
+size_t Event::removeHandlers(ID id, void *object, const std::function<bool(const HandlerEntry &)> &match)
+{
+    size_t index = static_cast<size_t>(id);
+    if (index >= _id_slots.size()) {
+        return 0;
+    }
+
+    auto &object_handlers = _id_slots[index].object_handlers;
+    auto handlers_it = object_handlers.find(object);
+    if (handlers_it == object_handlers.end()) {
+        return 0;
+    }
+
+    auto &handlers = handlers_it->second;
+    size_t handlers_count = handlers.size();
+    handlers.erase(std::remove_if(handlers.begin(), handlers.end(), match), handlers.end());
+    size_t removed_count = handlers_count - handlers.size();
+    if (handlers.empty()) {
+        object_handlers.erase(handlers_it);
+        removeObjectID(object, id);
+    }
+    _handlers_count -= removed_count;
+
+    return removed_count;
+}
+
+size_t Event::removeHandlers(ID id, const std::function<bool(const HandlerEntry &)> &match)
+{
+    auto slot = findIDSlot(id);
+    if (slot == nullptr) {
+        return 0;
+    }
+
+    // Collect the objects first, as the empty buckets are erased
+    std::vector<void *> objects;
+    objects.reserve(slot->object_handlers.size());
+    for (const auto &[object, handlers] : slot->object_handlers) {
+        objects.push_back(object);
+    }
+    size_t removed_count = 0;
+    for (auto object : objects) {
+        removed_count += removeHandlers(id, object, match);
+    }
+
+    return removed_count;
+}
+
+void Event::recycleEventID(ID id)
+{
+    // Only the IDs returned by `getFreeEventID()` can be recycled
+    if ((id <= ID::CUSTOM) || (id > _free_event_id) || checkUsedEventID(id)) {
+        return;
+    }
+
+    auto &slot = getIDSlot(id);
+    if (slot.is_available) {
+        return;
+    }
+    ESP_UTILS_LOGD("Recycle event ID(%d)", static_cast<int>(id));
+    slot.is_available = true;
+    _available_event_ids.push_back(id);
+}
+
+void Event::cancelPendingEvents(const std::function<bool(const PendingEvent &)> &match)
+{
+    for (auto &event : _pending_events) {
+        if (match(event)) {
+            event.is_cancelled = true;
         }
-        if (id_map.empty()) {
-            it = _event_handlers.erase(it);
-        } else {
-            ++it;
+    }
+    for (auto &event : _dispatching_events) {
+        if (match(event)) {
+            event.is_cancelled = true;
         }
     }
 }
 
+bool Event::checkUsedEventID(ID id) const
+{
+    auto slot = findIDSlot(id);
+
+    return (slot != nullptr) && !slot->object_handlers.empty();
+}
+
+size_t Event::getEventHandlersCount(void) const
+{
+    return _handlers_count;
+}
+
 } // namespace esp_brookesia::systems::base
@@ -5,9 +5,9 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <functional>
 #include <memory>
 
@@ -28,6 +28,21 @@ public:
         void *user_data;
     };
     using Handler = bool (*)(const HandlerData &data);
+    // How the events posted for the same object and ID are coalesced before they are dispatched
+    enum class CoalescePolicy {
+        KEEP_ALL,
+        KEEP_LAST,
+        MERGE,
+    };
+    using Merger = void *(*)(void *pending_param, void *new_param);
+    using DispatchRequestCallback = std::function<void(void)>;
+    struct HandlerTrace {
+        ID id;
+        Handler handler;
+        uint32_t calls;
+        uint32_t total_us;
+        uint32_t max_us;
+    };
 
     Event();
     ~Event();
@@ -43,16 +58,80 @@ public:
 
     ID getFreeEventID();
 
+    /* Deferred dispatch, must be called with the LVGL lock held like `sendEvent()` */
+    /**
+     * @brief Queue the event, it will be dispatched by `dispatchPendingEvents()`. The `param` must stay valid until
+     *        then.
+     */
+    bool postEvent(void *object, ID id, void *param = nullptr);
+    bool setCoalescePolicy(ID id, CoalescePolicy policy, Merger merger = nullptr);
+    size_t dispatchPendingEvents(void);
+    void clearPendingEvents(void);
+    size_t getPendingEventsCount(void) const
+    {
+        return _pending_events.size();
+    }
+    /**
+     * @brief Set the callback called when the queue becomes non-empty, used to schedule `dispatchPendingEvents()`
+     */
+    void setDispatchRequestCallback(DispatchRequestCallback callback)
+    {
+        _dispatch_request_callback = std::move(callback);
+    }
+
+    /* Handler tracing, only recorded when `ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE` is enabled */
+    /**
+     * @brief Get the traces of all the handlers called by any `Event`, return false if tracing is disabled
+     */
+    static bool getHandlerTraces(std::vector<HandlerTrace> &traces);
+    static void dumpHandlerTraces(void);
+    static void resetHandlerTraces(void);
+    /**
+     * @brief Set the execution time above which a handler call logs a warning, 0 to disable it
+     */
+    static void setSlowHandlerThreshold(uint32_t threshold_us);
+
 private:
-    using HandlerList = std::vector<std::pair<Handler, void *>>;
+    struct HandlerEntry {
+        Handler handler;
+        void *user_data;
+    };
+    // Handlers of one ID, bucketed by object, the slot index is the ID itself
+    struct IDSlot {
+        std::unordered_map<void *, std::vector<HandlerEntry>> object_handlers;
+        bool is_available = false;  // Whether the ID is in `_available_event_ids`
+        CoalescePolicy policy = CoalescePolicy::KEEP_ALL;
+        Merger merger = nullptr;
+    };
+    struct PendingEvent {
+        void *object;
+        ID id;
+        void *param;
+        bool is_cancelled;
+    };
 
+    IDSlot &getIDSlot(ID id);
+    const IDSlot *findIDSlot(ID id) const;
+    void addObjectID(void *object, ID id);
+    void removeObjectID(void *object, ID id);
+    size_t removeHandlers(ID id, void *object, const std::function<bool(const HandlerEntry &)> &match);
+    size_t removeHandlers(ID id, const std::function<bool(const HandlerEntry &)> &match);
+    void recycleEventID(ID id);
+    void cancelPendingEvents(const std::function<bool(const PendingEvent &)> &match);
     bool checkUsedEventID(ID id) const;
     size_t getEventHandlersCount(void) const;
-    void cleanEmptyHandlers();
 
     ID _free_event_id;
-    std::unordered_map<void *, std::unordered_map<ID, HandlerList>> _event_handlers;
-    std::unordered_set<ID> _available_event_ids;
+    size_t _handlers_count = 0;
+    std::vector<IDSlot> _id_slots;
+    // Reverse index of the IDs each object has handlers for, one entry per bucket
+    std::unordered_map<void *, std::vector<ID>> _object_ids;
+    std::vector<ID> _available_event_ids;
+    // Deferred dispatch
+    bool _is_dispatching = false;
+    std::vector<PendingEvent> _pending_events;
+    std::vector<PendingEvent> _dispatching_events;
+    DispatchRequestCallback _dispatch_request_callback;
 };
 
 } // namespace esp_brookesia::systems::base
@@ -28,12 +28,15 @@ public:
     };
 
     struct Data {
-        struct {
+        struct App {
             int max_running_num;
+            bool operator==(const App &) const = default;
         } app;
-        struct {
+        struct Flags {
             uint8_t enable_app_save_snapshot: 1;
+            bool operator==(const Flags &) const = default;
         } flags;
+        bool operator==(const Data &) const = default;
     };
 
     using RegistryAppInfo = std::tuple<std::string, std::shared_ptr<App>>;
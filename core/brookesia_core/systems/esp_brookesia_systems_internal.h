@@ -22,6 +22,38 @@
 #   endif
 #endif
 
+#if !defined(ESP_BROOKESIA_BASE_EVENT_QUEUE_SIZE)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_EVENT_QUEUE_SIZE)
+#       define ESP_BROOKESIA_BASE_EVENT_QUEUE_SIZE  CONFIG_ESP_BROOKESIA_BASE_EVENT_QUEUE_SIZE
+#   else
+#       define ESP_BROOKESIA_BASE_EVENT_QUEUE_SIZE  (32)
+#   endif
+#endif
+
+#if !defined(ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE)
+#   if defined(CONFIG_ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE)
+#       define ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE  CONFIG_ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+#   else
+#       define ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE  (0)
+#   endif
+#endif
+#if ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+#   if !defined(ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE)
+#       if defined(CONFIG_ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE)
+#           define ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE  CONFIG_ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE
+#       else
+#           define ESP_BROOKESIA_BASE_EVENT_TRACE_TABLE_SIZE  (64)
+#       endif
+#   endif
+#   if !defined(ESP_BROOKESIA_BASE_EVENT_TRACE_SLOW_HANDLER_US)
+#       if defined(CONFIG_ESP_BROOKESIA_BASE_EVENT_TRACE_SLOW_HANDLER_US)
+#           define ESP_BROOKESIA_BASE_EVENT_TRACE_SLOW_HANDLER_US  CONFIG_ESP_BROOKESIA_BASE_EVENT_TRACE_SLOW_HANDLER_US
+#       else
+#           define ESP_BROOKESIA_BASE_EVENT_TRACE_SLOW_HANDLER_US  (16000)
+#       endif
+#   endif
+#endif
+
 #if ESP_BROOKESIA_BASE_ENABLE_DEBUG_LOG
 #   if !defined(ESP_BROOKESIA_BASE_APP_ENABLE_DEBUG_LOG)
 #       if defined(CONFIG_ESP_BROOKESIA_BASE_APP_ENABLE_DEBUG_LOG)
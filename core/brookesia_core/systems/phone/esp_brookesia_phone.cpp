@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <algorithm>
+#include <vector>
 #include "esp_brookesia_systems_internal.h"
 #if !ESP_BROOKESIA_PHONE_PHONE_ENABLE_DEBUG_LOG
 #   define ESP_BROOKESIA_UTILS_DISABLE_DEBUG_LOG
@@ -19,6 +20,43 @@ namespace esp_brookesia::systems::phone {
 
 const Stylesheet Phone::_default_stylesheet_dark = ESP_BROOKESIA_PHONE_DEFAULT_DARK_STYLESHEET();
 
+/**
+ * @brief Copy the parts of the stylesheet which differ from the active one field by field, return false if all of
+ *        them are copied and should be updated. Only the colors and images differ between a dark and a light
+ *        stylesheet of the same screen size, so the switch only updates the widgets which use them.
+ */
+static bool copy_updated_data(
+    Stylesheet &active, const Stylesheet &stylesheet, std::vector<base::Context::DataRange> &ranges
+)
+{
+    // Every widget is calibrated against the screen size, the default fonts are handled by `checkDataUpdated()`
+    if (active.core.screen_size != stylesheet.core.screen_size) {
+        active = stylesheet;
+        return false;
+    }
+
+    auto copy_if_changed = [&](auto &active_data, const auto &data) {
+        if (active_data != data) {
+            active_data = data;
+            ranges.push_back({&active_data, sizeof(active_data)});
+        }
+    };
+    active.core.name = stylesheet.core.name;
+    // Split, so that only a change of the default fonts updates every widget
+    copy_if_changed(active.core.display.background, stylesheet.core.display.background);
+    copy_if_changed(active.core.display.text, stylesheet.core.display.text);
+    copy_if_changed(active.core.display.container, stylesheet.core.display.container);
+    copy_if_changed(active.core.manager, stylesheet.core.manager);
+    copy_if_changed(active.display.status_bar, stylesheet.display.status_bar);
+    copy_if_changed(active.display.navigation_bar, stylesheet.display.navigation_bar);
+    copy_if_changed(active.display.app_launcher, stylesheet.display.app_launcher);
+    copy_if_changed(active.display.recents_screen, stylesheet.display.recents_screen);
+    copy_if_changed(active.display.flags, stylesheet.display.flags);
+    copy_if_changed(active.manager, stylesheet.manager);
+
+    return true;
+}
+
 Phone::Phone(lv_display_t *display):
     base::Context(_active_stylesheet.core, _display, _manager, display),
     StylesheetManager(),
@@ -144,17 +182,39 @@ bool Phone::addStylesheet(const Stylesheet *stylesheet)
     return true;
 }
 
+bool Phone::addCalibratedStylesheet(const Stylesheet &stylesheet)
+{
+    ESP_UTILS_LOGD("Add phone(0x%p) calibrated stylesheet", this);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        StylesheetManager::addCalibratedStylesheet(stylesheet.core.name, stylesheet.core.screen_size, stylesheet),
+        false, "Failed to add phone calibrated stylesheet"
+    );
+
+    return true;
+}
+
 bool Phone::activateStylesheet(const Stylesheet &stylesheet)
 {
     ESP_UTILS_LOGD("Activate phone(0x%p) stylesheet", this);
 
+    auto last_stylesheet = getStylesheetHandle();
     ESP_UTILS_CHECK_FALSE_RETURN(
         StylesheetManager::activateStylesheet(stylesheet.core.name, stylesheet.core.screen_size),
         false, "Failed to activate phone stylesheet"
     );
+    if (getStylesheetHandle() == last_stylesheet) {
+        ESP_UTILS_LOGD("Stylesheet is already active");
+        return true;
+    }
 
-    if (checkCoreInitialized() && !sendDataUpdateEvent()) {
-        ESP_UTILS_LOGE("Send update data event failed");
+    if (checkCoreInitialized()) {
+        // Only the widgets whose data is changed need to be updated, e.g. when switching between dark and light
+        bool ret = _is_stylesheet_partially_updated ? sendDataUpdateEvent(_stylesheet_updated_ranges) :
+                   postDataUpdateEvent();
+        if (!ret) {
+            ESP_UTILS_LOGE("Send update data event failed");
+        }
     }
 
     return true;
@@ -173,21 +233,39 @@ bool Phone::calibrateStylesheet(const gui::StyleSize &screen_size, Stylesheet &s
 {
     ESP_UTILS_LOGD("Calibrate phone(0x%p) stylesheet", this);
 
-    // Core
-    ESP_UTILS_CHECK_FALSE_RETURN(calibrateCoreData(stylesheet.core), false, "Invalid core data");
+    gui::StyleSize display_size = {};
+    ESP_UTILS_CHECK_FALSE_RETURN(getDisplaySize(display_size), false, "Get display size failed");
 
-    // Display
-    if (!_active_stylesheet.manager.flags.enable_gesture && _active_stylesheet.display.flags.enable_recents_screen) {
+    if (!stylesheet.manager.flags.enable_gesture && stylesheet.display.flags.enable_recents_screen) {
         ESP_UTILS_LOGW("Gesture is disabled, but recents_screen is enabled, disable recents_screen automatically");
-        _active_stylesheet.display.flags.enable_recents_screen = 0;
     }
-    ESP_UTILS_CHECK_FALSE_RETURN(_display.calibrateData(screen_size, stylesheet.display), false, "Invalid display data");
-    ESP_UTILS_CHECK_FALSE_RETURN(_manager.calibrateData(screen_size, _display, stylesheet.manager), false,
-                                 "Invalid manager data");
+    // Same as the calibration at build time, so both give the same stylesheet
+    const char *error = tryCalibrateStylesheet(display_size, stylesheet);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "Invalid stylesheet: %s", error);
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateStylesheetResource(screen_size, stylesheet), false, "Invalid resources");
 
     return true;
 }
 
+bool Phone::calibrateStylesheetResource(const gui::StyleSize &screen_size, Stylesheet &stylesheet)
+{
+    ESP_UTILS_LOGD("Calibrate phone(0x%p) stylesheet resource", this);
+
+    // Fonts and images only exist at runtime
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateCoreDataResource(stylesheet.core), false, "Invalid core data");
+    ESP_UTILS_CHECK_FALSE_RETURN(_display.calibrateDataResource(stylesheet.display), false, "Invalid display data");
+
+    return true;
+}
+
+void Phone::updateActiveStylesheet(const Stylesheet &stylesheet)
+{
+    ESP_UTILS_LOGD("Update phone(0x%p) active stylesheet", this);
+
+    _stylesheet_updated_ranges.clear();
+    _is_stylesheet_partially_updated = copy_updated_data(_active_stylesheet, stylesheet, _stylesheet_updated_ranges);
+}
+
 bool Phone::calibrateScreenSize(gui::StyleSize &size)
 {
     ESP_UTILS_LOGD("Calibrate phone(0x%p) screen size", this);
@@ -7,6 +7,7 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 #include "esp_brookesia_systems_internal.h"
 #include "gui/style/esp_brookesia_gui_stylesheet_manager.hpp"
 #include "esp_brookesia_phone_display.hpp"
@@ -19,6 +20,7 @@ struct Stylesheet {
     base::Context::Data core;
     Display::Data display;
     Manager::Data manager;
+    bool operator==(const Stylesheet &) const = default;
 };
 
 using StylesheetManager = gui::StylesheetManager<Stylesheet>;
@@ -44,11 +46,33 @@ public:
 
     bool addStylesheet(const Stylesheet &stylesheet);
     bool addStylesheet(const Stylesheet *stylesheet);
+    bool addCalibratedStylesheet(const Stylesheet &stylesheet);
     bool activateStylesheet(const Stylesheet &stylesheet);
     bool activateStylesheet(const Stylesheet *stylesheet);
 
     bool calibrateScreenSize(gui::StyleSize &size) override;
 
+    /**
+     * @brief Calibrate all but the fonts and images of a stylesheet without logging, so it can be done at build time
+     *
+     * @param display_size The size of the display
+     * @param stylesheet The stylesheet to calibrate
+     *
+     * @return `nullptr` if success, otherwise the description of the first invalid item
+     */
+    static constexpr const char *tryCalibrateStylesheet(const gui::StyleSize &display_size, Stylesheet &stylesheet);
+    /**
+     * @brief Calibrate a stylesheet for a known display size at build time, the build fails if it is invalid. Add the
+     *        result by `addCalibratedStylesheet()`, which only resolves its fonts and images at runtime.
+     *
+     * @param display_size The size of the display
+     * @param stylesheet The stylesheet to calibrate
+     *
+     * @return The calibrated stylesheet
+     */
+    static consteval Stylesheet calibrateStylesheetAtBuildTime(const gui::StyleSize &display_size,
+            Stylesheet stylesheet);
+
     Display &getDisplay(void)
     {
         return _display;
@@ -60,13 +84,51 @@ public:
 
 private:
     bool calibrateStylesheet(const gui::StyleSize &screen_size, Stylesheet &sheetstyle) override;
+    bool calibrateStylesheetResource(const gui::StyleSize &screen_size, Stylesheet &stylesheet) override;
+    void updateActiveStylesheet(const Stylesheet &stylesheet) override;
 
     Display _display;
     Manager _manager;
+    bool _is_stylesheet_partially_updated = false;
+    std::vector<DataRange> _stylesheet_updated_ranges;
 
     static const Stylesheet _default_stylesheet_dark;
 };
 
+// Not defined, so that calling it from a constant expression stops the build
+void phone_stylesheet_calibration_failed(const char *error);
+
+constexpr const char *Phone::tryCalibrateStylesheet(const gui::StyleSize &display_size, Stylesheet &stylesheet)
+{
+    const char *error = nullptr;
+
+    // Core
+    if ((error = tryCalibrateCoreData(display_size, stylesheet.core)) != nullptr) {
+        return error;
+    }
+
+    // Display
+    if (!stylesheet.manager.flags.enable_gesture) {
+        stylesheet.display.flags.enable_recents_screen = 0;
+    }
+    if ((error = Display::tryCalibrateData(stylesheet.core.screen_size, stylesheet.display)) != nullptr) {
+        return error;
+    }
+
+    // Manager
+    return Manager::tryCalibrateData(stylesheet.core.screen_size, stylesheet.manager);
+}
+
+consteval Stylesheet Phone::calibrateStylesheetAtBuildTime(const gui::StyleSize &display_size, Stylesheet stylesheet)
+{
+    const char *error = tryCalibrateStylesheet(display_size, stylesheet);
+    if (error != nullptr) {
+        phone_stylesheet_calibration_failed(error);
+    }
+
+    return stylesheet;
+}
+
 } // namespace esp_brookesia::systems::phone
 
 using ESP_Brookesia_PhoneStylesheet_t [[deprecated("Use `esp_brookesia::systems::phone::Stylesheet` instead")]] =
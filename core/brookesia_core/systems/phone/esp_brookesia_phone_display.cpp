@@ -352,57 +352,30 @@ bool Display::calibrateData(const gui::StyleSize &screen_size, Display::Data &da
 {
     ESP_UTILS_LOGD("Calibrate data");
 
-    // Initialize the size of flex widgets
-    if (data.flags.enable_app_launcher_flex_size) {
-        data.app_launcher.data.main.y_start = 0;
-        data.app_launcher.data.main.size.flags.enable_height_percent = 0;
-        data.app_launcher.data.main.size.height = screen_size.height;
-    }
-    if (data.flags.enable_recents_screen && data.flags.enable_recents_screen_flex_size) {
-        data.recents_screen.data.main.y_start = 0;
-        data.recents_screen.data.main.size.flags.enable_height_percent = 0;
-        data.recents_screen.data.main.size.height = screen_size.height;
-    }
+    const char *error = tryCalibrateData(screen_size, data);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "%s", error);
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateDataResource(data), false, "Calibrate resource failed");
+
+    return true;
+}
+
+bool Display::calibrateDataResource(Display::Data &data) const
+{
+    ESP_UTILS_LOGD("Calibrate data resource");
 
-    // Status bar
     if (data.flags.enable_status_bar) {
-        ESP_UTILS_CHECK_FALSE_RETURN(StatusBar::calibrateData(screen_size, *this, data.status_bar.data),
+        ESP_UTILS_CHECK_FALSE_RETURN(StatusBar::calibrateDataResource(*this, data.status_bar.data),
                                      false, "Calibrate status bar data failed");
-        if (data.flags.enable_app_launcher_flex_size &&
-                (data.status_bar.visual_mode == StatusBar::VisualMode::SHOW_FIXED)) {
-            data.app_launcher.data.main.y_start += data.status_bar.data.main.size.height;
-            data.app_launcher.data.main.size.height -= data.status_bar.data.main.size.height;
-        }
-        if (data.flags.enable_recents_screen && data.flags.enable_recents_screen_flex_size &&
-                (data.recents_screen.status_bar_visual_mode == StatusBar::VisualMode::SHOW_FIXED)) {
-            data.recents_screen.data.main.y_start += data.status_bar.data.main.size.height;
-            data.recents_screen.data.main.size.height -= data.status_bar.data.main.size.height;
-        }
     }
-    // Navigation bar
     if (data.flags.enable_navigation_bar) {
-        ESP_UTILS_CHECK_FALSE_RETURN(NavigationBar::calibrateData(screen_size, *this, data.navigation_bar.data),
+        ESP_UTILS_CHECK_FALSE_RETURN(NavigationBar::calibrateDataResource(*this, data.navigation_bar.data),
                                      false, "Calibrate navigation bar data failed");
-        if (data.flags.enable_app_launcher_flex_size &&
-                (data.navigation_bar.visual_mode == NavigationBar::VisualMode::SHOW_FIXED)) {
-            ESP_UTILS_CHECK_VALUE_RETURN(data.app_launcher.data.main.y_start + data.navigation_bar.data.main.size.height,
-                                         1, screen_size.height, false, "Invalid app launcher height flex");
-            data.app_launcher.data.main.size.height -= data.navigation_bar.data.main.size.height;
-        }
-        if (data.flags.enable_recents_screen && data.flags.enable_recents_screen_flex_size &&
-                (data.recents_screen.navigation_bar_visual_mode == NavigationBar::VisualMode::SHOW_FIXED)) {
-            ESP_UTILS_CHECK_VALUE_RETURN(data.recents_screen.data.main.y_start + data.recents_screen.data.main.size.height,
-                                         1, screen_size.height, false, "Invalid app launcher height flex");
-            data.recents_screen.data.main.size.height -= data.navigation_bar.data.main.size.height;
-        }
     }
-    // Recents Screen
     if (data.flags.enable_recents_screen) {
-        ESP_UTILS_CHECK_FALSE_RETURN(RecentsScreen::calibrateData(screen_size, *this, data.recents_screen.data),
+        ESP_UTILS_CHECK_FALSE_RETURN(RecentsScreen::calibrateDataResource(*this, data.recents_screen.data),
                                      false, "Calibrate recents_screen data failed");
     }
-    // base::App table
-    ESP_UTILS_CHECK_FALSE_RETURN(AppLauncher::calibrateData(screen_size, *this, data.app_launcher.data),
+    ESP_UTILS_CHECK_FALSE_RETURN(AppLauncher::calibrateDataResource(*this, data.app_launcher.data),
                                  false, "Calibrate app launcher data failed");
 
     return true;
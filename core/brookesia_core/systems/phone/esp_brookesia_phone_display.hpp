@@ -20,31 +20,37 @@ public:
     friend class Manager;
 
     struct Data {
-        struct {
+        struct StatusBarConf {
             StatusBar::Data data;
             StatusBar::VisualMode visual_mode;
+            bool operator==(const StatusBarConf &) const = default;
         } status_bar;
-        struct {
+        struct NavigationBarConf {
             NavigationBar::Data data;
             NavigationBar::VisualMode visual_mode;
+            bool operator==(const NavigationBarConf &) const = default;
         } navigation_bar;
-        struct {
+        struct AppLauncherConf {
             AppLauncherData data;
             gui::StyleImage default_image;
+            bool operator==(const AppLauncherConf &) const = default;
         } app_launcher;
-        struct {
+        struct RecentsScreenConf {
             RecentsScreen::Data data;
             StatusBar::VisualMode status_bar_visual_mode;
             NavigationBar::VisualMode navigation_bar_visual_mode;
+            bool operator==(const RecentsScreenConf &) const = default;
         } recents_screen;
-        struct {
+        struct Flags {
             uint8_t enable_status_bar: 1;
             uint8_t enable_navigation_bar: 1;
             uint8_t enable_app_launcher_flex_size: 1;
             uint8_t enable_recents_screen: 1;
             uint8_t enable_recents_screen_flex_size: 1;
             uint8_t enable_recents_screen_hide_when_no_snapshot: 1; /* Deprecated, use flag in manager instead */
+            bool operator==(const Flags &) const = default;
         } flags;
+        bool operator==(const Data &) const = default;
     };
 
     Display(base::Context &core, const Data &data);
@@ -76,6 +82,11 @@ public:
     }
 
     bool calibrateData(const gui::StyleSize &screen_size, Data &data);
+    // Resolve the fonts and images of the data calibrated by `tryCalibrateData()`
+    bool calibrateDataResource(Data &data) const;
+
+    // Calibrate all but the fonts and images without logging, return the first invalid item or `nullptr`
+    static constexpr const char *tryCalibrateData(const gui::StyleSize &screen_size, Data &data);
 
 private:
     bool begin(void);
@@ -99,6 +110,73 @@ private:
     std::shared_ptr<RecentsScreen> _recents_screen;
 };
 
+constexpr const char *Display::tryCalibrateData(const gui::StyleSize &screen_size, Display::Data &data)
+{
+    const char *error = nullptr;
+
+    // Initialize the size of flex widgets
+    if (data.flags.enable_app_launcher_flex_size) {
+        data.app_launcher.data.main.y_start = 0;
+        data.app_launcher.data.main.size.flags.enable_height_percent = 0;
+        data.app_launcher.data.main.size.height = screen_size.height;
+    }
+    if (data.flags.enable_recents_screen && data.flags.enable_recents_screen_flex_size) {
+        data.recents_screen.data.main.y_start = 0;
+        data.recents_screen.data.main.size.flags.enable_height_percent = 0;
+        data.recents_screen.data.main.size.height = screen_size.height;
+    }
+
+    // Status bar
+    if (data.flags.enable_status_bar) {
+        if ((error = StatusBar::tryCalibrateData(screen_size, data.status_bar.data)) != nullptr) {
+            return error;
+        }
+        if (data.flags.enable_app_launcher_flex_size &&
+                (data.status_bar.visual_mode == StatusBar::VisualMode::SHOW_FIXED)) {
+            data.app_launcher.data.main.y_start += data.status_bar.data.main.size.height;
+            data.app_launcher.data.main.size.height -= data.status_bar.data.main.size.height;
+        }
+        if (data.flags.enable_recents_screen && data.flags.enable_recents_screen_flex_size &&
+                (data.recents_screen.status_bar_visual_mode == StatusBar::VisualMode::SHOW_FIXED)) {
+            data.recents_screen.data.main.y_start += data.status_bar.data.main.size.height;
+            data.recents_screen.data.main.size.height -= data.status_bar.data.main.size.height;
+        }
+    }
+    // Navigation bar
+    if (data.flags.enable_navigation_bar) {
+        if ((error = NavigationBar::tryCalibrateData(screen_size, data.navigation_bar.data)) != nullptr) {
+            return error;
+        }
+        if (data.flags.enable_app_launcher_flex_size &&
+                (data.navigation_bar.visual_mode == NavigationBar::VisualMode::SHOW_FIXED)) {
+            int height = data.app_launcher.data.main.y_start + data.navigation_bar.data.main.size.height;
+            if ((height < 1) || (height > screen_size.height)) {
+                return "Invalid app launcher height flex";
+            }
+            data.app_launcher.data.main.size.height -= data.navigation_bar.data.main.size.height;
+        }
+        if (data.flags.enable_recents_screen && data.flags.enable_recents_screen_flex_size &&
+                (data.recents_screen.navigation_bar_visual_mode == NavigationBar::VisualMode::SHOW_FIXED)) {
+            int height = data.recents_screen.data.main.y_start + data.recents_screen.data.main.size.height;
+            if ((height < 1) || (height > screen_size.height)) {
+                return "Invalid recents screen height flex";
+            }
+            data.recents_screen.data.main.size.height -= data.navigation_bar.data.main.size.height;
+        }
+    }
+    // Recents Screen
+    if (data.flags.enable_recents_screen &&
+            ((error = RecentsScreen::tryCalibrateData(screen_size, data.recents_screen.data)) != nullptr)) {
+        return error;
+    }
+    // base::App table
+    if ((error = AppLauncher::tryCalibrateData(screen_size, data.app_launcher.data)) != nullptr) {
+        return error;
+    }
+
+    return nullptr;
+}
+
 } // namespace esp_brookesia::systems::phone
 
 using ESP_Brookesia_PhoneDisplayData_t [[deprecated("Use `esp_brookesia::systems::phone::Display::Data` instead")]] =
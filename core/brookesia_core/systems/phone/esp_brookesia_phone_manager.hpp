@@ -23,18 +23,21 @@ public:
     struct Data {
         Gesture::Data gesture;
         uint32_t gesture_mask_indicator_trigger_time_ms;
-        struct {
+        struct RecentsScreenConf {
             int drag_snapshot_y_step;
             int drag_snapshot_y_threshold;
             int drag_snapshot_angle_threshold;
             int delete_snapshot_y_threshold;
+            bool operator==(const RecentsScreenConf &) const = default;
         } recents_screen;
-        struct {
+        struct Flags {
             uint8_t enable_gesture: 1;
             uint8_t enable_gesture_navigation_back: 1;
             uint8_t enable_recents_screen_snapshot_drag: 1;
             uint8_t enable_recents_screen_hide_when_no_snapshot: 1;
+            bool operator==(const Flags &) const = default;
         } flags;
+        bool operator==(const Data &) const = default;
     };
 
     enum Screen {
@@ -57,6 +60,15 @@ public:
     }
 
     static bool calibrateData(const gui::StyleSize &screen_size, Display &display, Data &data);
+    // Calibrate the data without logging, return the first invalid item or `nullptr`
+    static constexpr const char *tryCalibrateData(const gui::StyleSize &screen_size, Data &data)
+    {
+        if (data.flags.enable_gesture) {
+            return Gesture::tryCalibrateData(screen_size, data.gesture);
+        }
+
+        return nullptr;
+    }
 
     Display &display;
     const Data &data;
@@ -65,6 +65,12 @@ constexpr Stylesheet STYLESHEET_1024_600_DARK = {
     .manager = STYLESHEET_1024_600_DARK_MANAGER_DATA,
 };
 
+// Calibrated at build time, add it by `Phone::addCalibratedStylesheet()`
+constexpr Stylesheet STYLESHEET_1024_600_DARK_CALIBRATED =
+    Phone::calibrateStylesheetAtBuildTime(gui::StyleSize::RECT(1024, 600), STYLESHEET_1024_600_DARK);
+
 } // namespace esp_brookesia::systems::phone
 
 #define ESP_BROOKESIA_PHONE_1024_600_DARK_STYLESHEET() esp_brookesia::systems::phone::STYLESHEET_1024_600_DARK
+#define ESP_BROOKESIA_PHONE_1024_600_DARK_CALIBRATED_STYLESHEET() \
+    esp_brookesia::systems::phone::STYLESHEET_1024_600_DARK_CALIBRATED
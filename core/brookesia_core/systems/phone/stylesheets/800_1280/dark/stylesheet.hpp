@@ -65,6 +65,12 @@ constexpr Stylesheet STYLESHEET_800_1280_DARK = {
     .manager = STYLESHEET_800_1280_DARK_MANAGER_DATA,
 };
 
+// Calibrated at build time, add it by `Phone::addCalibratedStylesheet()`
+constexpr Stylesheet STYLESHEET_800_1280_DARK_CALIBRATED =
+    Phone::calibrateStylesheetAtBuildTime(gui::StyleSize::RECT(800, 1280), STYLESHEET_800_1280_DARK);
+
 } // namespace esp_brookesia::systems::phone
 
 #define ESP_BROOKESIA_PHONE_800_1280_DARK_STYLESHEET() esp_brookesia::systems::phone::STYLESHEET_800_1280_DARK
+#define ESP_BROOKESIA_PHONE_800_1280_DARK_CALIBRATED_STYLESHEET() \
+    esp_brookesia::systems::phone::STYLESHEET_800_1280_DARK_CALIBRATED
@@ -312,67 +312,17 @@ bool AppLauncher::checkPointInsideMain(lv_point_t &point) const
 
 bool AppLauncher::calibrateData(const gui::StyleSize &screen_size, const base::Display &display, AppLauncherData &data)
 {
-    int parent_w = 0;
-    int parent_h = 0;
-    const gui::StyleSize *parent_size = nullptr;
-
     ESP_UTILS_LOGD("Calibrate data");
 
-    /* Main */
-    parent_size = &screen_size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.main.size), false,
-                                 "Invalid main size");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.main.y_start, 0, parent_h - 1, false, "Invalid main y start");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.main.y_start + data.main.size.height, 1, parent_h, false,
-                                 "Main height is out of range");
-
-    /* Table */
-    parent_size = &data.main.size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    ESP_UTILS_CHECK_FALSE_RETURN(data.table.default_num > 0, false, "Invalid table default number");
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.table.size), false,
-                                 "Invalid table size");
-
-    /* Spot */
-    parent_size = &data.main.size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    // Main
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.indicator.main_size), false,
-                                 "Invalid spot main size");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.indicator.main_layout_column_pad, 1, parent_w, false,
-                                 "Invalid spot main layout column pad");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.indicator.main_layout_bottom_offset, 0, parent_h, false,
-                                 "Invalid spot main layout bottom offset");
-    // Icon
-    parent_size = &data.indicator.main_size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.indicator.spot_inactive_size), false,
-                                 "Invalid spot icon inactive size");
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.indicator.spot_active_size), false,
-                                 "Invalid spot icon active size");
-
-    /* Launcher Icon */
-    // Main
-    parent_size = &data.table.size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.icon.main.size), false,
-                                 "Invalid launcher icon main size");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.icon.main.layout_row_pad, 1, data.icon.main.size.height, false,
-                                 "Invalid launcher icon main layout row pad");
-    // Image
-    parent_size = &data.icon.main.size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.icon.image.default_size), false,
-                                 "Invalid launcher icon image default size");
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.icon.image.press_size), false,
-                                 "Invalid launcher icon image press size");
+    const char *error = tryCalibrateData(screen_size, data);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "%s", error);
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateDataResource(display, data), false, "Calibrate resource failed");
+
+    return true;
+}
+
+bool AppLauncher::calibrateDataResource(const base::Display &display, AppLauncherData &data)
+{
     // Label
     ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreFont(nullptr, data.icon.label.text_font), false,
                                  "Invalid label text font");
@@ -637,6 +587,10 @@ void AppLauncher::onDataUpdateEventCallback(lv_event_t *event)
     app_launcher = (AppLauncher *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(app_launcher, "Invalid app launcher object");
 
+    if (!app_launcher->_system_context.checkDataUpdated(app_launcher->_data)) {
+        return;
+    }
+
     ESP_UTILS_CHECK_FALSE_EXIT(app_launcher->updateByNewData(), "Update object style failed");
 }
 
@@ -12,15 +12,17 @@
 namespace esp_brookesia::systems::phone {
 
 struct AppLauncherData {
-    struct {
+    struct Main {
         int y_start;
         gui::StyleSize size;
+        bool operator==(const Main &) const = default;
     } main;
-    struct {
+    struct Table {
         uint8_t default_num;
         gui::StyleSize size;
+        bool operator==(const Table &) const = default;
     } table;
-    struct {
+    struct Indicator {
         gui::StyleSize main_size;
         uint8_t main_layout_column_pad;
         int main_layout_bottom_offset;
@@ -28,11 +30,14 @@ struct AppLauncherData {
         gui::StyleSize spot_active_size;
         gui::StyleColor spot_inactive_background_color;
         gui::StyleColor spot_active_background_color;
+        bool operator==(const Indicator &) const = default;
     } indicator;
     AppLauncherIcon::Data icon;
-    struct {
+    struct Flags {
         uint8_t enable_table_scroll_anim: 1;
+        bool operator==(const Flags &) const = default;
     } flags;
+    bool operator==(const AppLauncherData &) const = default;
 };
 
 class AppLauncher {
@@ -63,6 +68,10 @@ public:
     }
 
     static bool calibrateData(const gui::StyleSize &screen_size, const base::Display &display, AppLauncherData &data);
+    // Calibrate all but the fonts without logging, return the first invalid item or `nullptr`
+    static constexpr const char *tryCalibrateData(const gui::StyleSize &screen_size, AppLauncherData &data);
+    // Resolve the fonts of the data calibrated by `tryCalibrateData()`
+    static bool calibrateDataResource(const base::Display &display, AppLauncherData &data);
 
 private:
     struct MixObject {
@@ -104,6 +113,81 @@ private:
     std::map <int, MixIcon> _id_mix_icon_map;
 };
 
+constexpr const char *AppLauncher::tryCalibrateData(const gui::StyleSize &screen_size, AppLauncherData &data)
+{
+    int parent_w = 0;
+    int parent_h = 0;
+    const gui::StyleSize *parent_size = nullptr;
+    auto in_range = [](int value, int min, int max) {
+        return (value >= min) && (value <= max);
+    };
+
+    /* Main */
+    parent_size = &screen_size;
+    parent_h = parent_size->height;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.main.size)) {
+        return "Invalid main size";
+    }
+    if (!in_range(data.main.y_start, 0, parent_h - 1)) {
+        return "Invalid main y start";
+    }
+    if (!in_range(data.main.y_start + data.main.size.height, 1, parent_h)) {
+        return "Main height is out of range";
+    }
+
+    /* Table */
+    parent_size = &data.main.size;
+    if (data.table.default_num == 0) {
+        return "Invalid table default number";
+    }
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.table.size)) {
+        return "Invalid table size";
+    }
+
+    /* Spot */
+    parent_size = &data.main.size;
+    parent_w = parent_size->width;
+    parent_h = parent_size->height;
+    // Main
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.indicator.main_size)) {
+        return "Invalid spot main size";
+    }
+    if (!in_range(data.indicator.main_layout_column_pad, 1, parent_w)) {
+        return "Invalid spot main layout column pad";
+    }
+    if (!in_range(data.indicator.main_layout_bottom_offset, 0, parent_h)) {
+        return "Invalid spot main layout bottom offset";
+    }
+    // Icon
+    parent_size = &data.indicator.main_size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.indicator.spot_inactive_size)) {
+        return "Invalid spot icon inactive size";
+    }
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.indicator.spot_active_size)) {
+        return "Invalid spot icon active size";
+    }
+
+    /* Launcher Icon */
+    // Main
+    parent_size = &data.table.size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.icon.main.size)) {
+        return "Invalid launcher icon main size";
+    }
+    if (!in_range(data.icon.main.layout_row_pad, 1, data.icon.main.size.height)) {
+        return "Invalid launcher icon main layout row pad";
+    }
+    // Image
+    parent_size = &data.icon.main.size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.icon.image.default_size)) {
+        return "Invalid launcher icon image default size";
+    }
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.icon.image.press_size)) {
+        return "Invalid launcher icon image press size";
+    }
+
+    return nullptr;
+}
+
 } // namespace esp_brookesia::systems::phone
 
 using ESP_Brookesia_AppLauncherData_t [[deprecated("Use `esp_brookesia::systems::phone::AppLauncherData` instead")]] =
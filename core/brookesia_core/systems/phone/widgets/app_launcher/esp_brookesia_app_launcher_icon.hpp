@@ -21,18 +21,22 @@ public:
     };
 
     struct Data {
-        struct {
+        struct Main {
             gui::StyleSize size;
             uint8_t layout_row_pad;
+            bool operator==(const Main &) const = default;
         } main;
-        struct {
+        struct Image {
             gui::StyleSize default_size;
             gui::StyleSize press_size;
+            bool operator==(const Image &) const = default;
         } image;
-        struct {
+        struct Label {
             gui::StyleFont text_font;
             gui::StyleColor text_color;
+            bool operator==(const Label &) const = default;
         } label;
+        bool operator==(const Data &) const = default;
     };
 
     AppLauncherIcon(base::Context &core, const Info &info, const Data &data);
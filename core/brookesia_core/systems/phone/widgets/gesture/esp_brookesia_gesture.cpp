@@ -186,53 +186,10 @@ int Gesture::getIndicatorBarLength(Gesture::IndicatorBarType type) const
 bool Gesture::calibrateData(const gui::StyleSize &screen_size, const base::Display &display,
                             Gesture::Data &data)
 {
-    int parent_w = 0;
-    int parent_h = 0;
-    const gui::StyleSize *parent_size = nullptr;
-
     ESP_UTILS_LOGD("Calibrate data");
 
-    // Threshold
-    parent_size = &screen_size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    ESP_UTILS_CHECK_FALSE_RETURN(data.detect_period_ms > 0, false, "Invalid detect period");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.threshold.direction_vertical, 1, parent_h, false,
-                                 "Invalid vertical direction threshold");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.threshold.direction_horizon, 1, parent_w, false,
-                                 "Invalid horizon direction threshold");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.threshold.direction_angle, 1, 89, false, "Invalid direction angle threshold");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.threshold.horizontal_edge, 1, parent_w, false, "Invalid left edge threshold");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.threshold.vertical_edge, 1, parent_h, false, "Invalid top edge threshold");
-    ESP_UTILS_CHECK_FALSE_RETURN(data.threshold.speed_slow_px_per_ms > 0, false, "Invalid speed slow threshold");
-    ESP_UTILS_CHECK_FALSE_RETURN(data.threshold.duration_short_ms > 0, false, "Invalid duration short threshold");
-    // Left/Right indicator bar
-    for (int i = 0; i < static_cast<int>(Gesture::IndicatorBarType::MAX); i++) {
-        if (!data.flags.enable_indicator_bars[i]) {
-            continue;
-        }
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(screen_size, data.indicator_bars[i].main.size_max), false,
-                                     "Calibrate indicator bar main size max failed");
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(screen_size, data.indicator_bars[i].main.size_min, true),
-                                     false, "Calibrate indicator bar main size min failed");
-        switch (static_cast<Gesture::IndicatorBarType>(i)) {
-        case Gesture::IndicatorBarType::LEFT:
-        case Gesture::IndicatorBarType::RIGHT:
-            parent_size = &data.indicator_bars[i].main.size_min;
-            parent_w = parent_size->width;
-            ESP_UTILS_CHECK_VALUE_RETURN(data.indicator_bars[i].main.layout_pad_all, 0, parent_w / 2, false,
-                                         "Invalid indicator bar main layout pad all");
-            break;
-        case Gesture::IndicatorBarType::BOTTOM:
-            parent_size = &data.indicator_bars[i].main.size_min;
-            parent_h = parent_size->height;
-            ESP_UTILS_CHECK_VALUE_RETURN(data.indicator_bars[i].main.layout_pad_all, 0, parent_h / 2, false,
-                                         "Invalid indicator bar main layout pad all");
-            break;
-        default:
-            break;
-        }
-    }
+    const char *error = tryCalibrateData(screen_size, data);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "%s", error);
 
     return true;
 }
@@ -20,26 +20,30 @@ public:
     };
 
     struct IndicatorBarData {
-        struct {
+        struct Main {
             gui::StyleSize size_min;
             gui::StyleSize size_max;
             uint8_t radius;
             uint8_t layout_pad_all;
             gui::StyleColor color;
+            bool operator==(const Main &) const = default;
         } main;
-        struct {
+        struct Indicator {
             uint8_t radius;
             gui::StyleColor color;
+            bool operator==(const Indicator &) const = default;
         } indicator;
-        struct {
+        struct Animation {
             gui::StyleAnimation::AnimationPathType scale_back_path_type;
             uint32_t scale_back_time_ms;
+            bool operator==(const Animation &) const = default;
         } animation;
+        bool operator==(const IndicatorBarData &) const = default;
     };
 
     struct Data {
         uint8_t detect_period_ms;
-        struct {
+        struct Threshold {
             int direction_vertical;
             int direction_horizon;
             uint8_t direction_angle;
@@ -47,11 +51,14 @@ public:
             int vertical_edge;
             int duration_short_ms;
             float speed_slow_px_per_ms;
+            bool operator==(const Threshold &) const = default;
         } threshold;
         Gesture::IndicatorBarData indicator_bars[static_cast<int>(Gesture::IndicatorBarType::MAX)];
-        struct {
+        struct Flags {
             uint8_t enable_indicator_bars[static_cast<int>(Gesture::IndicatorBarType::MAX)];
+            bool operator==(const Flags &) const = default;
         } flags;
+        bool operator==(const Data &) const = default;
     };
 
     enum Direction {
@@ -136,6 +143,8 @@ public:
 
     static bool calibrateData(const gui::StyleSize &screen_size, const base::Display &display,
                               Gesture::Data &data);
+    // Calibrate the data without logging, return the first invalid item or `nullptr`
+    static constexpr const char *tryCalibrateData(const gui::StyleSize &screen_size, Gesture::Data &data);
 
     base::Context &core;
     const Gesture::Data &data;
@@ -192,6 +201,76 @@ private:
     Info _event_data = GESTURE_INFO_INIT;
 };
 
+constexpr const char *Gesture::tryCalibrateData(const gui::StyleSize &screen_size, Gesture::Data &data)
+{
+    int parent_w = 0;
+    int parent_h = 0;
+    const gui::StyleSize *parent_size = nullptr;
+    auto in_range = [](int value, int min, int max) {
+        return (value >= min) && (value <= max);
+    };
+
+    // Threshold
+    parent_size = &screen_size;
+    parent_w = parent_size->width;
+    parent_h = parent_size->height;
+    if (data.detect_period_ms == 0) {
+        return "Invalid detect period";
+    }
+    if (!in_range(data.threshold.direction_vertical, 1, parent_h)) {
+        return "Invalid vertical direction threshold";
+    }
+    if (!in_range(data.threshold.direction_horizon, 1, parent_w)) {
+        return "Invalid horizon direction threshold";
+    }
+    if (!in_range(data.threshold.direction_angle, 1, 89)) {
+        return "Invalid direction angle threshold";
+    }
+    if (!in_range(data.threshold.horizontal_edge, 1, parent_w)) {
+        return "Invalid left edge threshold";
+    }
+    if (!in_range(data.threshold.vertical_edge, 1, parent_h)) {
+        return "Invalid top edge threshold";
+    }
+    if (!(data.threshold.speed_slow_px_per_ms > 0)) {
+        return "Invalid speed slow threshold";
+    }
+    if (!(data.threshold.duration_short_ms > 0)) {
+        return "Invalid duration short threshold";
+    }
+    // Left/Right indicator bar
+    for (int i = 0; i < static_cast<int>(Gesture::IndicatorBarType::MAX); i++) {
+        if (!data.flags.enable_indicator_bars[i]) {
+            continue;
+        }
+        if (!base::Display::tryCalibrateCoreObjectSize(screen_size, data.indicator_bars[i].main.size_max)) {
+            return "Calibrate indicator bar main size max failed";
+        }
+        if (!base::Display::tryCalibrateCoreObjectSize(screen_size, data.indicator_bars[i].main.size_min, true)) {
+            return "Calibrate indicator bar main size min failed";
+        }
+        switch (static_cast<Gesture::IndicatorBarType>(i)) {
+        case Gesture::IndicatorBarType::LEFT:
+        case Gesture::IndicatorBarType::RIGHT:
+            parent_w = data.indicator_bars[i].main.size_min.width;
+            if (!in_range(data.indicator_bars[i].main.layout_pad_all, 0, parent_w / 2)) {
+                return "Invalid indicator bar main layout pad all";
+            }
+            break;
+        case Gesture::IndicatorBarType::BOTTOM:
+            parent_h = data.indicator_bars[i].main.size_min.height;
+            if (!in_range(data.indicator_bars[i].main.layout_pad_all, 0, parent_h / 2)) {
+                return "Invalid indicator bar main layout pad all";
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
 } // namespace esp_brookesia::systems::phone
 
 using ESP_Brookesia_GestureDirection_t [[deprecated("Use `esp_brookesia::systems::phone::Direction` instead")]] =
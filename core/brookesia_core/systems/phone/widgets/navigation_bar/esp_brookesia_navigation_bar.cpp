@@ -16,9 +16,7 @@ using namespace esp_brookesia::gui;
 
 namespace esp_brookesia::systems::phone {
 
-#define VISUAL_FLEX_SHOW_ANIM_PERIOD_MS     200
 #define VISUAL_FLEX_SHOW_DURATION_MS        2000
-#define VISUAL_FLEX_HIDE_ANIM_PERIOD_MS     200
 
 NavigationBar::NavigationBar(base::Context &core, const NavigationBar::Data &data):
     _system_context(core),
@@ -284,57 +282,22 @@ int NavigationBar::getCurrentOffset(void) const
 bool NavigationBar::calibrateData(const gui::StyleSize &screen_size, const base::Display &display,
                                   NavigationBar::Data &data)
 {
-    base::Manager::NavigateType navigate_type = base::Manager::NavigateType::MAX;
-    const gui::StyleSize *parent_size = nullptr;
-
     ESP_UTILS_LOGD("Calibrate data");
 
-    // Calibrate the min and max size
-    if (data.flags.enable_main_size_min) {
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(screen_size, data.main.size_min), false,
-                                     "Calibrate data main size min failed");
-    }
-    if (data.flags.enable_main_size_max) {
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(screen_size, data.main.size_max), false,
-                                     "Calibrate data main size max failed");
-    }
+    const char *error = tryCalibrateData(screen_size, data);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "%s", error);
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateDataResource(display, data), false, "Calibrate resource failed");
 
-    /* Main */
-    parent_size = &screen_size;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.main.size), false,
-                                 "Invalid main size");
-    // Adjust the size according to the min and max size
-    if (data.flags.enable_main_size_min) {
-        data.main.size.width = max(data.main.size.width, data.main.size_min.width);
-        data.main.size.height = max(data.main.size.height, data.main.size_min.height);
-    }
-    if (data.flags.enable_main_size_max) {
-        data.main.size.width = min(data.main.size.width, data.main.size_max.width);
-        data.main.size.height = min(data.main.size.height, data.main.size_max.height);
-    }
+    return true;
+}
+
+bool NavigationBar::calibrateDataResource(const base::Display &display, const NavigationBar::Data &data)
+{
     // Button
-    parent_size = &data.main.size;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.button.icon_size), false,
-                                 "Invalid button icon size");
     for (int i = 0; i < BUTTON_NUM; i++) {
-        navigate_type = data.button.navigate_types[i];
-        ESP_UTILS_CHECK_VALUE_RETURN(
-            static_cast<int>(navigate_type), 0, static_cast<int>(base::Manager::NavigateType::MAX) - 1, false,
-            "Invalid button navigate type"
-        );
-        ESP_UTILS_CHECK_NULL_RETURN(data.button.icon_images[i].resource, false, "Invalid button icon image resources");
-    }
-    // Visual flex
-    if (data.visual_flex.show_animation.duration_ms == 0) {
-        data.visual_flex.show_animation.duration_ms = VISUAL_FLEX_SHOW_ANIM_PERIOD_MS;
+        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreIconImage(data.button.icon_images[i]), false,
+                                     "Invalid button icon image resources");
     }
-    if (data.visual_flex.hide_animation.duration_ms == 0) {
-        data.visual_flex.hide_animation.duration_ms = VISUAL_FLEX_HIDE_ANIM_PERIOD_MS; // TODO:
-    }
-    ESP_UTILS_CHECK_FALSE_RETURN(data.visual_flex.show_animation.path_type < gui::StyleAnimation::ANIM_PATH_TYPE_MAX, false,
-                                 "Invalid visual flex show animation path type");
-    ESP_UTILS_CHECK_FALSE_RETURN(data.visual_flex.hide_animation.path_type < gui::StyleAnimation::ANIM_PATH_TYPE_MAX, false,
-                                 "Invalid visual flex hide animation path type");
 
     return true;
 }
@@ -528,6 +491,10 @@ void NavigationBar::onDataUpdateEventCallback(lv_event_t *event)
     navigation_bar = (NavigationBar *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(navigation_bar, "Invalid navigation bar object");
 
+    if (!navigation_bar->_system_context.checkDataUpdated(navigation_bar->_data)) {
+        return;
+    }
+
     ESP_UTILS_CHECK_FALSE_EXIT(navigation_bar->updateByNewData(), "Update failed");
 }
 
@@ -564,7 +531,9 @@ void NavigationBar::onIconTouchEventCallback(lv_event_t *event)
             static_cast<int>(navigate_type), 0, static_cast<int>(base::Manager::NavigateType::MAX) - 1,
             "Invalid navigate type"
         );
-        ESP_UTILS_CHECK_FALSE_EXIT(navigation_bar->_system_context.sendNavigateEvent(navigate_type), "Send navigate event failed");
+        ESP_UTILS_CHECK_FALSE_EXIT(
+            navigation_bar->_system_context.postNavigateEvent(navigate_type), "Post navigate event failed"
+        );
         break;
     case LV_EVENT_PRESSED:
         ESP_UTILS_LOGD("Pressed");
@@ -18,27 +18,32 @@ public:
     static constexpr uint8_t BUTTON_NUM = static_cast<uint8_t>(base::Manager::NavigateType::MAX);
 
     struct Data {
-        struct {
+        struct Main {
             gui::StyleSize size;
             gui::StyleSize size_min;
             gui::StyleSize size_max;
             gui::StyleColor background_color;
+            bool operator==(const Main &) const = default;
         } main;
-        struct {
+        struct Button {
             gui::StyleSize icon_size;
             gui::StyleImage icon_images[BUTTON_NUM];
             base::Manager::NavigateType navigate_types[BUTTON_NUM];
             gui::StyleColor active_background_color;
+            bool operator==(const Button &) const = default;
         } button;
-        struct {
+        struct VisualFlex {
             gui::StyleAnimation show_animation;
             gui::StyleAnimation hide_animation;
             int hide_timer_period_ms;
+            bool operator==(const VisualFlex &) const = default;
         } visual_flex;
-        struct {
+        struct Flags {
             uint8_t enable_main_size_min: 1;
             uint8_t enable_main_size_max: 1;
+            bool operator==(const Flags &) const = default;
         } flags;
+        bool operator==(const Data &) const = default;
     };
 
     enum class VisualMode : uint8_t {
@@ -83,8 +88,15 @@ public:
 
     static bool calibrateData(const gui::StyleSize &screen_size, const base::Display &display,
                               Data &data);
+    // Calibrate all but the images without logging, return the first invalid item or `nullptr`
+    static constexpr const char *tryCalibrateData(const gui::StyleSize &screen_size, Data &data);
+    // Check the images of the data calibrated by `tryCalibrateData()`
+    static bool calibrateDataResource(const base::Display &display, const Data &data);
 
 private:
+    static constexpr int VISUAL_FLEX_SHOW_ANIM_PERIOD_MS = 200;
+    static constexpr int VISUAL_FLEX_HIDE_ANIM_PERIOD_MS = 200;
+
     bool updateByNewData(void);
     bool startFlexShowAnimation(bool enable_auto_hide);
     bool stopFlexShowAnimation(void);
@@ -121,6 +133,62 @@ private:
     std::vector<ESP_Brookesia_LvObj_t> _icon_image_objs;
 };
 
+constexpr const char *NavigationBar::tryCalibrateData(const gui::StyleSize &screen_size, Data &data)
+{
+    const gui::StyleSize *parent_size = nullptr;
+
+    // Calibrate the min and max size
+    if (data.flags.enable_main_size_min &&
+            !base::Display::tryCalibrateCoreObjectSize(screen_size, data.main.size_min)) {
+        return "Calibrate data main size min failed";
+    }
+    if (data.flags.enable_main_size_max &&
+            !base::Display::tryCalibrateCoreObjectSize(screen_size, data.main.size_max)) {
+        return "Calibrate data main size max failed";
+    }
+
+    /* Main */
+    parent_size = &screen_size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.main.size)) {
+        return "Invalid main size";
+    }
+    // Adjust the size according to the min and max size
+    if (data.flags.enable_main_size_min) {
+        data.main.size.width = std::max(data.main.size.width, data.main.size_min.width);
+        data.main.size.height = std::max(data.main.size.height, data.main.size_min.height);
+    }
+    if (data.flags.enable_main_size_max) {
+        data.main.size.width = std::min(data.main.size.width, data.main.size_max.width);
+        data.main.size.height = std::min(data.main.size.height, data.main.size_max.height);
+    }
+    // Button
+    parent_size = &data.main.size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.button.icon_size)) {
+        return "Invalid button icon size";
+    }
+    for (int i = 0; i < BUTTON_NUM; i++) {
+        int navigate_type = static_cast<int>(data.button.navigate_types[i]);
+        if ((navigate_type < 0) || (navigate_type >= static_cast<int>(base::Manager::NavigateType::MAX))) {
+            return "Invalid button navigate type";
+        }
+    }
+    // Visual flex
+    if (data.visual_flex.show_animation.duration_ms == 0) {
+        data.visual_flex.show_animation.duration_ms = VISUAL_FLEX_SHOW_ANIM_PERIOD_MS;
+    }
+    if (data.visual_flex.hide_animation.duration_ms == 0) {
+        data.visual_flex.hide_animation.duration_ms = VISUAL_FLEX_HIDE_ANIM_PERIOD_MS; // TODO:
+    }
+    if (data.visual_flex.show_animation.path_type >= gui::StyleAnimation::ANIM_PATH_TYPE_MAX) {
+        return "Invalid visual flex show animation path type";
+    }
+    if (data.visual_flex.hide_animation.path_type >= gui::StyleAnimation::ANIM_PATH_TYPE_MAX) {
+        return "Invalid visual flex hide animation path type";
+    }
+
+    return nullptr;
+}
+
 } // namespace esp_brookesia::systems::phone
 
 using ESP_Brookesia_NavigationBarData_t [[deprecated("Use `esp_brookesia::systems::phone::NavigationBar::Data` instead")]] =
@@ -376,132 +376,34 @@ int RecentsScreen::getSnapshotIdPointIn(lv_point_t &point) const
 bool RecentsScreen::calibrateData(const gui::StyleSize &screen_size, const base::Display &display,
                                   RecentsScreen::Data &data)
 {
-    int parent_w = 0;
-    int parent_h = 0;
-    RecentsScreenSnapshot::Data &new_snapshot_data = data.snapshot_table.snapshot;
-    const gui::StyleSize *parent_size = nullptr;
-
     ESP_UTILS_LOGD("Calibrate data");
 
-    /* Main */
-    parent_size = &screen_size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    // Size
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.main.size), false,
-                                 "Invalid main size");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.main.y_start, 0, parent_h - 1, false, "Invalid main y start");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.main.y_start + data.main.size.height, 1, parent_h, false,
-                                 "Main height is out of range");
-    parent_size = &data.main.size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    // Layout
-    ESP_UTILS_CHECK_VALUE_RETURN(data.main.layout_row_pad, 0, parent_h, false, "Invalid main layout row pad");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.main.layout_top_pad, 0, parent_h, false, "Invalid main layout top pad");
-    ESP_UTILS_CHECK_VALUE_RETURN(data.main.layout_bottom_pad, 0, parent_h, false, "Invalid main layout bottom pad");
+    const char *error = tryCalibrateData(screen_size, data);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "%s", error);
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateDataResource(display, data), false, "Calibrate resource failed");
+
+    return true;
+}
+
+bool RecentsScreen::calibrateDataResource(const base::Display &display, RecentsScreen::Data &data)
+{
+    RecentsScreenSnapshot::Data &new_snapshot_data = data.snapshot_table.snapshot;
 
     /* Memory */
     if (data.flags.enable_memory) {
-        parent_size = &data.main.size;
-        parent_w = parent_size->width;
-        parent_h = parent_size->height;
-        // Main
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.memory.main_size), false,
-                                     "Invalid memory main size");
-        parent_size = &data.memory.main_size;
-        parent_w = parent_size->width;
-        parent_h = parent_size->height;
-        ESP_UTILS_CHECK_VALUE_RETURN(data.memory.main_layout_x_right_offset, 0, parent_w, false,
-                                     "Invalid memory main layout x right offset");
-        // Label
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreFont(parent_size, data.memory.label_text_font), false,
-                                     "Invalid memory label text font size");
-        ESP_UTILS_CHECK_NULL_RETURN(data.memory.label_unit_text, false, "Invalid memory label unit text");
+        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreFont(&data.memory.main_size, data.memory.label_text_font),
+                                     false, "Invalid memory label text font size");
     }
 
     // Trash
-    parent_size = &data.main.size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.trash_icon.default_size), false,
-                                 "Invalid trash icon default size");
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.trash_icon.press_size), false,
-                                 "Invalid trash icon eprbdefault size");
-    ESP_UTILS_CHECK_NULL_RETURN(data.trash_icon.image.resource, false, "Invalid trash icon image resource");
-
-    // Table
-    parent_size = &data.main.size;
-    parent_w = parent_size->width;
-    parent_h = parent_size->height;
-    if (data.flags.enable_table_height_flex) {
-        data.snapshot_table.main_size.height = parent_h - data.memory.main_size.height -
-                                               data.trash_icon.default_size.height -
-                                               data.main.layout_row_pad * 4 - data.main.layout_top_pad -
-                                               data.main.layout_bottom_pad;
-        data.snapshot_table.main_size.flags.enable_height_percent = 0;
-        data.snapshot_table.main_size.flags.enable_square = 0;
-    }
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.snapshot_table.main_size), false,
-                                 "Invalid snapshot_table main size");
-    parent_size = &data.snapshot_table.main_size;
-    parent_w = parent_size->width;
-    ESP_UTILS_CHECK_VALUE_RETURN(data.snapshot_table.main_layout_column_pad, 0, parent_w, false,
-                                 "Invalid snapshot_table main layout column pad");
+    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreIconImage(data.trash_icon.image), false,
+                                 "Invalid trash icon image resource");
 
     /* Snapshot */
-    // Main
-    parent_size = (new_snapshot_data.flags.enable_all_main_size_refer_screen) ? &screen_size :
-                  &data.snapshot_table.main_size;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, new_snapshot_data.main_size), false,
-                                 "Invalid snapshot main size");
-    // If referring to the screen, check with the main size
-    if (new_snapshot_data.flags.enable_all_main_size_refer_screen) {
-        ESP_UTILS_CHECK_VALUE_RETURN(new_snapshot_data.main_size.width, 1, data.snapshot_table.main_size.width, false,
-                                     "Invalid snapshot main width");
-        ESP_UTILS_CHECK_VALUE_RETURN(new_snapshot_data.main_size.height, 1, data.snapshot_table.main_size.height, false,
-                                     "Invalid snapshot main height");
-    }
-    // Title
-    parent_size = (new_snapshot_data.flags.enable_all_main_size_refer_screen) ? &screen_size :
-                  &new_snapshot_data.main_size;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, new_snapshot_data.title.main_size), false,
-                                 "Invalid snapshot title size");
-    // If referring to the screen, check with the main size
-    if (new_snapshot_data.flags.enable_all_main_size_refer_screen) {
-        ESP_UTILS_CHECK_VALUE_RETURN(new_snapshot_data.title.main_size.width, 1, new_snapshot_data.main_size.width, false,
-                                     "Invalid snapshot title main width");
-        ESP_UTILS_CHECK_VALUE_RETURN(new_snapshot_data.title.main_size.height, 1, new_snapshot_data.main_size.height, false,
-                                     "Invalid snapshot title main height");
-    }
-    parent_size = &new_snapshot_data.title.main_size;
-    parent_w = parent_size->width;
-    ESP_UTILS_CHECK_VALUE_RETURN(new_snapshot_data.title.main_layout_column_pad, 0, parent_w, false,
-                                 "Invalid snapshot title layout column pad");
-    // Title Icon
-    parent_size = &new_snapshot_data.title.main_size;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, new_snapshot_data.title.icon_size), false,
-                                 "Invalid snapshot title icon size");
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreFont(parent_size, new_snapshot_data.title.text_font), false,
-                                 "Invalid snapshot title text font");
-    // Image
-    parent_size = (new_snapshot_data.flags.enable_all_main_size_refer_screen) ? &screen_size :
-                  &new_snapshot_data.main_size;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, new_snapshot_data.image.main_size), false,
-                                 "Invalid snapshot image main size");
-    // If referring to the screen, check with the main size
-    if (new_snapshot_data.flags.enable_all_main_size_refer_screen) {
-        ESP_UTILS_CHECK_VALUE_RETURN(new_snapshot_data.image.main_size.width, 1, new_snapshot_data.main_size.width, false,
-                                     "Invalid snapshot image main width");
-        ESP_UTILS_CHECK_VALUE_RETURN(new_snapshot_data.image.main_size.height, 1, new_snapshot_data.main_size.height, false,
-                                     "Invalid snapshot image main height");
-    }
-    // All
-    parent_size = &new_snapshot_data.main_size;
-    parent_h = parent_size->height;
-    ESP_UTILS_CHECK_VALUE_RETURN(new_snapshot_data.title.main_size.height + new_snapshot_data.image.main_size.height, 1,
-                                 parent_h, false, "The sum of snapshot title height(%d) and image height(%d) out of main",
-                                 new_snapshot_data.title.main_size.height, new_snapshot_data.image.main_size.height);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        display.calibrateCoreFont(&new_snapshot_data.title.main_size, new_snapshot_data.title.text_font), false,
+        "Invalid snapshot title text font"
+    );
 
     return true;
 }
@@ -583,6 +485,10 @@ void RecentsScreen::onDataUpdateEventCallback(lv_event_t *event)
     recents_screen = (RecentsScreen *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(recents_screen, "Invalid app snapshot_table object");
 
+    if (!recents_screen->_system_context.checkDataUpdated(recents_screen->_data)) {
+        return;
+    }
+
     ESP_UTILS_CHECK_FALSE_EXIT(recents_screen->updateByNewData(), "Update object style failed");
 }
 
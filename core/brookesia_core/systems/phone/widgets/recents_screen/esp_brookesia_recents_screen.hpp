@@ -16,37 +16,43 @@ namespace esp_brookesia::systems::phone {
 class RecentsScreen {
 public:
     struct Data {
-        struct {
+        struct Main {
             int y_start;
             gui::StyleSize size;
             int layout_row_pad;
             int layout_top_pad;
             int layout_bottom_pad;
             gui::StyleColor background_color;
+            bool operator==(const Main &) const = default;
         } main;
-        struct {
+        struct Memory {
             gui::StyleSize main_size;
             uint8_t main_layout_x_right_offset;
             gui::StyleFont label_text_font;
             gui::StyleColor label_text_color;
             const char *label_unit_text;
+            bool operator==(const Memory &) const = default;
         } memory;
-        struct {
+        struct SnapshotTable {
             gui::StyleSize main_size;
             int main_layout_column_pad;
             RecentsScreenSnapshot::Data snapshot;
+            bool operator==(const SnapshotTable &) const = default;
         } snapshot_table;
-        struct {
+        struct TrashIcon {
             gui::StyleSize default_size;
             gui::StyleSize press_size;
             gui::StyleImage image;
+            bool operator==(const TrashIcon &) const = default;
         } trash_icon;
-        struct {
+        struct Flags {
             uint8_t enable_memory: 1;
             uint8_t enable_table_height_flex: 1;
             uint8_t enable_table_snapshot_use_icon_image: 1;
             uint8_t enable_table_scroll_anim: 1;
+            bool operator==(const Flags &) const = default;
         } flags;
+        bool operator==(const Data &) const = default;
     };
 
     RecentsScreen(const RecentsScreen &) = delete;
@@ -95,6 +101,10 @@ public:
     }
 
     static bool calibrateData(const gui::StyleSize &screen_size, const base::Display &display, Data &data);
+    // Calibrate all but the fonts and images without logging, return the first invalid item or `nullptr`
+    static constexpr const char *tryCalibrateData(const gui::StyleSize &screen_size, Data &data);
+    // Resolve the fonts and images of the data calibrated by `tryCalibrateData()`
+    static bool calibrateDataResource(const base::Display &display, Data &data);
 
 private:
     bool updateByNewData(void);
@@ -118,6 +128,155 @@ private:
     std::unordered_map<int, std::shared_ptr<RecentsScreenSnapshot>> _id_snapshot_map;
 };
 
+constexpr const char *RecentsScreen::tryCalibrateData(const gui::StyleSize &screen_size, Data &data)
+{
+    int parent_w = 0;
+    int parent_h = 0;
+    RecentsScreenSnapshot::Data &new_snapshot_data = data.snapshot_table.snapshot;
+    const gui::StyleSize *parent_size = nullptr;
+    auto in_range = [](int value, int min, int max) {
+        return (value >= min) && (value <= max);
+    };
+
+    /* Main */
+    parent_size = &screen_size;
+    parent_h = parent_size->height;
+    // Size
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.main.size)) {
+        return "Invalid main size";
+    }
+    if (!in_range(data.main.y_start, 0, parent_h - 1)) {
+        return "Invalid main y start";
+    }
+    if (!in_range(data.main.y_start + data.main.size.height, 1, parent_h)) {
+        return "Main height is out of range";
+    }
+    parent_size = &data.main.size;
+    parent_h = parent_size->height;
+    // Layout
+    if (!in_range(data.main.layout_row_pad, 0, parent_h)) {
+        return "Invalid main layout row pad";
+    }
+    if (!in_range(data.main.layout_top_pad, 0, parent_h)) {
+        return "Invalid main layout top pad";
+    }
+    if (!in_range(data.main.layout_bottom_pad, 0, parent_h)) {
+        return "Invalid main layout bottom pad";
+    }
+
+    /* Memory */
+    if (data.flags.enable_memory) {
+        parent_size = &data.main.size;
+        // Main
+        if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.memory.main_size)) {
+            return "Invalid memory main size";
+        }
+        parent_size = &data.memory.main_size;
+        parent_w = parent_size->width;
+        if (!in_range(data.memory.main_layout_x_right_offset, 0, parent_w)) {
+            return "Invalid memory main layout x right offset";
+        }
+        // Label
+        if (data.memory.label_unit_text == nullptr) {
+            return "Invalid memory label unit text";
+        }
+    }
+
+    // Trash
+    parent_size = &data.main.size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.trash_icon.default_size)) {
+        return "Invalid trash icon default size";
+    }
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.trash_icon.press_size)) {
+        return "Invalid trash icon press size";
+    }
+
+    // Table
+    parent_size = &data.main.size;
+    parent_h = parent_size->height;
+    if (data.flags.enable_table_height_flex) {
+        data.snapshot_table.main_size.height = parent_h - data.memory.main_size.height -
+                                               data.trash_icon.default_size.height -
+                                               data.main.layout_row_pad * 4 - data.main.layout_top_pad -
+                                               data.main.layout_bottom_pad;
+        data.snapshot_table.main_size.flags.enable_height_percent = 0;
+        data.snapshot_table.main_size.flags.enable_square = 0;
+    }
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.snapshot_table.main_size)) {
+        return "Invalid snapshot_table main size";
+    }
+    parent_size = &data.snapshot_table.main_size;
+    parent_w = parent_size->width;
+    if (!in_range(data.snapshot_table.main_layout_column_pad, 0, parent_w)) {
+        return "Invalid snapshot_table main layout column pad";
+    }
+
+    /* Snapshot */
+    // Main
+    parent_size = (new_snapshot_data.flags.enable_all_main_size_refer_screen) ? &screen_size :
+                  &data.snapshot_table.main_size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, new_snapshot_data.main_size)) {
+        return "Invalid snapshot main size";
+    }
+    // If referring to the screen, check with the main size
+    if (new_snapshot_data.flags.enable_all_main_size_refer_screen) {
+        if (!in_range(new_snapshot_data.main_size.width, 1, data.snapshot_table.main_size.width)) {
+            return "Invalid snapshot main width";
+        }
+        if (!in_range(new_snapshot_data.main_size.height, 1, data.snapshot_table.main_size.height)) {
+            return "Invalid snapshot main height";
+        }
+    }
+    // Title
+    parent_size = (new_snapshot_data.flags.enable_all_main_size_refer_screen) ? &screen_size :
+                  &new_snapshot_data.main_size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, new_snapshot_data.title.main_size)) {
+        return "Invalid snapshot title size";
+    }
+    // If referring to the screen, check with the main size
+    if (new_snapshot_data.flags.enable_all_main_size_refer_screen) {
+        if (!in_range(new_snapshot_data.title.main_size.width, 1, new_snapshot_data.main_size.width)) {
+            return "Invalid snapshot title main width";
+        }
+        if (!in_range(new_snapshot_data.title.main_size.height, 1, new_snapshot_data.main_size.height)) {
+            return "Invalid snapshot title main height";
+        }
+    }
+    parent_size = &new_snapshot_data.title.main_size;
+    parent_w = parent_size->width;
+    if (!in_range(new_snapshot_data.title.main_layout_column_pad, 0, parent_w)) {
+        return "Invalid snapshot title layout column pad";
+    }
+    // Title Icon
+    parent_size = &new_snapshot_data.title.main_size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, new_snapshot_data.title.icon_size)) {
+        return "Invalid snapshot title icon size";
+    }
+    // Image
+    parent_size = (new_snapshot_data.flags.enable_all_main_size_refer_screen) ? &screen_size :
+                  &new_snapshot_data.main_size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, new_snapshot_data.image.main_size)) {
+        return "Invalid snapshot image main size";
+    }
+    // If referring to the screen, check with the main size
+    if (new_snapshot_data.flags.enable_all_main_size_refer_screen) {
+        if (!in_range(new_snapshot_data.image.main_size.width, 1, new_snapshot_data.main_size.width)) {
+            return "Invalid snapshot image main width";
+        }
+        if (!in_range(new_snapshot_data.image.main_size.height, 1, new_snapshot_data.main_size.height)) {
+            return "Invalid snapshot image main height";
+        }
+    }
+    // All
+    parent_size = &new_snapshot_data.main_size;
+    parent_h = parent_size->height;
+    if (!in_range(new_snapshot_data.title.main_size.height + new_snapshot_data.image.main_size.height, 1, parent_h)) {
+        return "The sum of snapshot title height and image height out of main";
+    }
+
+    return nullptr;
+}
+
 } // namespace esp_brookesia::systems::phone
 
 using ESP_Brookesia_RecentsScreenData_t [[deprecated("Use `esp_brookesia::systems::phone::RecentsScreen::Data` instead")]] =
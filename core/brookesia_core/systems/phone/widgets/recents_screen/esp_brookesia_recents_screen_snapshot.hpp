@@ -21,20 +21,24 @@ public:
 
     struct Data {
         gui::StyleSize main_size;
-        struct {
+        struct Title {
             gui::StyleSize main_size;
             uint8_t main_layout_column_pad;
             gui::StyleSize icon_size;
             gui::StyleFont text_font;
             gui::StyleColor text_color;
+            bool operator==(const Title &) const = default;
         } title;
-        struct {
+        struct Image {
             gui::StyleSize main_size;
             uint8_t radius;
+            bool operator==(const Image &) const = default;
         } image;
-        struct {
+        struct Flags {
             uint8_t enable_all_main_size_refer_screen: 1;
+            bool operator==(const Flags &) const = default;
         } flags;
+        bool operator==(const Data &) const = default;
     };
 
     RecentsScreenSnapshot(const RecentsScreenSnapshot &) = delete;
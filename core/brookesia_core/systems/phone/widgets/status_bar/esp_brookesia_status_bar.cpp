@@ -166,19 +166,11 @@ bool StatusBar::checkVisible(void) const
 bool StatusBar::calibrateIconData(const StatusBar::Data &bar_data, const base::Display &display,
                                   StatusBarIcon::Data &icon_data)
 {
-    const StatusBar::AreaData &area = bar_data.area.data[bar_data.battery.area_index];
-
     ESP_UTILS_LOGD("Calibrate data");
 
-    // Size
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(area.size, icon_data.size), false, "Calibrate size failed");
-    // Image
-    ESP_UTILS_CHECK_VALUE_RETURN(icon_data.icon.image_num, 1, StatusBarIcon::IMAGE_NUM_MAX,
-                                 false, "Icon image num is invalid");
-    for (int i = 0; i < icon_data.icon.image_num; i++) {
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreIconImage(icon_data.icon.images[i]), false,
-                                     "Calibrate icon image failed");
-    }
+    const char *error = tryCalibrateIconData(bar_data, icon_data);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "%s", error);
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateIconDataResource(display, icon_data), false, "Calibrate resource failed");
 
     return true;
 }
@@ -186,75 +178,39 @@ bool StatusBar::calibrateIconData(const StatusBar::Data &bar_data, const base::D
 bool StatusBar::calibrateData(const gui::StyleSize &screen_size, const base::Display &display,
                               StatusBar::Data &data)
 {
-    const gui::StyleSize *parent_size = &screen_size;
-
     ESP_UTILS_LOGD("Calibrate data");
 
-    // Calibrate the min and max size
-    if (data.flags.enable_main_size_min) {
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(screen_size, data.main.size_min), false,
-                                     "Calibrate data main size min failed");
-    }
-    if (data.flags.enable_main_size_max) {
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(screen_size, data.main.size_max), false,
-                                     "Calibrate data main size max failed");
-    }
+    const char *error = tryCalibrateData(screen_size, data);
+    ESP_UTILS_CHECK_FALSE_RETURN(error == nullptr, false, "%s", error);
+    ESP_UTILS_CHECK_FALSE_RETURN(calibrateDataResource(display, data), false, "Calibrate resource failed");
 
-    /* Main */
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.main.size), false,
-                                 "Calibrate main size failed");
-    // Adjust the size according to the min and max size
-    if (data.flags.enable_main_size_min) {
-        data.main.size.width = max(data.main.size.width, data.main.size_min.width);
-        data.main.size.height = max(data.main.size.height, data.main.size_min.height);
-    }
-    if (data.flags.enable_main_size_max) {
-        data.main.size.width = min(data.main.size.width, data.main.size_max.width);
-        data.main.size.height = min(data.main.size.height, data.main.size_max.height);
+    return true;
+}
+
+bool StatusBar::calibrateIconDataResource(const base::Display &display, const StatusBarIcon::Data &icon_data)
+{
+    // Image
+    for (int i = 0; i < icon_data.icon.image_num; i++) {
+        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreIconImage(icon_data.icon.images[i]), false,
+                                     "Calibrate icon image failed");
     }
+
+    return true;
+}
+
+bool StatusBar::calibrateDataResource(const base::Display &display, StatusBar::Data &data)
+{
     // Text
-    parent_size = &data.main.size;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreFont(parent_size, data.main.text_font), false,
+    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreFont(&data.main.size, data.main.text_font), false,
                                  "Calibrate main text font failed");
 
-    /* Area */
-    parent_size = &data.main.size;
-    ESP_UTILS_CHECK_VALUE_RETURN(data.area.num, 1, StatusBarIcon::IMAGE_NUM_MAX, false,
-                                 "Area data num is invalid");
-    for (int i = 0; i < data.area.num; i++) {
-        ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.area.data[i].size), false,
-                                     "Calibrate area(%d) size failed", i);
-        ESP_UTILS_CHECK_VALUE_RETURN(
-            static_cast<int>(data.area.data[i].layout_column_align), static_cast<int>(AreaAlign::UNKNOWN) + 1,
-            static_cast<int>(AreaAlign::MAX) - 1, false, "Area(%d) layout align is invalid", i
-        );
-        ESP_UTILS_CHECK_VALUE_RETURN(data.area.data[i].layout_column_start_offset, 0, data.area.data[i].size.width,
-                                     false, "Area(%d) layout start offset is invalid", i);
-        ESP_UTILS_CHECK_VALUE_RETURN(data.area.data[i].layout_column_pad, 0, data.area.data[i].size.width,
-                                     false, "Area(%d) layout pad is invalid", i);
-    }
-
     /* Icon */
-    // Common size
-    parent_size = &data.main.size;
-    ESP_UTILS_CHECK_FALSE_RETURN(display.calibrateCoreObjectSize(*parent_size, data.icon_common_size), false,
-                                 "Calibrate icon common size failed");
-    // Battery
     if (data.flags.enable_battery_icon) {
-        ESP_UTILS_LOGD("Calibrate battery icon data");
-        if (data.flags.enable_battery_icon_common_size) {
-            data.battery.icon_data.size = data.icon_common_size;
-        }
-        ESP_UTILS_CHECK_FALSE_RETURN(calibrateIconData(data, display, data.battery.icon_data), false,
+        ESP_UTILS_CHECK_FALSE_RETURN(calibrateIconDataResource(display, data.battery.icon_data), false,
                                      "Calibrate battery icon data failed");
     }
-    // Wifi
     if (data.flags.enable_wifi_icon) {
-        ESP_UTILS_LOGD("Calibrate wifi icon data");
-        if (data.flags.enable_wifi_icon_common_size) {
-            data.wifi.icon_data.size = data.icon_common_size;
-        }
-        ESP_UTILS_CHECK_FALSE_RETURN(calibrateIconData(data, display, data.wifi.icon_data), false,
+        ESP_UTILS_CHECK_FALSE_RETURN(calibrateIconDataResource(display, data.wifi.icon_data), false,
                                      "Calibrate wifi icon data failed");
     }
 
@@ -716,6 +672,10 @@ void StatusBar::onDataUpdateEventCallback(lv_event_t *event)
     status_bar = (StatusBar *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(status_bar, "Invalid status bar object");
 
+    if (!status_bar->_system_context.checkDataUpdated(status_bar->_data)) {
+        return;
+    }
+
     // Main
     ESP_UTILS_CHECK_FALSE_EXIT(status_bar->updateMainByNewData(), "Update main object style failed");
     for (auto &icon : status_bar->_id_icon_map) {
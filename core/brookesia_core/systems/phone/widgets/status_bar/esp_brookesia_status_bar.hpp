@@ -32,34 +32,40 @@ public:
         AreaAlign layout_column_align;
         int layout_column_start_offset;
         int layout_column_pad;
+        bool operator==(const AreaData &) const = default;
     };
 
     struct Data {
-        struct {
+        struct Main {
             gui::StyleSize size;
             gui::StyleSize size_min;
             gui::StyleSize size_max;
             gui::StyleColor background_color;
             gui::StyleFont text_font;
             gui::StyleColor text_color;
+            bool operator==(const Main &) const = default;
         } main;
-        struct {
+        struct Area {
             uint8_t num;
             AreaData data[AREA_NUM_MAX];
+            bool operator==(const Area &) const = default;
         } area;
         gui::StyleSize icon_common_size;
-        struct {
+        struct Battery {
             uint8_t area_index;
             StatusBarIcon::Data icon_data;
+            bool operator==(const Battery &) const = default;
         } battery;
-        struct {
+        struct Wifi {
             uint8_t area_index;
             StatusBarIcon::Data icon_data;
+            bool operator==(const Wifi &) const = default;
         } wifi;
-        struct {
+        struct Clock {
             uint8_t area_index;
+            bool operator==(const Clock &) const = default;
         } clock;
-        struct {
+        struct Flags {
             uint8_t enable_main_size_min: 1;
             uint8_t enable_main_size_max: 1;
             uint32_t enable_battery_icon: 1;
@@ -68,7 +74,9 @@ public:
             uint32_t enable_wifi_icon: 1;
             uint32_t enable_wifi_icon_common_size: 1;
             uint32_t enable_clock: 1;
+            bool operator==(const Flags &) const = default;
         } flags;
+        bool operator==(const Data &) const = default;
     };
 
     enum class VisualMode {
@@ -119,6 +127,12 @@ public:
                                   StatusBarIcon::Data &icon_data);
     static bool calibrateData(const gui::StyleSize &screen_size, const base::Display &display,
                               Data &data);
+    // Calibrate all but the fonts and images without logging, return the first invalid item or `nullptr`
+    static constexpr const char *tryCalibrateIconData(const Data &bar_data, StatusBarIcon::Data &icon_data);
+    static constexpr const char *tryCalibrateData(const gui::StyleSize &screen_size, Data &data);
+    // Resolve the fonts and images of the data calibrated by `tryCalibrate*()`
+    static bool calibrateIconDataResource(const base::Display &display, const StatusBarIcon::Data &icon_data);
+    static bool calibrateDataResource(const base::Display &display, Data &data);
 
 private:
     bool beginMain(lv_obj_t *parent);
@@ -177,6 +191,100 @@ private:
     ESP_Brookesia_LvObj_t _clock_period_label;
 };
 
+constexpr const char *StatusBar::tryCalibrateIconData(const Data &bar_data, StatusBarIcon::Data &icon_data)
+{
+    const AreaData &area = bar_data.area.data[bar_data.battery.area_index];
+
+    // Size
+    if (!base::Display::tryCalibrateCoreObjectSize(area.size, icon_data.size)) {
+        return "Calibrate size failed";
+    }
+    // Image
+    if ((icon_data.icon.image_num < 1) || (icon_data.icon.image_num > StatusBarIcon::IMAGE_NUM_MAX)) {
+        return "Icon image num is invalid";
+    }
+
+    return nullptr;
+}
+
+constexpr const char *StatusBar::tryCalibrateData(const gui::StyleSize &screen_size, Data &data)
+{
+    const gui::StyleSize *parent_size = &screen_size;
+    const char *error = nullptr;
+
+    // Calibrate the min and max size
+    if (data.flags.enable_main_size_min &&
+            !base::Display::tryCalibrateCoreObjectSize(screen_size, data.main.size_min)) {
+        return "Calibrate data main size min failed";
+    }
+    if (data.flags.enable_main_size_max &&
+            !base::Display::tryCalibrateCoreObjectSize(screen_size, data.main.size_max)) {
+        return "Calibrate data main size max failed";
+    }
+
+    /* Main */
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.main.size)) {
+        return "Calibrate main size failed";
+    }
+    // Adjust the size according to the min and max size
+    if (data.flags.enable_main_size_min) {
+        data.main.size.width = std::max(data.main.size.width, data.main.size_min.width);
+        data.main.size.height = std::max(data.main.size.height, data.main.size_min.height);
+    }
+    if (data.flags.enable_main_size_max) {
+        data.main.size.width = std::min(data.main.size.width, data.main.size_max.width);
+        data.main.size.height = std::min(data.main.size.height, data.main.size_max.height);
+    }
+
+    /* Area */
+    parent_size = &data.main.size;
+    if ((data.area.num < 1) || (data.area.num > StatusBarIcon::IMAGE_NUM_MAX)) {
+        return "Area data num is invalid";
+    }
+    for (int i = 0; i < data.area.num; i++) {
+        AreaData &area = data.area.data[i];
+        if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, area.size)) {
+            return "Calibrate area size failed";
+        }
+        if ((area.layout_column_align <= AreaAlign::UNKNOWN) || (area.layout_column_align >= AreaAlign::MAX)) {
+            return "Area layout align is invalid";
+        }
+        if ((area.layout_column_start_offset < 0) || (area.layout_column_start_offset > area.size.width)) {
+            return "Area layout start offset is invalid";
+        }
+        if ((area.layout_column_pad < 0) || (area.layout_column_pad > area.size.width)) {
+            return "Area layout pad is invalid";
+        }
+    }
+
+    /* Icon */
+    // Common size
+    parent_size = &data.main.size;
+    if (!base::Display::tryCalibrateCoreObjectSize(*parent_size, data.icon_common_size)) {
+        return "Calibrate icon common size failed";
+    }
+    // Battery
+    if (data.flags.enable_battery_icon) {
+        if (data.flags.enable_battery_icon_common_size) {
+            data.battery.icon_data.size = data.icon_common_size;
+        }
+        if ((error = tryCalibrateIconData(data, data.battery.icon_data)) != nullptr) {
+            return error;
+        }
+    }
+    // Wifi
+    if (data.flags.enable_wifi_icon) {
+        if (data.flags.enable_wifi_icon_common_size) {
+            data.wifi.icon_data.size = data.icon_common_size;
+        }
+        if ((error = tryCalibrateIconData(data, data.wifi.icon_data)) != nullptr) {
+            return error;
+        }
+    }
+
+    return nullptr;
+}
+
 } // namespace esp_brookesia::systems::phone
 
 using ESP_Brookesia_StatusBarAreaAlign_t [[deprecated("Use `esp_brookesia::systems::phone::StatusBar::AreaAlign` instead")]] =
@@ -19,11 +19,13 @@ public:
     struct Image {
         uint8_t image_num;
         gui::StyleImage images[IMAGE_NUM_MAX];
+        bool operator==(const Image &) const = default;
     };
 
     struct Data {
         gui::StyleSize size;
         Image icon;
+        bool operator==(const Data &) const = default;
     };
 
     StatusBarIcon(const StatusBarIcon &) = delete;
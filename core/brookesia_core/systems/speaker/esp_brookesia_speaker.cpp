@@ -166,12 +166,17 @@ bool Speaker::activateStylesheet(const Stylesheet &stylesheet)
 {
     ESP_UTILS_LOGD("Activate speaker(0x%p) stylesheet", this);
 
+    auto last_stylesheet = getStylesheetHandle();
     ESP_UTILS_CHECK_FALSE_RETURN(
         StylesheetManager::activateStylesheet(stylesheet.core.name, stylesheet.core.screen_size),
         false, "Failed to activate speaker stylesheet"
     );
+    if (getStylesheetHandle() == last_stylesheet) {
+        ESP_UTILS_LOGD("Stylesheet is already active");
+        return true;
+    }
 
-    if (checkCoreInitialized() && !sendDataUpdateEvent()) {
+    if (checkCoreInitialized() && !postDataUpdateEvent()) {
         ESP_UTILS_LOGE("Send update data event failed");
     }
 
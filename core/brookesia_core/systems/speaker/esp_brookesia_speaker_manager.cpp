@@ -141,17 +141,19 @@ bool Manager::begin(void)
         );
     });
     // Process quick settings storage service event signal
-    StorageNVS::requestInstance().connectEventSignal([this](const StorageNVS::Event & event) {
-        if ((event.operation != StorageNVS::Operation::UpdateNVS) || (event.sender == &display.getQuickSettings())) {
-            ESP_UTILS_LOGD("Ignore event: operation(%d), sender(%p)", static_cast<int>(event.operation), event.sender);
-            return;
-        }
+    for (auto key : {SETTINGS_WLAN_SWITCH, SETTINGS_VOLUME, SETTINGS_BRIGHTNESS}) {
+        StorageNVS::requestInstance().subscribe(key, [this](const StorageNVS::Event & event) {
+            if (event.sender == &display.getQuickSettings()) {
+                ESP_UTILS_LOGD("Ignore event: sender(%p)", event.sender);
+                return;
+            }
 
-        ESP_UTILS_CHECK_FALSE_EXIT(
-            processQuickSettingsStorageServiceEventSignal(event.key),
-            "Process quick settings storage service event signal failed"
-        );
-    });
+            ESP_UTILS_CHECK_FALSE_EXIT(
+                processQuickSettingsStorageServiceEventSignal(event.key),
+                "Process quick settings storage service event signal failed"
+            );
+        });
+    }
     // Init quick settings info
     StorageNVS::Value value;
     if (StorageNVS::requestInstance().getLocalParam(SETTINGS_WLAN_SWITCH, value)) {
@@ -31,6 +31,7 @@ constexpr Display::Data STYLESHEET_360_360_DARK_DISPLAY_DATA = {
                 .max_files = MMAP_BOOT_FILES,
                 .fps = (const int []) { 18 },
                 .checksum = MMAP_BOOT_CHECKSUM,
+                .check_mode = gui::AnimPlayerPartitionCheck::Lazy,
             },
             // .source = gui::AnimPlayerResourcesConfig{
             //     .num = 1,
@@ -103,6 +104,7 @@ constexpr AI_Buddy::Data STYLESHEET_360_360_DARK_AI_BUDDY_DATA = {
                         .max_files = MMAP_EMOTION_FILES,
                         .fps = (const int []) { 30, 30, 30, 30, 30, 30, 30, 30},
                         .checksum = MMAP_EMOTION_CHECKSUM,
+                        .check_mode = gui::AnimPlayerPartitionCheck::Background,
                     },
                     // .source = gui::AnimPlayerResourcesConfig{
                     //     .num = 6,
@@ -134,10 +136,25 @@ constexpr AI_Buddy::Data STYLESHEET_360_360_DARK_AI_BUDDY_DATA = {
                         .task_stack = 10 * 1024,
                         .task_affinity = 0,
                         .task_stack_in_ext = true,
+                        .pipeline_depth = 2,
+                        .pipeline_buffer_in_ext = true,
                     },
                     .flags = {
                         .enable_data_swap_bytes = true,
                     },
+                    .cache = {
+                        .budget_bytes = 2 * 1024 * 1024,
+                        .buffer_in_ext = true,
+                    },
+                    .delta = {
+                        .tile_size = 16,
+                        .merge_tiles = true,
+                        .buffer_in_ext = true,
+                    },
+                    .pacing = {
+                        .enable_frame_skip = true,
+                        .max_skip_frames = 2,
+                    },
                 },
             },
             .icon = {
@@ -153,6 +170,7 @@ constexpr AI_Buddy::Data STYLESHEET_360_360_DARK_AI_BUDDY_DATA = {
                         .max_files = MMAP_ICON_FILES,
                         .fps = (const int []) { 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15 },
                         .checksum = MMAP_ICON_CHECKSUM,
+                        .check_mode = gui::AnimPlayerPartitionCheck::Background,
                     },
                     // .source = gui::AnimPlayerResourcesConfig{
                     //     .num = 11,
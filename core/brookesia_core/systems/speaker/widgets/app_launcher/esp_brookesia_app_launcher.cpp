@@ -643,6 +643,10 @@ void AppLauncher::onDataUpdateEventCallback(lv_event_t *event)
     app_launcher = (AppLauncher *)lv_event_get_user_data(event);
     ESP_UTILS_CHECK_NULL_EXIT(app_launcher, "Invalid app launcher object");
 
+    if (!app_launcher->_system_context.checkDataUpdated(app_launcher->_data)) {
+        return;
+    }
+
     ESP_UTILS_CHECK_FALSE_EXIT(app_launcher->updateByNewData(), "Update object style failed");
 }
 
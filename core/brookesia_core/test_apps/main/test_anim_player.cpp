@@ -0,0 +1,980 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#if CONFIG_ESP_BROOKESIA_GUI_ENABLE_ANIM_PLAYER
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "anim_player/esp_brookesia_anim_compositor.hpp"
+#include "anim_player/esp_brookesia_anim_player.hpp"
+#include "anim_player/esp_brookesia_anim_tile_decoder.hpp"
+
+using namespace esp_brookesia::gui;
+
+#define TEST_ANIM_WIDTH                 (64)
+#define TEST_ANIM_HEIGHT                (64)
+#define TEST_ANIM_TILE_SIZE             (16)
+#define TEST_ANIM_FRAME_NUM             (16)
+#define TEST_ANIM_FPS                   (1000)
+#define TEST_FLUSH_LATENCY_US           (2000)
+#define TEST_PLAY_TIMEOUT_MS            (5000)
+#define TEST_STRIP_HEIGHT               (16)
+#define TEST_CACHE_BENCHMARK_ROUNDS     (100)
+#define TEST_CACHE_SEGMENT_FRAME_NUM    (4)
+#define TEST_SPRITE_SIZE                (12)
+#define TEST_SPRITE_STEP                (5)
+#define TEST_DELTA_TILE_SIZE            (8)
+#define TEST_LATENCY_ROUNDS             (20)
+#define TEST_SLOW_ANIM_FPS              (10)
+#define TEST_LAYER_OFFSET               (32)
+#define TEST_COMPOSE_SIZE               (TEST_ANIM_WIDTH + TEST_LAYER_OFFSET)
+#define TEST_GRADIENT_FRAME_STEP        (97)
+#define TEST_SEGMENT_FROM               (4)
+#define TEST_SEGMENT_TO                 (7)
+#define TEST_SEGMENT_START              (6)
+#define TEST_SEGMENT_FRAME_NUM          (10)
+#define TEST_PACING_FPS                 (100)
+#define TEST_PACING_FLUSH_LATENCY_US    (15000)
+#define TEST_PACING_MAX_SKIP_FRAMES     (2)
+#define TEST_SWAP_LOOP_NUM              (3)
+
+static const char *TAG = "test_anim_player";
+
+// A 64x64 animation(.aaf) decoded by the external decoder, embedded by `CMakeLists.txt`
+extern const uint8_t test_decoder_asset_start[] asm("_binary_icon_ww1_feed_64_aaf_start");
+extern const uint8_t test_decoder_asset_end[] asm("_binary_icon_ww1_feed_64_aaf_end");
+
+using TestFrame = std::vector<uint16_t>;
+
+struct TestSink {
+    void flush(int x_start, int y_start, int x_end, int y_end, const void *data)
+    {
+        std::lock_guard lock(mutex);
+        auto src = static_cast<const uint16_t *>(data);
+        int width = x_end - x_start;
+        for (int y = y_start; y < y_end; y++) {
+            memcpy(&screen[y * TEST_ANIM_WIDTH + x_start], src + (y - y_start) * width, width * sizeof(uint16_t));
+        }
+        if ((x_start == 0) && (y_start == 0)) {
+            first_pixels.push_back(src[0]);
+        }
+        if (first_flush_us == 0) {
+            first_flush_us = esp_timer_get_time();
+        }
+        flushes++;
+        frames += (y_start == 0);
+        if (latency_us > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(latency_us));
+        }
+    }
+
+    std::mutex mutex;
+    TestFrame screen = TestFrame(TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT);
+    int flushes = 0;
+    int frames = 0;
+    int latency_us = 0;
+    std::vector<uint16_t> first_pixels;     // Pixel (0, 0) of each flushed frame, which tells the frames apart
+    std::atomic<int64_t> first_flush_us = 0;
+};
+
+static void test_append_u16(std::vector<uint8_t> &data, uint16_t value)
+{
+    data.push_back(value & 0xff);
+    data.push_back(value >> 8);
+}
+
+static void test_append_u32(std::vector<uint8_t> &data, uint32_t value)
+{
+    test_append_u16(data, value & 0xffff);
+    test_append_u16(data, value >> 16);
+}
+
+/**
+ * Same layout as `tools/anim_transcoder/anim_transcoder.py`, with only the first frame as a keyframe. Uniform tiles
+ * are stored as RLE runs and the others as raw pixels.
+ */
+static std::vector<uint8_t> test_encode_tile_animation(const std::vector<TestFrame> &frames)
+{
+    int tiles_x = (TEST_ANIM_WIDTH + TEST_ANIM_TILE_SIZE - 1) / TEST_ANIM_TILE_SIZE;
+    int tiles_y = (TEST_ANIM_HEIGHT + TEST_ANIM_TILE_SIZE - 1) / TEST_ANIM_TILE_SIZE;
+    std::vector<std::vector<uint8_t>> records;
+    for (size_t i = 0; i < frames.size(); i++) {
+        std::vector<uint8_t> bitmap((tiles_x * tiles_y + 7) / 8, 0);
+        std::vector<uint8_t> tiles;
+        for (int ty = 0; ty < tiles_y; ty++) {
+            for (int tx = 0; tx < tiles_x; tx++) {
+                int x_start = tx * TEST_ANIM_TILE_SIZE;
+                int x_end = std::min(x_start + TEST_ANIM_TILE_SIZE, TEST_ANIM_WIDTH);
+                int y_start = ty * TEST_ANIM_TILE_SIZE;
+                int y_end = std::min(y_start + TEST_ANIM_TILE_SIZE, TEST_ANIM_HEIGHT);
+                TestFrame pixels;
+                bool is_changed = (i == 0);
+                for (int y = y_start; y < y_end; y++) {
+                    for (int x = x_start; x < x_end; x++) {
+                        int index = y * TEST_ANIM_WIDTH + x;
+                        pixels.push_back(frames[i][index]);
+                        is_changed = is_changed || (frames[i][index] != frames[i - 1][index]);
+                    }
+                }
+                if (!is_changed) {
+                    continue;
+                }
+                int tile_index = ty * tiles_x + tx;
+                bitmap[tile_index / 8] |= (1 << (tile_index % 8));
+
+                std::vector<uint8_t> payload;
+                if (std::count(pixels.begin(), pixels.end(), pixels[0]) == static_cast<int>(pixels.size())) {
+                    for (size_t left = pixels.size(); left > 0;) {
+                        size_t count = std::min<size_t>(left, 128);
+                        payload.push_back(0x80 | (count - 1));
+                        test_append_u16(payload, pixels[0]);
+                        left -= count;
+                    }
+                    tiles.push_back(1);
+                } else {
+                    for (auto pixel : pixels) {
+                        test_append_u16(payload, pixel);
+                    }
+                    tiles.push_back(0);
+                }
+                test_append_u16(tiles, payload.size());
+                tiles.insert(tiles.end(), payload.begin(), payload.end());
+            }
+        }
+        std::vector<uint8_t> record = {static_cast<uint8_t>(i == 0)};
+        record.insert(record.end(), bitmap.begin(), bitmap.end());
+        record.insert(record.end(), tiles.begin(), tiles.end());
+        records.push_back(std::move(record));
+    }
+
+    std::vector<uint8_t> body;
+    test_append_u16(body, TEST_ANIM_WIDTH);
+    test_append_u16(body, TEST_ANIM_HEIGHT);
+    test_append_u16(body, TEST_ANIM_TILE_SIZE);
+    test_append_u16(body, 0);
+    test_append_u32(body, records.size());
+    uint32_t offset = 0;
+    for (auto &record : records) {
+        test_append_u32(body, offset);
+        test_append_u32(body, record.size());
+        offset += record.size();
+    }
+    for (auto &record : records) {
+        body.insert(body.end(), record.begin(), record.end());
+    }
+
+    uint32_t checksum = 0;
+    for (auto byte : body) {
+        checksum += byte;
+    }
+    std::vector<uint8_t> data = {'A', 'T', 'F', '1'};
+    test_append_u32(data, checksum);
+    test_append_u32(data, body.size());
+    data.insert(data.end(), body.begin(), body.end());
+
+    return data;
+}
+
+// Every tile changes in every frame
+static std::vector<TestFrame> test_make_gradient_frames(int frame_num)
+{
+    std::vector<TestFrame> frames(frame_num, TestFrame(TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT));
+    for (int i = 0; i < frame_num; i++) {
+        for (int j = 0; j < TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT; j++) {
+            frames[i][j] = static_cast<uint16_t>(j * 3 + i * TEST_GRADIENT_FRAME_STEP);
+        }
+    }
+
+    return frames;
+}
+
+// A square moving over a uniform background, so only a few tiles change between frames
+static std::vector<TestFrame> test_make_sprite_frames(int frame_num)
+{
+    std::vector<TestFrame> frames(frame_num, TestFrame(TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT, 0x1234));
+    for (int i = 0; i < frame_num; i++) {
+        int x_start = (i * TEST_SPRITE_STEP) % (TEST_ANIM_WIDTH - TEST_SPRITE_SIZE);
+        int y_start = (i * TEST_SPRITE_STEP * 2) % (TEST_ANIM_HEIGHT - TEST_SPRITE_SIZE);
+        for (int y = y_start; y < y_start + TEST_SPRITE_SIZE; y++) {
+            for (int x = x_start; x < x_start + TEST_SPRITE_SIZE; x++) {
+                frames[i][y * TEST_ANIM_WIDTH + x] = 0xf800 + i;
+            }
+        }
+    }
+
+    return frames;
+}
+
+// Only the top band changes in the second frame and the bottom band in the third one
+static std::vector<TestFrame> test_make_band_frames()
+{
+    std::vector<TestFrame> frames(3, TestFrame(TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT, 0x1234));
+    int band_pixels = TEST_ANIM_WIDTH * TEST_ANIM_TILE_SIZE;
+    for (int i = 1; i < 3; i++) {
+        std::fill_n(frames[i].begin(), band_pixels, 0x5678);
+    }
+    std::fill_n(frames[2].end() - band_pixels, band_pixels, 0x9abc);
+
+    return frames;
+}
+
+static AnimPlayerData test_get_player_data(const AnimPlayerAnimAddress &address)
+{
+    return AnimPlayerData{
+        .canvas = {0, 0, TEST_ANIM_WIDTH, TEST_ANIM_HEIGHT},
+        .source = AnimPlayerResourcesConfig{
+            .num = 1,
+            .resources = &address,
+        },
+        .task = {
+            .task_priority = 4,
+            .task_stack = 10 * 1024,
+            .task_affinity = -1,
+            .task_stack_in_ext = false,
+        },
+    };
+}
+
+/**
+ * An animation and the address which points to it, shared by the player tests. The asset is either encoded from the
+ * frames, or an external one such as the `.aaf` file embedded in the test app.
+ */
+struct TestAnimation {
+    TestAnimation(std::vector<TestFrame> anim_frames, int fps):
+        frames(std::move(anim_frames)),
+        asset(test_encode_tile_animation(frames)),
+        address{asset.data(), asset.size(), fps}
+    {
+    }
+    TestAnimation(const uint8_t *data_start, const uint8_t *data_end, int fps):
+        address{data_start, static_cast<size_t>(data_end - data_start), fps}
+    {
+    }
+    TestAnimation(const TestAnimation &) = delete;
+    TestAnimation &operator=(const TestAnimation &) = delete;
+
+    AnimPlayerData getPlayerData() const
+    {
+        return test_get_player_data(address);
+    }
+
+    std::vector<TestFrame> frames;
+    std::vector<uint8_t> asset;
+    AnimPlayerAnimAddress address;
+};
+
+static bool test_begin_player(AnimPlayer &player, TestSink &sink, const AnimPlayerData &data)
+{
+    return player.setOutputHandler({
+        .flush = [&sink](int x_start, int y_start, int x_end, int y_end, const void *data)
+        {
+            sink.flush(x_start, y_start, x_end, y_end, data);
+        },
+        .clear = [](int x_start, int y_start, int x_end, int y_end) {},
+    }) && player.begin(data);
+}
+
+static void test_wait_future(AnimPlayer::EventFuture &future)
+{
+    TEST_ASSERT_TRUE(future.wait_for(std::chrono::milliseconds(TEST_PLAY_TIMEOUT_MS)) == std::future_status::ready);
+}
+
+static int64_t test_wait_first_flush(TestSink &sink)
+{
+    int64_t start_us = esp_timer_get_time();
+    while ((sink.first_flush_us == 0) && (esp_timer_get_time() - start_us < TEST_PLAY_TIMEOUT_MS * 1000)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    TEST_ASSERT_NOT_EQUAL(0, sink.first_flush_us.load());
+
+    return sink.first_flush_us;
+}
+
+static void test_wait_frames(TestSink &sink, size_t frame_num)
+{
+    int64_t start_us = esp_timer_get_time();
+    while (esp_timer_get_time() - start_us < TEST_PLAY_TIMEOUT_MS * 1000) {
+        {
+            std::lock_guard lock(sink.mutex);
+            if (sink.first_pixels.size() >= frame_num) {
+                return;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    TEST_ASSERT_TRUE(false);
+}
+
+TEST_CASE("test anim player pipelined flush benchmark", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_make_gradient_frames(TEST_ANIM_FRAME_NUM), TEST_ANIM_FPS);
+
+    // The sink takes as long as a display transfer, which the pipeline overlaps with decoding the next frame
+    int64_t elapsed_us[2] = {};
+    for (int depth : {1, 2}) {
+        AnimPlayer player;
+        TestSink sink;
+        sink.latency_us = TEST_FLUSH_LATENCY_US;
+        auto data = animation.getPlayerData();
+        data.task.pipeline_depth = depth;
+        TEST_ASSERT_TRUE(test_begin_player(player, sink, data));
+
+        AnimPlayer::EventFuture future;
+        int64_t start_us = esp_timer_get_time();
+        TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, false, &future));
+        test_wait_future(future);
+        elapsed_us[depth - 1] = esp_timer_get_time() - start_us;
+
+        TEST_ASSERT_EQUAL(TEST_ANIM_FRAME_NUM, sink.frames);
+        TEST_ASSERT_TRUE(sink.screen == animation.frames.back());
+        TEST_ASSERT_TRUE(player.del());
+    }
+
+    ESP_LOGI(
+        TAG, "Frames per second with a %d us sink: direct(%.1f), pipelined(%.1f)", TEST_FLUSH_LATENCY_US,
+        TEST_ANIM_FRAME_NUM * 1e6 / elapsed_us[0], TEST_ANIM_FRAME_NUM * 1e6 / elapsed_us[1]
+    );
+}
+
+TEST_CASE("test anim player pipelined flush on the decoder path", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_decoder_asset_start, test_decoder_asset_end, TEST_ANIM_FPS);
+    AnimFrameIndex frame_index;
+    TEST_ASSERT_TRUE(frame_index.build(animation.address.data_address, animation.address.data_length));
+
+    // The strips come from the flush callback of the decoder and leave through the global signal
+    TestSink sinks[2];
+    int64_t elapsed_us[2] = {};
+    for (int depth : {1, 2}) {
+        AnimPlayer player;
+        auto &sink = sinks[depth - 1];
+        sink.latency_us = TEST_FLUSH_LATENCY_US;
+        boost::signals2::scoped_connection connection = AnimPlayer::flush_ready_signal.connect(
+        [&](int x_start, int y_start, int x_end, int y_end, const void *data, AnimPlayer * sender) {
+            if (sender == &player) {
+                sink.flush(x_start, y_start, x_end, y_end, data);
+                sender->notifyFlushFinished();
+            }
+        });
+        auto data = animation.getPlayerData();
+        data.task.pipeline_depth = depth;
+        TEST_ASSERT_TRUE(player.begin(data));
+
+        AnimPlayer::EventFuture future;
+        int64_t start_us = esp_timer_get_time();
+        TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, false, &future));
+        test_wait_future(future);
+        elapsed_us[depth - 1] = esp_timer_get_time() - start_us;
+        TEST_ASSERT_TRUE(player.del());
+
+        TEST_ASSERT_EQUAL(frame_index.getFrameNum(), sink.frames);
+    }
+    // The pipeline copies the strips, so the last frame is the same as without it
+    TEST_ASSERT_TRUE(sinks[0].screen == sinks[1].screen);
+
+    ESP_LOGI(
+        TAG, "Decoder path frames per second with a %d us sink: direct(%.1f), pipelined(%.1f)",
+        TEST_FLUSH_LATENCY_US, frame_index.getFrameNum() * 1e6 / elapsed_us[0],
+        frame_index.getFrameNum() * 1e6 / elapsed_us[1]
+    );
+}
+
+static bool test_record_frame(AnimFrameCache &cache, int frame_index, const TestFrame &frame)
+{
+    if (!cache.beginFrame(0, frame_index)) {
+        return false;
+    }
+    for (int y = 0; y < TEST_ANIM_HEIGHT; y += TEST_STRIP_HEIGHT) {
+        if (!cache.appendStrip(
+                    0, y, TEST_ANIM_WIDTH, y + TEST_STRIP_HEIGHT, &frame[y * TEST_ANIM_WIDTH],
+                    TEST_ANIM_WIDTH * TEST_STRIP_HEIGHT * sizeof(uint16_t)
+                )) {
+            return false;
+        }
+    }
+
+    return cache.endFrame();
+}
+
+TEST_CASE("test anim player frame cache hits and evictions", "[esp-brookesia][gui][anim_player]")
+{
+    auto frames = test_make_gradient_frames(3);
+    size_t frame_bytes = frames[0].size() * sizeof(uint16_t);
+    AnimFrameCache cache;
+    TEST_ASSERT_TRUE(cache.begin({
+        .budget_bytes = frame_bytes * 2,
+        .buffer_in_ext = false,
+    }));
+
+    TEST_ASSERT_TRUE(test_record_frame(cache, 0, frames[0]));
+    TEST_ASSERT_TRUE(test_record_frame(cache, 1, frames[1]));
+    auto frame = cache.find(0, 0);
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL(TEST_ANIM_HEIGHT / TEST_STRIP_HEIGHT, frame->strips.size());
+    TEST_ASSERT_EQUAL(0, memcmp(frame->getStripData(frame->strips[0]), frames[0].data(), frame_bytes));
+    TEST_ASSERT_NULL(cache.find(0, 2));
+
+    // The least recently used frame is evicted for the new one
+    TEST_ASSERT_TRUE(test_record_frame(cache, 2, frames[2]));
+    TEST_ASSERT_TRUE(cache.contains(0, 0));
+    TEST_ASSERT_FALSE(cache.contains(0, 1));
+    frame = cache.find(0, 2);
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL(0, memcmp(frame->getStripData(frame->strips[0]), frames[2].data(), frame_bytes));
+
+    auto stats = cache.getStats();
+    TEST_ASSERT_EQUAL(2, stats.hits);
+    TEST_ASSERT_EQUAL(1, stats.misses);
+    TEST_ASSERT_EQUAL(3, stats.insertions);
+    TEST_ASSERT_EQUAL(1, stats.evictions);
+    TEST_ASSERT_EQUAL(frame_bytes * 2, stats.used_bytes);
+
+    // A hit only looks the frame up, while a miss records the frame again
+    int64_t hit_us = 0;
+    int64_t miss_us = 0;
+    for (int i = 0; i < TEST_CACHE_BENCHMARK_ROUNDS; i++) {
+        int64_t start_us = esp_timer_get_time();
+        TEST_ASSERT_NOT_NULL(cache.find(0, 2));
+        hit_us += esp_timer_get_time() - start_us;
+
+        start_us = esp_timer_get_time();
+        TEST_ASSERT_NULL(cache.find(0, 3 + i));
+        TEST_ASSERT_TRUE(test_record_frame(cache, 3 + i, frames[i % 3]));
+        miss_us += esp_timer_get_time() - start_us;
+    }
+    ESP_LOGI(
+        TAG, "Frame cache(%d bytes per frame): hit(%.2f us), miss and record(%.2f us)", static_cast<int>(frame_bytes),
+        static_cast<double>(hit_us) / TEST_CACHE_BENCHMARK_ROUNDS,
+        static_cast<double>(miss_us) / TEST_CACHE_BENCHMARK_ROUNDS
+    );
+    TEST_ASSERT_EQUAL(1 + TEST_CACHE_BENCHMARK_ROUNDS, cache.getStats().misses);
+
+    TEST_ASSERT_TRUE(cache.del());
+}
+
+TEST_CASE("test anim player to count frame cache misses while decoding", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_decoder_asset_start, test_decoder_asset_end, TEST_ANIM_FPS);
+    AnimPlayer player;
+    TestSink sink;
+    auto data = animation.getPlayerData();
+    data.cache.budget_bytes = TEST_CACHE_SEGMENT_FRAME_NUM * TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT * sizeof(uint16_t);
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, data));
+
+    // The first loop is decoded and recorded, then the next ones are replayed from the cache
+    AnimPlayer::Event event = {
+        .index = 0,
+        .operation = AnimPlayer::Operation::PlayLoop,
+        .flags = {true, true, true},
+        .segment = {0, TEST_CACHE_SEGMENT_FRAME_NUM - 1, 0},
+    };
+    TEST_ASSERT_TRUE(player.sendEvent(event, true));
+    test_wait_frames(sink, TEST_CACHE_SEGMENT_FRAME_NUM);
+    auto stats = player.getFrameCacheStats();
+    TEST_ASSERT_GREATER_THAN(0, stats.misses);
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_CACHE_SEGMENT_FRAME_NUM, stats.misses);
+
+    test_wait_frames(sink, TEST_CACHE_SEGMENT_FRAME_NUM * 3);
+    stats = player.getFrameCacheStats();
+    TEST_ASSERT_GREATER_THAN(0, stats.hits);
+    TEST_ASSERT_EQUAL(TEST_CACHE_SEGMENT_FRAME_NUM, stats.insertions);
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_CACHE_SEGMENT_FRAME_NUM, stats.misses);
+    TEST_ASSERT_TRUE(player.del());
+}
+
+TEST_CASE("test anim player delta flush benchmark", "[esp-brookesia][gui][anim_player]")
+{
+    auto frames = test_make_sprite_frames(TEST_ANIM_FRAME_NUM);
+    AnimDeltaFlush delta_flush;
+    std::vector<AnimDeltaFlush::Rect> rects;
+    TestFrame screen(TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT);
+    TEST_ASSERT_TRUE(delta_flush.begin({
+        .coord_x = 0,
+        .coord_y = 0,
+        .width = TEST_ANIM_WIDTH,
+        .height = TEST_ANIM_HEIGHT,
+        .pixel_bytes = sizeof(uint16_t),
+        .tile_size = TEST_DELTA_TILE_SIZE,
+        .merge_tiles = true,
+        .buffer_in_ext = false,
+    }));
+
+    // Applying the rects of each strip to the last frame gives the new frame
+    int64_t process_us = 0;
+    for (auto &frame : frames) {
+        for (int y = 0; y < TEST_ANIM_HEIGHT; y += TEST_STRIP_HEIGHT) {
+            int64_t start_us = esp_timer_get_time();
+            TEST_ASSERT_TRUE(delta_flush.process(
+                                 0, y, TEST_ANIM_WIDTH, y + TEST_STRIP_HEIGHT, &frame[y * TEST_ANIM_WIDTH], rects
+                             ));
+            process_us += esp_timer_get_time() - start_us;
+            for (auto &rect : rects) {
+                auto src = static_cast<const uint16_t *>(rect.data);
+                int width = rect.x_end - rect.x_start;
+                for (int ry = rect.y_start; ry < rect.y_end; ry++) {
+                    memcpy(
+                        &screen[ry * TEST_ANIM_WIDTH + rect.x_start], src + (ry - rect.y_start) * width,
+                        width * sizeof(uint16_t)
+                    );
+                }
+            }
+        }
+        TEST_ASSERT_TRUE(screen == frame);
+    }
+
+    auto stats = delta_flush.getStats();
+    ESP_LOGI(
+        TAG, "Delta flush: strips(%d), rects(%d), bytes(%d -> %d, %.1f%% saved), process(%.2f us per strip)",
+        static_cast<int>(stats.strips), static_cast<int>(stats.rects), static_cast<int>(stats.input_bytes),
+        static_cast<int>(stats.output_bytes), 100.0 * (stats.input_bytes - stats.output_bytes) / stats.input_bytes,
+        static_cast<double>(process_us) / stats.strips
+    );
+    // Only the first frame is flushed completely
+    TEST_ASSERT_LESS_THAN(stats.input_bytes / 4, stats.output_bytes);
+
+    TEST_ASSERT_TRUE(delta_flush.del());
+}
+
+TEST_CASE("test anim player event to first flush latency", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_make_gradient_frames(TEST_ANIM_FRAME_NUM), TEST_ANIM_FPS);
+    AnimPlayer player;
+    TestSink sink;
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, animation.getPlayerData()));
+
+    // Each request interrupts the running loop and seeks to another frame
+    int64_t total_us = 0;
+    int64_t max_us = 0;
+    for (int i = 0; i < TEST_LATENCY_ROUNDS; i++) {
+        sink.first_flush_us = 0;
+        int64_t start_us = esp_timer_get_time();
+        TEST_ASSERT_TRUE(player.play(0, i % TEST_ANIM_FRAME_NUM, AnimPlayer::FRAME_LAST, true));
+        int64_t latency_us = test_wait_first_flush(sink) - start_us;
+        total_us += latency_us;
+        max_us = std::max(max_us, latency_us);
+    }
+    ESP_LOGI(
+        TAG, "Event to first flush latency: avg(%d us), max(%d us)", static_cast<int>(total_us / TEST_LATENCY_ROUNDS),
+        static_cast<int>(max_us)
+    );
+
+    // Events which don't start an animation are finished once processed
+    AnimPlayer::EventFuture future;
+    TEST_ASSERT_TRUE(player.sendEvent({0, AnimPlayer::Operation::Pause, {true, true}}, false, &future));
+    test_wait_future(future);
+
+    TEST_ASSERT_TRUE(player.del());
+}
+
+TEST_CASE("test anim player to reject events when the queue is full", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_make_gradient_frames(TEST_ANIM_FRAME_NUM), TEST_SLOW_ANIM_FPS);
+    AnimPlayer player;
+    TestSink sink;
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, animation.getPlayerData()));
+    TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, true));
+    test_wait_first_flush(sink);
+
+    // The event thread waits for the end of the loop before handling the next events
+    AnimPlayer::Event event = {0, AnimPlayer::Operation::PlayLoop, {false, true}};
+    TEST_ASSERT_TRUE(player.sendEvent(event, false));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::vector<AnimPlayer::EventFuture> futures(AnimPlayer::EVENT_QUEUE_SIZE);
+    for (auto &future : futures) {
+        TEST_ASSERT_TRUE(player.sendEvent(event, false, &future));
+    }
+    AnimPlayer::EventFuture rejected_future;
+    TEST_ASSERT_FALSE(player.sendEvent(event, false, &rejected_future));
+    TEST_ASSERT_FALSE(rejected_future.valid());
+
+    // Clearing the queue finishes the queued events
+    TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, true));
+    for (auto &future : futures) {
+        test_wait_future(future);
+    }
+
+    TEST_ASSERT_TRUE(player.del());
+}
+
+TEST_CASE("test anim player compositor to flush only the layer areas", "[esp-brookesia][gui][anim_player]")
+{
+    // The top layer ends with frames which only flush a band, and are only complete with the rows of the last frame
+    TestAnimation animations[] = {
+        {test_make_sprite_frames(TEST_ANIM_FRAME_NUM), TEST_ANIM_FPS}, {test_make_band_frames(), TEST_ANIM_FPS},
+    };
+    AnimCompositor compositor;
+    TEST_ASSERT_TRUE(compositor.begin({
+        .canvas = {0, 0, TEST_COMPOSE_SIZE, TEST_COMPOSE_SIZE},
+        .buffer_in_ext = false,
+    }));
+
+    // The layers overlap diagonally, so the bounding box of both would also cover two corners of the canvas
+    AnimPlayerCanvasConfig canvases[] = {
+        {0, 0, TEST_ANIM_WIDTH, TEST_ANIM_HEIGHT},
+        {TEST_LAYER_OFFSET, TEST_LAYER_OFFSET, TEST_ANIM_WIDTH, TEST_ANIM_HEIGHT},
+    };
+    auto is_in_layer = [&](int x_start, int y_start, int x_end, int y_end) {
+        return std::any_of(std::begin(canvases), std::end(canvases), [&](const AnimPlayerCanvasConfig & canvas) {
+            return (x_start >= canvas.coord_x) && (y_start >= canvas.coord_y) &&
+                   (x_end <= canvas.coord_x + canvas.width) && (y_end <= canvas.coord_y + canvas.height);
+        });
+    };
+    std::atomic<int> rects = 0;
+    std::atomic<int> invalid_rects = 0;
+    std::mutex screen_mutex;
+    TestFrame screen(TEST_COMPOSE_SIZE * TEST_COMPOSE_SIZE);
+    boost::signals2::scoped_connection connection = AnimCompositor::flush_ready_signal.connect(
+    [&](int x_start, int y_start, int x_end, int y_end, const void *data, AnimCompositor * compositor) {
+        rects++;
+        invalid_rects += !is_in_layer(x_start, y_start, x_end, y_end);
+        {
+            std::lock_guard lock(screen_mutex);
+            auto src = static_cast<const uint16_t *>(data);
+            int width = x_end - x_start;
+            for (int y = y_start; y < y_end; y++) {
+                memcpy(
+                    &screen[y * TEST_COMPOSE_SIZE + x_start], src + (y - y_start) * width, width * sizeof(uint16_t)
+                );
+            }
+        }
+        compositor->notifyFlushFinished();
+    });
+
+    AnimPlayer players[2];
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(compositor.attach(players[i], canvases[i], {}));
+        auto data = animations[i].getPlayerData();
+        data.canvas = canvases[i];
+        TEST_ASSERT_TRUE(players[i].begin(data));
+    }
+    // The last frames are kept after the animations, instead of being cleared
+    AnimPlayer::EventFuture futures[2];
+    for (int i = 0; i < 2; i++) {
+        AnimPlayer::Event event = {0, AnimPlayer::Operation::PlayOncePause, {true, true}};
+        TEST_ASSERT_TRUE(players[i].sendEvent(event, true, &futures[i]));
+    }
+    for (auto &future : futures) {
+        test_wait_future(future);
+    }
+    // The canvas ends with the last frame of each layer in z-order
+    TestFrame expected(TEST_COMPOSE_SIZE * TEST_COMPOSE_SIZE);
+    for (int i = 0; i < 2; i++) {
+        auto &canvas = canvases[i];
+        for (int y = 0; y < canvas.height; y++) {
+            memcpy(
+                &expected[(canvas.coord_y + y) * TEST_COMPOSE_SIZE + canvas.coord_x],
+                &animations[i].frames.back()[y * TEST_ANIM_WIDTH], canvas.width * sizeof(uint16_t)
+            );
+        }
+    }
+    // The last frames are composed by the compositor thread after the players finish
+    int64_t start_us = esp_timer_get_time();
+    while (esp_timer_get_time() - start_us < TEST_PLAY_TIMEOUT_MS * 1000) {
+        {
+            std::lock_guard lock(screen_mutex);
+            if (screen == expected) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (auto &player : players) {
+        TEST_ASSERT_TRUE(player.del());
+    }
+    TEST_ASSERT_TRUE(compositor.del());
+
+    TEST_ASSERT_GREATER_THAN(0, rects.load());
+    TEST_ASSERT_EQUAL(0, invalid_rects.load());
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected.data(), screen.data(), screen.size());
+}
+
+TEST_CASE("test anim player to start a segment from the middle", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_make_gradient_frames(TEST_ANIM_FRAME_NUM), TEST_ANIM_FPS);
+    AnimPlayer player;
+    TestSink sink;
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, animation.getPlayerData()));
+
+    AnimPlayer::Event event = {
+        .index = 0,
+        .operation = AnimPlayer::Operation::PlayLoop,
+        .flags = {true, true, true},
+        .segment = {TEST_SEGMENT_FROM, TEST_SEGMENT_TO, TEST_SEGMENT_START},
+    };
+    TEST_ASSERT_TRUE(player.sendEvent(event, true));
+    test_wait_frames(sink, TEST_SEGMENT_FRAME_NUM);
+    AnimPlayer::EventFuture future;
+    TEST_ASSERT_TRUE(player.sendEvent({0, AnimPlayer::Operation::Stop, {true, true}}, true, &future));
+    test_wait_future(future);
+
+    // The first loop starts from the start frame, and the next ones from the first frame of the segment
+    std::lock_guard lock(sink.mutex);
+    int expected_frame = TEST_SEGMENT_START;
+    for (auto pixel : sink.first_pixels) {
+        TEST_ASSERT_EQUAL(expected_frame, pixel / TEST_GRADIENT_FRAME_STEP);
+        expected_frame = (expected_frame == TEST_SEGMENT_TO) ? TEST_SEGMENT_FROM : expected_frame + 1;
+    }
+    TEST_ASSERT_TRUE(player.del());
+}
+
+TEST_CASE("test anim player to reject invalid segments", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_make_gradient_frames(TEST_ANIM_FRAME_NUM), TEST_ANIM_FPS);
+    AnimPlayer player;
+    TestSink sink;
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, animation.getPlayerData()));
+
+    // The events are finished without playing anything
+    std::pair<int, int> invalid_segments[] = {
+        {-1, AnimPlayer::FRAME_LAST}, {TEST_ANIM_FRAME_NUM, AnimPlayer::FRAME_LAST}, {5, 3},
+    };
+    for (auto [from, to] : invalid_segments) {
+        AnimPlayer::EventFuture future;
+        TEST_ASSERT_TRUE(player.play(0, from, to, false, &future));
+        test_wait_future(future);
+    }
+    AnimPlayer::EventFuture future;
+    TEST_ASSERT_TRUE(player.play(1, 0, AnimPlayer::FRAME_LAST, false, &future));
+    test_wait_future(future);
+    TEST_ASSERT_EQUAL(0, sink.flushes);
+
+    // The end of the segment is clamped to the last frame
+    TEST_ASSERT_TRUE(player.play(0, TEST_ANIM_FRAME_NUM - 2, TEST_ANIM_FRAME_NUM + 10, false, &future));
+    test_wait_future(future);
+    TEST_ASSERT_EQUAL(2, sink.frames);
+    TEST_ASSERT_TRUE(sink.screen == animation.frames.back());
+    TEST_ASSERT_TRUE(player.del());
+}
+
+TEST_CASE("test anim player to keep the position after a pause", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_make_gradient_frames(TEST_ANIM_FRAME_NUM), TEST_SLOW_ANIM_FPS);
+    AnimPlayer player;
+    TestSink sink;
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, animation.getPlayerData()));
+    TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, true));
+    test_wait_frames(sink, 3);
+
+    AnimPlayer::EventFuture future;
+    TEST_ASSERT_TRUE(player.sendEvent({0, AnimPlayer::Operation::Pause, {true, true}}, true, &future));
+    test_wait_future(future);
+    auto position = player.getPosition();
+    int flushes = sink.flushes;
+    {
+        std::lock_guard lock(sink.mutex);
+        TEST_ASSERT_EQUAL(0, position.index);
+        TEST_ASSERT_EQUAL(position.frame, sink.first_pixels.back() / TEST_GRADIENT_FRAME_STEP);
+    }
+
+    // Nothing is played after the pause
+    std::this_thread::sleep_for(std::chrono::milliseconds(3000 / TEST_SLOW_ANIM_FPS));
+    TEST_ASSERT_EQUAL(0, player.getPosition().index);
+    TEST_ASSERT_EQUAL(position.frame, player.getPosition().frame);
+    TEST_ASSERT_EQUAL(flushes, sink.flushes);
+    TEST_ASSERT_TRUE(player.del());
+}
+
+static TestFrame test_swap_frame(TestFrame frame)
+{
+    for (auto &pixel : frame) {
+        pixel = static_cast<uint16_t>((pixel << 8) | (pixel >> 8));
+    }
+
+    return frame;
+}
+
+TEST_CASE("test anim player tile decoder to swap bytes", "[esp-brookesia][gui][anim_player]")
+{
+    // The sprite frames have both raw and RLE tiles
+    TestAnimation animation(test_make_sprite_frames(TEST_ANIM_FRAME_NUM), TEST_ANIM_FPS);
+    auto &frames = animation.frames;
+    std::vector<AnimTileDecoder::Rect> rects;
+    for (bool swap_bytes : {false, true}) {
+        AnimTileDecoder decoder;
+        TEST_ASSERT_TRUE(decoder.begin(animation.asset.data(), animation.asset.size(), false, swap_bytes));
+        TestFrame screen(TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT);
+        for (int i = 0; i < TEST_ANIM_FRAME_NUM; i++) {
+            TEST_ASSERT_TRUE(decoder.decodeFrame(i));
+            decoder.takeDirtyRects(rects);
+            for (auto &rect : rects) {
+                memcpy(
+                    &screen[rect.y_start * TEST_ANIM_WIDTH], rect.data,
+                    (rect.y_end - rect.y_start) * TEST_ANIM_WIDTH * sizeof(uint16_t)
+                );
+            }
+            TestFrame expected = swap_bytes ? test_swap_frame(frames[i]) : frames[i];
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(expected.data(), screen.data(), screen.size());
+        }
+        TEST_ASSERT_TRUE(decoder.del());
+    }
+
+    // The player passes the swap flag to the decoder
+    AnimPlayer player;
+    TestSink sink;
+    auto data = animation.getPlayerData();
+    data.flags.enable_data_swap_bytes = true;
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, data));
+    AnimPlayer::EventFuture future;
+    TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, false, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(sink.screen == test_swap_frame(frames.back()));
+    TEST_ASSERT_TRUE(player.del());
+}
+
+TEST_CASE("test anim player to swap bytes on the decoder path", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_decoder_asset_start, test_decoder_asset_end, TEST_ANIM_FPS);
+    // The first loop is decoded and recorded, then the next ones are replayed from the cache
+    AnimPlayer::Event event = {
+        .index = 0,
+        .operation = AnimPlayer::Operation::PlayLoop,
+        .flags = {true, true, true},
+        .segment = {0, TEST_CACHE_SEGMENT_FRAME_NUM - 1, 0},
+    };
+    size_t frame_num = TEST_CACHE_SEGMENT_FRAME_NUM * TEST_SWAP_LOOP_NUM;
+
+    // Not swapped, swapped by the decoder, and swapped by the player while copying into the pipeline and the cache
+    std::vector<TestFrame> screens[3];
+    for (int i = 0; i < 3; i++) {
+        AnimPlayer player;
+        TestSink sink;
+        auto &frame_screens = screens[i];
+        auto data = animation.getPlayerData();
+        data.flags.enable_data_swap_bytes = (i > 0);
+        data.task.pipeline_depth = (i == 2) ? 2 : 1;
+        data.cache.budget_bytes = TEST_CACHE_SEGMENT_FRAME_NUM * TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT * sizeof(uint16_t);
+        TEST_ASSERT_TRUE(player.setOutputHandler({
+            .flush = [&sink, &frame_screens](int x_start, int y_start, int x_end, int y_end, const void *data)
+            {
+                sink.flush(x_start, y_start, x_end, y_end, data);
+                if (y_end == TEST_ANIM_HEIGHT) {
+                    std::lock_guard lock(sink.mutex);
+                    frame_screens.push_back(sink.screen);
+                }
+            },
+            .clear = [](int x_start, int y_start, int x_end, int y_end) {},
+        }));
+        TEST_ASSERT_TRUE(player.begin(data));
+        TEST_ASSERT_TRUE(player.sendEvent(event, true));
+        // The frame after the last one has started, so the last one is complete
+        test_wait_frames(sink, frame_num + 1);
+        TEST_ASSERT_TRUE(player.del());
+        TEST_ASSERT_GREATER_OR_EQUAL(frame_num, frame_screens.size());
+    }
+    // The decoder may already be in the next frame when a loop ends, so the frames are not compared one by one
+    for (int i = 1; i < 3; i++) {
+        for (auto &screen : screens[i]) {
+            auto unswapped = test_swap_frame(screen);
+            TEST_ASSERT_TRUE(std::find(screens[0].begin(), screens[0].end(), unswapped) != screens[0].end());
+        }
+    }
+}
+
+TEST_CASE("test anim player to reject a corrupted animation", "[esp-brookesia][gui][anim_player]")
+{
+    // The last byte is in the data of the last frame, which is only covered by the checksum of the animation
+    std::vector<uint8_t> asset(test_decoder_asset_start, test_decoder_asset_end);
+    asset.back() ^= 0xff;
+    TEST_ASSERT_TRUE(AnimAssetVerifier::checkAsset(test_decoder_asset_start, asset.size()));
+    TEST_ASSERT_FALSE(AnimAssetVerifier::checkAsset(asset.data(), asset.size()));
+
+    AnimAssetVerifier verifier;
+    TEST_ASSERT_TRUE(verifier.begin({{test_decoder_asset_start, asset.size()}, {asset.data(), asset.size()}}, {}));
+    TEST_ASSERT_TRUE(verifier.verify(0));
+    TEST_ASSERT_FALSE(verifier.verify(1));
+    TEST_ASSERT_TRUE(verifier.getState(1) == AnimAssetVerifier::State::Invalid);
+    TEST_ASSERT_TRUE(verifier.del());
+
+    // The play event is finished without handing the data to the decoder
+    TestAnimation animation(asset.data(), asset.data() + asset.size(), TEST_ANIM_FPS);
+    AnimPlayer player;
+    TestSink sink;
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, animation.getPlayerData()));
+    AnimPlayer::EventFuture future;
+    TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, false, &future));
+    test_wait_future(future);
+    TEST_ASSERT_EQUAL(0, sink.flushes);
+    TEST_ASSERT_TRUE(player.del());
+}
+
+TEST_CASE("test anim player to reject a corrupted tile animation", "[esp-brookesia][gui][anim_player]")
+{
+    TestAnimation animation(test_make_gradient_frames(TEST_ANIM_FRAME_NUM), TEST_ANIM_FPS);
+    TEST_ASSERT_TRUE(AnimTileDecoder::checkAsset(animation.asset.data(), animation.asset.size()));
+
+    // The last byte is a pixel of the last frame, which still decodes but no longer matches the checksum
+    animation.asset.back() ^= 0xff;
+    TEST_ASSERT_FALSE(AnimTileDecoder::checkAsset(animation.asset.data(), animation.asset.size()));
+
+    AnimPlayer player;
+    TestSink sink;
+    TEST_ASSERT_TRUE(test_begin_player(player, sink, animation.getPlayerData()));
+    AnimPlayer::EventFuture future;
+    TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, false, &future));
+    test_wait_future(future);
+    TEST_ASSERT_EQUAL(0, sink.flushes);
+    TEST_ASSERT_TRUE(player.del());
+}
+TEST_CASE("test anim player to skip late frames with a slow output", "[esp-brookesia][gui][anim_player]")
+{
+    // Frames which follow a gap are caught up from the last decoded frame, without decoding the skipped ones
+    TestAnimation tile_animation(test_make_sprite_frames(TEST_ANIM_FRAME_NUM), TEST_PACING_FPS);
+    std::vector<AnimTileDecoder::Rect> rects;
+    AnimTileDecoder decoder;
+    TEST_ASSERT_TRUE(decoder.begin(tile_animation.asset.data(), tile_animation.asset.size(), false, false));
+    TestFrame screen(TEST_ANIM_WIDTH * TEST_ANIM_HEIGHT);
+    for (int i : {0, 3, 4, 9, TEST_ANIM_FRAME_NUM - 1, 2}) {
+        TEST_ASSERT_TRUE(decoder.decodeFrame(i));
+        decoder.takeDirtyRects(rects);
+        for (auto &rect : rects) {
+            memcpy(
+                &screen[rect.y_start * TEST_ANIM_WIDTH], rect.data,
+                (rect.y_end - rect.y_start) * TEST_ANIM_WIDTH * sizeof(uint16_t)
+            );
+        }
+        TEST_ASSERT_TRUE(screen == tile_animation.frames[i]);
+    }
+    TEST_ASSERT_TRUE(decoder.del());
+
+    // Each frame takes longer to flush than its period, so every frame is either flushed or skipped
+    TestAnimation gradient_animation(test_make_gradient_frames(TEST_ANIM_FRAME_NUM), TEST_PACING_FPS);
+    TestAnimation decoder_animation(test_decoder_asset_start, test_decoder_asset_end, TEST_PACING_FPS);
+    AnimFrameIndex frame_index;
+    TEST_ASSERT_TRUE(frame_index.build(decoder_animation.address.data_address, decoder_animation.address.data_length));
+    std::pair<TestAnimation *, int> animations[] = {
+        {&gradient_animation, TEST_ANIM_FRAME_NUM}, {&decoder_animation, frame_index.getFrameNum()},
+    };
+    for (auto [animation, frame_num] : animations) {
+        AnimPlayer player;
+        TestSink sink;
+        sink.latency_us = TEST_PACING_FLUSH_LATENCY_US;
+        auto data = animation->getPlayerData();
+        data.pacing.enable_frame_skip = true;
+        data.pacing.max_skip_frames = TEST_PACING_MAX_SKIP_FRAMES;
+        TEST_ASSERT_TRUE(test_begin_player(player, sink, data));
+
+        AnimPlayer::EventFuture future;
+        TEST_ASSERT_TRUE(player.play(0, 0, AnimPlayer::FRAME_LAST, false, &future));
+        TEST_ASSERT_TRUE(
+            future.wait_for(std::chrono::milliseconds(TEST_PLAY_TIMEOUT_MS * 4)) == std::future_status::ready
+        );
+        ESP_LOGI(
+            TAG, "Pacing with a %d us sink: frames(%d), flushed(%d), skipped(%d)", TEST_PACING_FLUSH_LATENCY_US,
+            frame_num, sink.frames, static_cast<int>(player.getSkippedFrameNum())
+        );
+        TEST_ASSERT_GREATER_THAN(0, player.getSkippedFrameNum());
+        TEST_ASSERT_EQUAL(frame_num, sink.frames + static_cast<int>(player.getSkippedFrameNum()));
+        TEST_ASSERT_TRUE(player.del());
+    }
+}
+#endif
@@ -0,0 +1,251 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "esp_brookesia.hpp"
+
+using namespace esp_brookesia::systems::base;
+
+#define TEST_BENCHMARK_ROUNDS           (20)
+#define TEST_BENCHMARK_SEND_TIMES       (10)
+#define TEST_SLOW_HANDLER_US            (2000)
+#define TEST_SLOW_HANDLER_CALLS         (5)
+
+static const char *TAG = "test_base_event";
+
+static int test_handler_calls = 0;
+
+static bool test_handler(const Event::HandlerData &data)
+{
+    test_handler_calls++;
+    return true;
+}
+
+static bool test_other_handler(const Event::HandlerData &data)
+{
+    test_handler_calls += 10;
+    return true;
+}
+
+TEST_CASE("test base event to dispatch and recycle IDs", "[esp-brookesia][base][event]")
+{
+    Event event;
+    int object_a = 0;
+    int object_b = 0;
+
+    auto id = event.getFreeEventID();
+    auto other_id = event.getFreeEventID();
+    TEST_ASSERT_TRUE(id > Event::ID::CUSTOM);
+    TEST_ASSERT_TRUE(event.registerEvent(&object_a, test_handler, id));
+    TEST_ASSERT_TRUE(event.registerEvent(&object_a, test_other_handler, id));
+    TEST_ASSERT_TRUE(event.registerEvent(&object_b, test_handler, id));
+    TEST_ASSERT_TRUE(event.registerEvent(&object_a, test_handler, Event::ID::APP));
+
+    // Only the handlers of the object are called
+    test_handler_calls = 0;
+    TEST_ASSERT_TRUE(event.sendEvent(&object_a, id));
+    TEST_ASSERT_EQUAL(11, test_handler_calls);
+    test_handler_calls = 0;
+    TEST_ASSERT_TRUE(event.sendEvent(&object_b, id));
+    TEST_ASSERT_TRUE(event.sendEvent(&object_b, other_id));
+    TEST_ASSERT_EQUAL(1, test_handler_calls);
+
+    // The ID is only recycled once all its handlers are unregistered
+    event.unregisterEvent(&object_a);
+    test_handler_calls = 0;
+    TEST_ASSERT_TRUE(event.sendEvent(&object_a, id));
+    TEST_ASSERT_TRUE(event.sendEvent(&object_a, Event::ID::APP));
+    TEST_ASSERT_EQUAL(0, test_handler_calls);
+    event.unregisterEvent(&object_b, test_handler, id);
+    TEST_ASSERT_TRUE(event.getFreeEventID() == id);
+
+    // Built-in IDs are never recycled
+    event.unregisterEvent(Event::ID::NAVIGATION);
+    event.unregisterEvent(other_id);
+    TEST_ASSERT_TRUE(event.getFreeEventID() == other_id);
+    TEST_ASSERT_TRUE(event.getFreeEventID() > other_id);
+
+    event.reset();
+    TEST_ASSERT_TRUE(event.getFreeEventID() == id);
+}
+
+static void *test_merger(void *pending_param, void *new_param)
+{
+    return reinterpret_cast<void *>(reinterpret_cast<intptr_t>(pending_param) + reinterpret_cast<intptr_t>(new_param));
+}
+
+static intptr_t test_last_param = 0;
+
+static bool test_param_handler(const Event::HandlerData &data)
+{
+    test_handler_calls++;
+    test_last_param = reinterpret_cast<intptr_t>(data.param);
+    return true;
+}
+
+TEST_CASE("test base event to post and coalesce events", "[esp-brookesia][base][event]")
+{
+    Event event;
+    int object = 0;
+    int dispatch_requests = 0;
+
+    event.setDispatchRequestCallback([&]() {
+        dispatch_requests++;
+    });
+    auto keep_all_id = event.getFreeEventID();
+    auto keep_last_id = event.getFreeEventID();
+    auto merge_id = event.getFreeEventID();
+    TEST_ASSERT_FALSE(event.setCoalescePolicy(merge_id, Event::CoalescePolicy::MERGE));
+    TEST_ASSERT_TRUE(event.setCoalescePolicy(keep_last_id, Event::CoalescePolicy::KEEP_LAST));
+    TEST_ASSERT_TRUE(event.setCoalescePolicy(merge_id, Event::CoalescePolicy::MERGE, test_merger));
+    for (auto id : {keep_all_id, keep_last_id, merge_id}) {
+        TEST_ASSERT_TRUE(event.registerEvent(&object, test_param_handler, id));
+    }
+
+    // Nothing is dispatched until the queue is drained, and only the first post requests a dispatch
+    test_handler_calls = 0;
+    for (intptr_t i = 1; i <= 3; i++) {
+        TEST_ASSERT_TRUE(event.postEvent(&object, keep_all_id, reinterpret_cast<void *>(i)));
+    }
+    TEST_ASSERT_EQUAL(0, test_handler_calls);
+    TEST_ASSERT_EQUAL(1, dispatch_requests);
+    TEST_ASSERT_EQUAL(3, event.dispatchPendingEvents());
+    TEST_ASSERT_EQUAL(3, test_handler_calls);
+    TEST_ASSERT_EQUAL(3, test_last_param);
+
+    test_handler_calls = 0;
+    for (intptr_t i = 1; i <= 3; i++) {
+        TEST_ASSERT_TRUE(event.postEvent(&object, keep_last_id, reinterpret_cast<void *>(i)));
+    }
+    TEST_ASSERT_EQUAL(1, event.dispatchPendingEvents());
+    TEST_ASSERT_EQUAL(1, test_handler_calls);
+    TEST_ASSERT_EQUAL(3, test_last_param);
+
+    test_handler_calls = 0;
+    for (intptr_t i = 1; i <= 3; i++) {
+        TEST_ASSERT_TRUE(event.postEvent(&object, merge_id, reinterpret_cast<void *>(i)));
+    }
+    TEST_ASSERT_EQUAL(1, event.dispatchPendingEvents());
+    TEST_ASSERT_EQUAL(1, test_handler_calls);
+    TEST_ASSERT_EQUAL(6, test_last_param);
+
+    // The pending events of an unregistered object are dropped
+    test_handler_calls = 0;
+    TEST_ASSERT_TRUE(event.postEvent(&object, keep_all_id));
+    event.unregisterEvent(&object);
+    TEST_ASSERT_EQUAL(0, event.dispatchPendingEvents());
+    TEST_ASSERT_EQUAL(0, test_handler_calls);
+    TEST_ASSERT_EQUAL(4, dispatch_requests);
+}
+
+#if CONFIG_ESP_BROOKESIA_BASE_EVENT_ENABLE_TRACE
+static bool test_slow_handler(const Event::HandlerData &data)
+{
+    int64_t start_us = esp_timer_get_time();
+    while (esp_timer_get_time() - start_us < TEST_SLOW_HANDLER_US) {
+    }
+    return true;
+}
+
+TEST_CASE("test base event to trace handlers", "[esp-brookesia][base][event]")
+{
+    Event event;
+    int object = 0;
+    std::vector<Event::HandlerTrace> traces;
+
+    auto id = event.getFreeEventID();
+    TEST_ASSERT_TRUE(event.registerEvent(&object, test_handler, id));
+    TEST_ASSERT_TRUE(event.registerEvent(&object, test_slow_handler, id));
+    Event::resetHandlerTraces();
+    Event::setSlowHandlerThreshold(TEST_SLOW_HANDLER_US / 2);
+    for (int i = 0; i < TEST_SLOW_HANDLER_CALLS; i++) {
+        TEST_ASSERT_TRUE(event.sendEvent(&object, id));
+    }
+    Event::dumpHandlerTraces();
+
+    TEST_ASSERT_TRUE(Event::getHandlerTraces(traces));
+    auto slow_it = std::find_if(traces.begin(), traces.end(), [&](const Event::HandlerTrace & trace) {
+        return (trace.id == id) && (trace.handler == test_slow_handler);
+    });
+    TEST_ASSERT_TRUE(slow_it != traces.end());
+    TEST_ASSERT_EQUAL(TEST_SLOW_HANDLER_CALLS, slow_it->calls);
+    TEST_ASSERT_GREATER_OR_EQUAL(TEST_SLOW_HANDLER_US, slow_it->max_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(TEST_SLOW_HANDLER_US * TEST_SLOW_HANDLER_CALLS, slow_it->total_us);
+
+    Event::setSlowHandlerThreshold(CONFIG_ESP_BROOKESIA_BASE_EVENT_TRACE_SLOW_HANDLER_US);
+    Event::resetHandlerTraces();
+}
+#endif
+
+TEST_CASE("test base event register and unregister benchmark", "[esp-brookesia][base][event]")
+{
+    Event event;
+
+    // Like APPs and widgets, every object gets its own ID and also listens to a built-in one
+    for (int object_num : {16, 64, 256}) {
+        std::vector<int> objects(object_num);
+        std::vector<Event::ID> ids(object_num);
+        int64_t register_us = 0;
+        int64_t send_us = 0;
+        int64_t shared_send_us = 0;
+        int64_t unregister_us = 0;
+
+        for (int round = 0; round < TEST_BENCHMARK_ROUNDS; round++) {
+            int64_t start_us = esp_timer_get_time();
+            for (int i = 0; i < object_num; i++) {
+                ids[i] = event.getFreeEventID();
+                TEST_ASSERT_TRUE(event.registerEvent(&objects[i], test_handler, ids[i]));
+                TEST_ASSERT_TRUE(event.registerEvent(&objects[i], test_handler, Event::ID::NAVIGATION));
+            }
+            register_us += esp_timer_get_time() - start_us;
+
+            test_handler_calls = 0;
+            start_us = esp_timer_get_time();
+            for (int times = 0; times < TEST_BENCHMARK_SEND_TIMES; times++) {
+                for (int i = 0; i < object_num; i++) {
+                    event.sendEvent(&objects[i], ids[i]);
+                }
+            }
+            send_us += esp_timer_get_time() - start_us;
+            TEST_ASSERT_EQUAL(object_num * TEST_BENCHMARK_SEND_TIMES, test_handler_calls);
+
+            // All the objects share the built-in ID, but only the handlers of the target object are visited
+            test_handler_calls = 0;
+            start_us = esp_timer_get_time();
+            for (int times = 0; times < TEST_BENCHMARK_SEND_TIMES; times++) {
+                for (int i = 0; i < object_num; i++) {
+                    event.sendEvent(&objects[i], Event::ID::NAVIGATION);
+                }
+            }
+            shared_send_us += esp_timer_get_time() - start_us;
+            TEST_ASSERT_EQUAL(object_num * TEST_BENCHMARK_SEND_TIMES, test_handler_calls);
+
+            start_us = esp_timer_get_time();
+            for (int i = 0; i < object_num; i++) {
+                event.unregisterEvent(ids[i]);
+                event.unregisterEvent(&objects[i]);
+            }
+            unregister_us += esp_timer_get_time() - start_us;
+        }
+
+        int ops = object_num * TEST_BENCHMARK_ROUNDS;
+        int send_ops = ops * TEST_BENCHMARK_SEND_TIMES;
+        ESP_LOGI(
+            TAG, "Objects(%d): register(%.2f us), send(%.2f us), shared ID send(%.2f us), unregister(%.2f us) per "
+            "object", object_num, static_cast<double>(register_us) / ops, static_cast<double>(send_us) / send_ops,
+            static_cast<double>(shared_send_us) / send_ops, static_cast<double>(unregister_us) / ops
+        );
+
+        // All the IDs are recycled, so the table doesn't grow between rounds
+        TEST_ASSERT_TRUE(event.getFreeEventID() <= static_cast<Event::ID>(static_cast<int>(Event::ID::CUSTOM) + 256));
+        event.reset();
+    }
+}
@@ -33,8 +33,10 @@ using namespace esp_brookesia::systems::phone;
 #define TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET()   STYLESHEET_800_480_DARK
 #elif (TEST_LVGL_RESOLUTION_WIDTH == 800) && (TEST_LVGL_RESOLUTION_HEIGHT == 1280)
 #define TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET()   STYLESHEET_800_1280_DARK
+#define TEST_ESP_BROOKESIA_PHONE_DARK_CALIBRATED_STYLESHEET()   STYLESHEET_800_1280_DARK_CALIBRATED
 #elif (TEST_LVGL_RESOLUTION_WIDTH == 1024) && (TEST_LVGL_RESOLUTION_HEIGHT == 600)
 #define TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET()   STYLESHEET_1024_600_DARK
+#define TEST_ESP_BROOKESIA_PHONE_DARK_CALIBRATED_STYLESHEET()   STYLESHEET_1024_600_DARK_CALIBRATED
 #elif (TEST_LVGL_RESOLUTION_WIDTH == 1280) && (TEST_LVGL_RESOLUTION_HEIGHT == 800)
 #define TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET()   STYLESHEET_1280_800_DARK
 #endif
@@ -73,6 +75,85 @@ TEST_CASE("test esp-brookesia to begin and delete", "[esp-brookesia][phone][begi
     test_lvgl_deinit(disp, tp);
 }
 
+TEST_CASE("test esp-brookesia to post events", "[esp-brookesia][phone][post_event]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    systems::phone::Phone *phone = nullptr;
+    int data_update_count = 0;
+    int navigate_count = 0;
+    auto count_event = [](lv_event_t *event) {
+        (*static_cast<int *>(lv_event_get_user_data(event)))++;
+    };
+
+    test_lvgl_init(&disp, &tp);
+    phone = test_esp_brookesia_phone_init(disp, tp, true);
+    TEST_ASSERT_TRUE(phone->registerDateUpdateEventCallback(count_event, &data_update_count));
+    TEST_ASSERT_TRUE(phone->registerNavigateEventCallback(count_event, &navigate_count));
+
+    // The posted data updates are coalesced into one, while every navigate event is kept
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(phone->postDataUpdateEvent());
+    }
+    TEST_ASSERT_TRUE(phone->postNavigateEvent(systems::base::Manager::NavigateType::BACK));
+    TEST_ASSERT_TRUE(phone->postNavigateEvent(systems::base::Manager::NavigateType::BACK));
+    TEST_ASSERT_EQUAL(0, data_update_count);
+    TEST_ASSERT_EQUAL(0, navigate_count);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, data_update_count);
+    TEST_ASSERT_EQUAL(2, navigate_count);
+
+    TEST_ASSERT_TRUE(phone->unregisterDateUpdateEventCallback(count_event, &data_update_count));
+    TEST_ASSERT_TRUE(phone->unregisterNavigateEventCallback(count_event, &navigate_count));
+    test_esp_brookesia_phone_deinit(phone);
+    test_lvgl_deinit(disp, tp);
+}
+
+struct TestDataUpdate {
+    systems::phone::Phone *phone;
+    int widget_a;
+    int widget_b;
+    bool is_widget_a_updated;
+    bool is_widget_b_updated;
+};
+
+TEST_CASE("test esp-brookesia to update data partially", "[esp-brookesia][phone][data_update]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    TestDataUpdate update = {};
+    auto check_update = [](lv_event_t *event) {
+        auto update = static_cast<TestDataUpdate *>(lv_event_get_user_data(event));
+        update->is_widget_a_updated = update->phone->checkDataUpdated(update->widget_a);
+        update->is_widget_b_updated = update->phone->checkDataUpdated(update->widget_b);
+    };
+
+    test_lvgl_init(&disp, &tp);
+    update.phone = test_esp_brookesia_phone_init(disp, tp, true);
+    TEST_ASSERT_TRUE(update.phone->registerDateUpdateEventCallback(check_update, &update));
+
+    // Only the listeners of the updated data are notified
+    TEST_ASSERT_TRUE(update.phone->sendDataUpdateEvent({{&update.widget_a, sizeof(update.widget_a)}}));
+    TEST_ASSERT_TRUE(update.is_widget_a_updated);
+    TEST_ASSERT_FALSE(update.is_widget_b_updated);
+
+    // The default fonts of the display are used by all the widgets
+    auto &display_data = update.phone->getData().display;
+    TEST_ASSERT_TRUE(update.phone->sendDataUpdateEvent({{&display_data.text, sizeof(display_data.text)}}));
+    TEST_ASSERT_TRUE(update.is_widget_a_updated);
+    TEST_ASSERT_TRUE(update.is_widget_b_updated);
+
+    // All the data is updated by a full update, and out of the event
+    TEST_ASSERT_TRUE(update.phone->sendDataUpdateEvent());
+    TEST_ASSERT_TRUE(update.is_widget_a_updated);
+    TEST_ASSERT_TRUE(update.is_widget_b_updated);
+    TEST_ASSERT_TRUE(update.phone->checkDataUpdated(update.widget_b));
+
+    TEST_ASSERT_TRUE(update.phone->unregisterDateUpdateEventCallback(check_update, &update));
+    test_esp_brookesia_phone_deinit(update.phone);
+    test_lvgl_deinit(disp, tp);
+}
+
 #ifdef TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET
 TEST_CASE("test esp-brookesia to add stylesheet", "[esp-brookesia][phone][add_stylesheet]")
 {
@@ -93,6 +174,141 @@ TEST_CASE("test esp-brookesia to add stylesheet", "[esp-brookesia][phone][add_st
     test_esp_brookesia_phone_deinit(phone);
     test_lvgl_deinit(disp, tp);
 }
+
+#ifdef TEST_ESP_BROOKESIA_PHONE_DARK_CALIBRATED_STYLESHEET
+TEST_CASE("test esp-brookesia to add calibrated stylesheet", "[esp-brookesia][phone][add_stylesheet]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    systems::phone::Phone *phone = nullptr;
+    const systems::phone::Stylesheet &calibrated_stylesheet = TEST_ESP_BROOKESIA_PHONE_DARK_CALIBRATED_STYLESHEET();
+
+    test_lvgl_init(&disp, &tp);
+    phone = test_esp_brookesia_phone_init(disp, tp, false);
+
+    // The stylesheet calibrated at build time ends up the same as the one calibrated at runtime
+    TEST_ASSERT_TRUE(phone->addStylesheet(TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET()));
+    const char *name = calibrated_stylesheet.core.name;
+    const gui::StyleSize &screen_size = calibrated_stylesheet.core.screen_size;
+    auto runtime_stylesheet = phone->getStylesheet(name, screen_size);
+    TEST_ASSERT_NOT_NULL(runtime_stylesheet);
+    systems::phone::Stylesheet expected_stylesheet = *runtime_stylesheet;
+    TEST_ASSERT_TRUE(phone->addCalibratedStylesheet(calibrated_stylesheet));
+    TEST_ASSERT_TRUE(expected_stylesheet == *phone->getStylesheet(name, screen_size));
+    TEST_ASSERT_TRUE(phone->activateStylesheet(calibrated_stylesheet));
+    TEST_ASSERT_TRUE(phone->begin());
+
+    test_esp_brookesia_phone_deinit(phone);
+    test_lvgl_deinit(disp, tp);
+}
+#endif
+
+struct TestBackgroundUpdate {
+    systems::phone::Phone *phone;
+    bool is_display_updated;
+    bool is_status_bar_updated;
+    bool is_app_launcher_updated;
+};
+
+TEST_CASE("test esp-brookesia to update only the display for a new background", "[esp-brookesia][phone][data_update]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    TestBackgroundUpdate update = {};
+    auto check_update = [](lv_event_t *event) {
+        auto update = static_cast<TestBackgroundUpdate *>(lv_event_get_user_data(event));
+        auto stylesheet = update->phone->getStylesheet();
+        update->is_display_updated = update->phone->checkDataUpdated(update->phone->getData().display);
+        update->is_status_bar_updated = update->phone->checkDataUpdated(stylesheet->display.status_bar);
+        update->is_app_launcher_updated = update->phone->checkDataUpdated(stylesheet->display.app_launcher);
+    };
+
+    test_lvgl_init(&disp, &tp);
+    update.phone = test_esp_brookesia_phone_init(disp, tp, false);
+
+    // The same stylesheet with only another background color
+    systems::phone::Stylesheet stylesheet = TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET();
+    systems::phone::Stylesheet background_stylesheet = stylesheet;
+    background_stylesheet.core.name = "test_background";
+    background_stylesheet.core.display.background.color.color ^= 0xFFFFFF;
+    TEST_ASSERT_TRUE(update.phone->addStylesheet(stylesheet));
+    TEST_ASSERT_TRUE(update.phone->addStylesheet(background_stylesheet));
+    TEST_ASSERT_TRUE(update.phone->activateStylesheet(stylesheet));
+    TEST_ASSERT_TRUE(update.phone->begin());
+    TEST_ASSERT_TRUE(update.phone->registerDateUpdateEventCallback(check_update, &update));
+
+    TEST_ASSERT_TRUE(update.phone->activateStylesheet(background_stylesheet));
+    TEST_ASSERT_TRUE(update.is_display_updated);
+    TEST_ASSERT_FALSE(update.is_status_bar_updated);
+    TEST_ASSERT_FALSE(update.is_app_launcher_updated);
+
+    TEST_ASSERT_TRUE(update.phone->unregisterDateUpdateEventCallback(check_update, &update));
+    test_esp_brookesia_phone_deinit(update.phone);
+    test_lvgl_deinit(disp, tp);
+}
+
+struct TestThemeUpdate {
+    systems::phone::Phone *phone;
+    bool is_display_updated;
+    bool is_status_bar_updated;
+    bool is_navigation_bar_updated;
+    bool is_app_launcher_updated;
+    bool is_recents_screen_updated;
+};
+
+static void test_switch_theme(TestThemeUpdate &update, const systems::phone::Stylesheet &stylesheet)
+{
+    update = {.phone = update.phone};
+    TEST_ASSERT_TRUE(update.phone->activateStylesheet(stylesheet));
+    // Only the changed parts are copied, the active stylesheet still ends up the same as the activated one
+    TEST_ASSERT_TRUE(*update.phone->getStylesheet() == *update.phone->getStylesheetHandle());
+    TEST_ASSERT_TRUE(update.is_display_updated);
+    TEST_ASSERT_TRUE(update.is_status_bar_updated);
+    TEST_ASSERT_TRUE(update.is_navigation_bar_updated);
+    TEST_ASSERT_FALSE(update.is_app_launcher_updated);
+    TEST_ASSERT_FALSE(update.is_recents_screen_updated);
+}
+
+TEST_CASE("test esp-brookesia to switch between dark and light stylesheets", "[esp-brookesia][phone][data_update]")
+{
+    lv_display_t *disp = nullptr;
+    lv_indev_t *tp = nullptr;
+    TestThemeUpdate update = {};
+    auto check_update = [](lv_event_t *event) {
+        auto update = static_cast<TestThemeUpdate *>(lv_event_get_user_data(event));
+        auto stylesheet = update->phone->getStylesheet();
+        update->is_display_updated = update->phone->checkDataUpdated(update->phone->getData().display);
+        update->is_status_bar_updated = update->phone->checkDataUpdated(stylesheet->display.status_bar);
+        update->is_navigation_bar_updated = update->phone->checkDataUpdated(stylesheet->display.navigation_bar);
+        update->is_app_launcher_updated = update->phone->checkDataUpdated(stylesheet->display.app_launcher);
+        update->is_recents_screen_updated = update->phone->checkDataUpdated(stylesheet->display.recents_screen);
+    };
+
+    test_lvgl_init(&disp, &tp);
+    update.phone = test_esp_brookesia_phone_init(disp, tp, false);
+
+    // Only dark stylesheets are shipped, so make a light one by inverting the colors of the background and the bars
+    systems::phone::Stylesheet dark_stylesheet = TEST_ESP_BROOKESIA_PHONE_DARK_STYLESHEET();
+    systems::phone::Stylesheet light_stylesheet = dark_stylesheet;
+    light_stylesheet.core.name = "test_light";
+    light_stylesheet.core.display.background.color.color ^= 0xFFFFFF;
+    light_stylesheet.display.status_bar.data.main.background_color.color ^= 0xFFFFFF;
+    light_stylesheet.display.status_bar.data.main.text_color.color ^= 0xFFFFFF;
+    light_stylesheet.display.navigation_bar.data.main.background_color.color ^= 0xFFFFFF;
+    TEST_ASSERT_TRUE(update.phone->addStylesheet(dark_stylesheet));
+    TEST_ASSERT_TRUE(update.phone->addStylesheet(light_stylesheet));
+    TEST_ASSERT_TRUE(update.phone->activateStylesheet(dark_stylesheet));
+    TEST_ASSERT_TRUE(update.phone->begin());
+    TEST_ASSERT_TRUE(update.phone->registerDateUpdateEventCallback(check_update, &update));
+
+    // Only the display and the bars are re-applied, both ways
+    test_switch_theme(update, light_stylesheet);
+    test_switch_theme(update, dark_stylesheet);
+
+    TEST_ASSERT_TRUE(update.phone->unregisterDateUpdateEventCallback(check_update, &update));
+    test_esp_brookesia_phone_deinit(update.phone);
+    test_lvgl_deinit(disp, tp);
+}
 #endif
 
 // TEST_CASE("test esp-brookesia to install and uninstall APPs", "[esp-brookesia][phone][install_uninstall_app]")
@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#if CONFIG_ESP_BROOKESIA_ENABLE_GUI
+#include <cstring>
+#include <vector>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "pixel/esp_brookesia_pixel_kernels.hpp"
+
+using namespace esp_brookesia::gui;
+
+#define TEST_PIXEL_NUM                  (67)
+#define TEST_PIXEL_MAX_OFFSET           (3)
+#define TEST_BENCHMARK_PIXEL_NUM        (240 * 240)
+#define TEST_BENCHMARK_ROUNDS           (20)
+
+static const char *TAG = "test_gui_pixel";
+
+static void test_fill_pattern(uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+}
+
+static void test_swap16_scalar(uint8_t *dst, const uint8_t *src, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        uint8_t low = src[i * 2];
+        dst[i * 2] = src[i * 2 + 1];
+        dst[i * 2 + 1] = low;
+    }
+}
+
+static uint32_t test_rgb565_to_argb_scalar(uint16_t pixel)
+{
+    uint32_t r = (pixel >> 11) & 0x1F;
+    uint32_t g = (pixel >> 5) & 0x3F;
+    uint32_t b = pixel & 0x1F;
+
+    return 0xFF000000U | (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+}
+
+static uint16_t test_rgb_to_rgb565_scalar(uint32_t r, uint32_t g, uint32_t b)
+{
+    return static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+TEST_CASE("test gui pixel to swap bytes", "[esp-brookesia][gui][pixel]")
+{
+    std::vector<uint8_t> src(TEST_PIXEL_NUM * 2 + TEST_PIXEL_MAX_OFFSET);
+    std::vector<uint8_t> dst(src.size());
+    std::vector<uint8_t> expected(src.size());
+    test_fill_pattern(src.data(), src.size());
+
+    // Every combination of the alignments and lengths which are not a multiple of the word or vector size
+    for (size_t src_offset = 0; src_offset <= TEST_PIXEL_MAX_OFFSET; src_offset++) {
+        for (size_t dst_offset = 0; dst_offset <= TEST_PIXEL_MAX_OFFSET; dst_offset++) {
+            for (size_t pixels = 0; pixels <= TEST_PIXEL_NUM; pixels++) {
+                std::memset(dst.data(), 0, dst.size());
+                std::memset(expected.data(), 0, expected.size());
+                pixel::swap16(dst.data() + dst_offset, src.data() + src_offset, pixels);
+                test_swap16_scalar(expected.data() + dst_offset, src.data() + src_offset, pixels);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), dst.data(), dst.size());
+            }
+        }
+    }
+
+    // In place
+    for (size_t offset = 0; offset <= TEST_PIXEL_MAX_OFFSET; offset++) {
+        test_fill_pattern(dst.data(), dst.size());
+        test_fill_pattern(expected.data(), expected.size());
+        pixel::swap16(dst.data() + offset, dst.data() + offset, TEST_PIXEL_NUM);
+        test_swap16_scalar(expected.data() + offset, src.data() + offset, TEST_PIXEL_NUM);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), dst.data(), dst.size());
+    }
+}
+
+TEST_CASE("test gui pixel to convert formats", "[esp-brookesia][gui][pixel]")
+{
+    std::vector<uint16_t> rgb565(TEST_PIXEL_NUM);
+    std::vector<uint8_t> rgb888(TEST_PIXEL_NUM * 3);
+    std::vector<uint32_t> argb8888(TEST_PIXEL_NUM);
+    std::vector<uint16_t> rgb565_out(TEST_PIXEL_NUM);
+    test_fill_pattern(reinterpret_cast<uint8_t *>(rgb565.data()), rgb565.size() * sizeof(uint16_t));
+
+    for (size_t pixels = 0; pixels <= TEST_PIXEL_NUM; pixels++) {
+        std::memset(rgb888.data(), 0, rgb888.size());
+        pixel::rgb565_to_rgb888(rgb888.data(), rgb565.data(), pixels);
+        for (size_t i = 0; i < TEST_PIXEL_NUM; i++) {
+            uint32_t argb = (i < pixels) ? test_rgb565_to_argb_scalar(rgb565[i]) : 0;
+            TEST_ASSERT_EQUAL_UINT8(argb & 0xFF, rgb888[i * 3]);
+            TEST_ASSERT_EQUAL_UINT8((argb >> 8) & 0xFF, rgb888[i * 3 + 1]);
+            TEST_ASSERT_EQUAL_UINT8((argb >> 16) & 0xFF, rgb888[i * 3 + 2]);
+        }
+
+        std::memset(argb8888.data(), 0, argb8888.size() * sizeof(uint32_t));
+        pixel::rgb565_to_argb8888(argb8888.data(), rgb565.data(), pixels);
+        for (size_t i = 0; i < TEST_PIXEL_NUM; i++) {
+            TEST_ASSERT_EQUAL_HEX32((i < pixels) ? test_rgb565_to_argb_scalar(rgb565[i]) : 0, argb8888[i]);
+        }
+    }
+
+    test_fill_pattern(rgb888.data(), rgb888.size());
+    pixel::rgb888_to_rgb565(rgb565_out.data(), rgb888.data(), TEST_PIXEL_NUM);
+    for (size_t i = 0; i < TEST_PIXEL_NUM; i++) {
+        uint16_t expected = test_rgb_to_rgb565_scalar(rgb888[i * 3 + 2], rgb888[i * 3 + 1], rgb888[i * 3]);
+        TEST_ASSERT_EQUAL_HEX16(expected, rgb565_out[i]);
+    }
+
+    test_fill_pattern(reinterpret_cast<uint8_t *>(argb8888.data()), argb8888.size() * sizeof(uint32_t));
+    pixel::argb8888_to_rgb565(rgb565_out.data(), argb8888.data(), TEST_PIXEL_NUM);
+    for (size_t i = 0; i < TEST_PIXEL_NUM; i++) {
+        uint32_t argb = argb8888[i];
+        uint16_t expected = test_rgb_to_rgb565_scalar((argb >> 16) & 0xFF, (argb >> 8) & 0xFF, argb & 0xFF);
+        TEST_ASSERT_EQUAL_HEX16(expected, rgb565_out[i]);
+    }
+
+    // Converting the expanded colors back gives the original pixels
+    pixel::rgb565_to_argb8888(argb8888.data(), rgb565.data(), TEST_PIXEL_NUM);
+    pixel::argb8888_to_rgb565(rgb565_out.data(), argb8888.data(), TEST_PIXEL_NUM);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(rgb565.data(), rgb565_out.data(), TEST_PIXEL_NUM);
+}
+
+TEST_CASE("test gui pixel to fill buffers", "[esp-brookesia][gui][pixel]")
+{
+    std::vector<uint16_t> buffer16(TEST_PIXEL_NUM + 1);
+    std::vector<uint32_t> buffer32(TEST_PIXEL_NUM + 1);
+
+    // Start from an odd pixel too, so the head is not word-aligned
+    for (size_t offset = 0; offset <= 1; offset++) {
+        for (size_t pixels = 0; pixels <= TEST_PIXEL_NUM; pixels++) {
+            std::fill(buffer16.begin(), buffer16.end(), 0);
+            pixel::fill16(buffer16.data() + offset, 0xA55A, pixels);
+            for (size_t i = 0; i < buffer16.size(); i++) {
+                bool is_filled = (i >= offset) && (i < offset + pixels);
+                TEST_ASSERT_EQUAL_HEX16(is_filled ? 0xA55A : 0, buffer16[i]);
+            }
+
+            std::fill(buffer32.begin(), buffer32.end(), 0);
+            pixel::fill32(buffer32.data() + offset, 0x12345678, pixels);
+            for (size_t i = 0; i < buffer32.size(); i++) {
+                bool is_filled = (i >= offset) && (i < offset + pixels);
+                TEST_ASSERT_EQUAL_HEX32(is_filled ? 0x12345678 : 0, buffer32[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("test gui pixel swap benchmark", "[esp-brookesia][gui][pixel]")
+{
+    std::vector<uint8_t> src(TEST_BENCHMARK_PIXEL_NUM * 2);
+    std::vector<uint8_t> dst(src.size());
+    std::vector<uint8_t> expected(src.size());
+    test_fill_pattern(src.data(), src.size());
+
+    int64_t start_us = esp_timer_get_time();
+    for (int i = 0; i < TEST_BENCHMARK_ROUNDS; i++) {
+        test_swap16_scalar(expected.data(), src.data(), TEST_BENCHMARK_PIXEL_NUM);
+    }
+    int64_t scalar_us = esp_timer_get_time() - start_us;
+
+    start_us = esp_timer_get_time();
+    for (int i = 0; i < TEST_BENCHMARK_ROUNDS; i++) {
+        pixel::swap16(dst.data(), src.data(), TEST_BENCHMARK_PIXEL_NUM);
+    }
+    int64_t kernel_us = esp_timer_get_time() - start_us;
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), dst.data(), dst.size());
+    ESP_LOGI(
+        TAG, "Swap %d pixels: scalar %d us, kernel %d us per frame", TEST_BENCHMARK_PIXEL_NUM,
+        static_cast<int>(scalar_us / TEST_BENCHMARK_ROUNDS), static_cast<int>(kernel_us / TEST_BENCHMARK_ROUNDS)
+    );
+}
+#endif // CONFIG_ESP_BROOKESIA_ENABLE_GUI
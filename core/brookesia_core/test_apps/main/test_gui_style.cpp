@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "unity.h"
+#include "esp_brookesia.hpp"
+
+using namespace esp_brookesia::gui;
+
+static constexpr StyleSize TEST_SCREEN_SIZE = StyleSize::RECT(800, 480);
+static constexpr StyleSize::CalibrateOptions TEST_CALIBRATE_OPTIONS = {
+    .min_size = 1,
+    .check_width = true,
+    .check_height = true,
+    .keep_parent_auto = false,
+};
+
+static constexpr StyleSize get_calibrated_size(StyleSize size)
+{
+    size.tryCalibrate(TEST_SCREEN_SIZE, TEST_CALIBRATE_OPTIONS);
+    return size;
+}
+
+static constexpr StyleSize::CalibrateResult get_calibrate_result(StyleSize size)
+{
+    return size.tryCalibrate(TEST_SCREEN_SIZE, TEST_CALIBRATE_OPTIONS);
+}
+
+// The sizes of a stylesheet for a known resolution can be resolved at build time
+static_assert(get_calibrated_size(StyleSize::RECT_PERCENT(50, 25)).width == 400);
+static_assert(get_calibrated_size(StyleSize::RECT_PERCENT(50, 25)).height == 120);
+static_assert(get_calibrated_size(StyleSize::CIRCLE_PERCENT(50)).width == 240);
+static_assert(get_calibrated_size(StyleSize::CIRCLE_PERCENT(50)).radius == StyleSize::RADIUS_CIRCLE);
+static_assert(get_calibrate_result(StyleSize::RECT(801, 10)) == StyleSize::CalibrateResult::INVALID_WIDTH);
+static_assert(get_calibrate_result(StyleSize::RECT_H_PERCENT(10, 101)) ==
+              StyleSize::CalibrateResult::INVALID_HEIGHT_PERCENT);
+
+struct TestStylesheet {
+    StyleSize main;
+    StyleSize icon;
+};
+
+class TestStylesheetManager: public StylesheetManager<TestStylesheet> {
+public:
+    bool calibrateScreenSize(StyleSize &size) override
+    {
+        return size.calibrate(TEST_SCREEN_SIZE);
+    }
+
+    bool calibrateStylesheet(const StyleSize &screen_size, TestStylesheet &stylesheet) override
+    {
+        calibrate_count++;
+        return stylesheet.main.calibrate(screen_size) && stylesheet.icon.calibrate(stylesheet.main);
+    }
+
+    bool calibrateStylesheetResource(const StyleSize &screen_size, TestStylesheet &stylesheet) override
+    {
+        resource_count++;
+        return true;
+    }
+
+    int calibrate_count = 0;
+    int resource_count = 0;
+};
+
+TEST_CASE("test gui style to calibrate sizes", "[esp-brookesia][gui][style]")
+{
+    StyleSize parent = TEST_SCREEN_SIZE;
+
+    // The runtime calibration gives the same result as the constant one
+    for (auto size : {
+                StyleSize::RECT_PERCENT(50, 25), StyleSize::RECT_W_PERCENT(30, 100), StyleSize::SQUARE_PERCENT(40),
+                StyleSize::CIRCLE(64)
+            }) {
+        StyleSize expected = get_calibrated_size(size);
+        TEST_ASSERT_TRUE(size.calibrate(parent, true, true));
+        TEST_ASSERT_EQUAL(expected.width, size.width);
+        TEST_ASSERT_EQUAL(expected.height, size.height);
+        TEST_ASSERT_EQUAL(expected.radius, size.radius);
+    }
+
+    StyleSize invalid_size = StyleSize::RECT(10, 481);
+    TEST_ASSERT_FALSE(invalid_size.calibrate(parent, true, true));
+    TEST_ASSERT_TRUE(invalid_size.calibrate(parent, true, false));
+}
+
+TEST_CASE("test gui style to activate stylesheets", "[esp-brookesia][gui][style]")
+{
+    TestStylesheetManager manager;
+    TestStylesheet stylesheet = {
+        .main = StyleSize::RECT_PERCENT(100, 50),
+        .icon = StyleSize::SQUARE_PERCENT(50),
+    };
+
+    TEST_ASSERT_TRUE(manager.activateStylesheet(TEST_SCREEN_SIZE, stylesheet));
+    TEST_ASSERT_EQUAL(1, manager.calibrate_count);
+    TEST_ASSERT_EQUAL(240, manager.getStylesheet()->main.height);
+    TEST_ASSERT_EQUAL(120, manager.getStylesheet()->icon.width);
+
+    stylesheet.icon = StyleSize::SQUARE_PERCENT(25);
+    TEST_ASSERT_TRUE(manager.activateStylesheet(TEST_SCREEN_SIZE, stylesheet));
+    TEST_ASSERT_EQUAL(2, manager.calibrate_count);
+    TEST_ASSERT_EQUAL(60, manager.getStylesheet()->icon.width);
+
+    // A stylesheet is calibrated once when it is added, activating it by name is only a copy
+    TEST_ASSERT_TRUE(manager.addStylesheet("test", TEST_SCREEN_SIZE, stylesheet));
+    TEST_ASSERT_EQUAL(3, manager.calibrate_count);
+    TEST_ASSERT_TRUE(manager.activateStylesheet("test", TEST_SCREEN_SIZE));
+    TEST_ASSERT_TRUE(manager.activateStylesheet("test", TEST_SCREEN_SIZE));
+    TEST_ASSERT_EQUAL(3, manager.calibrate_count);
+    TEST_ASSERT_EQUAL(60, manager.getStylesheet()->icon.width);
+}
+
+TEST_CASE("test gui style to share stylesheet handles", "[esp-brookesia][gui][style]")
+{
+    TestStylesheetManager manager;
+    TestStylesheet dark = {
+        .main = StyleSize::RECT_PERCENT(100, 100),
+        .icon = StyleSize::SQUARE(64),
+    };
+    TestStylesheet light = dark;
+    light.icon = StyleSize::SQUARE(48);
+
+    TEST_ASSERT_TRUE(manager.getStylesheetHandle() == nullptr);
+    TEST_ASSERT_TRUE(manager.addStylesheet("dark", TEST_SCREEN_SIZE, dark));
+    TEST_ASSERT_TRUE(manager.addStylesheet("light", TEST_SCREEN_SIZE, light));
+    TEST_ASSERT_TRUE(manager.activateStylesheet("dark", TEST_SCREEN_SIZE));
+    auto dark_handle = manager.getStylesheetHandle();
+    TEST_ASSERT_TRUE(dark_handle.get() == manager.getStylesheet("dark", TEST_SCREEN_SIZE));
+
+    // The handle of the last stylesheet stays valid, so it can be diffed with the new one
+    TEST_ASSERT_TRUE(manager.activateStylesheet("light", TEST_SCREEN_SIZE));
+    TEST_ASSERT_TRUE(manager.getStylesheetHandle() != dark_handle);
+    TEST_ASSERT_EQUAL(64, dark_handle->icon.width);
+    TEST_ASSERT_EQUAL(48, manager.getStylesheet()->icon.width);
+
+    TEST_ASSERT_TRUE(manager.activateStylesheet("dark", TEST_SCREEN_SIZE));
+    TEST_ASSERT_TRUE(manager.getStylesheetHandle() == dark_handle);
+    TEST_ASSERT_EQUAL(2, manager.calibrate_count);
+}
+
+TEST_CASE("test gui style to add calibrated stylesheets", "[esp-brookesia][gui][style]")
+{
+    TestStylesheetManager manager;
+    constexpr TestStylesheet calibrated = {
+        .main = get_calibrated_size(StyleSize::RECT_PERCENT(100, 50)),
+        .icon = get_calibrated_size(StyleSize::SQUARE(60)),
+    };
+
+    // Only the resources of a stylesheet calibrated at build time are resolved, its sizes are not calibrated again
+    TEST_ASSERT_TRUE(manager.addCalibratedStylesheet("calibrated", TEST_SCREEN_SIZE, calibrated));
+    TEST_ASSERT_EQUAL(0, manager.calibrate_count);
+    TEST_ASSERT_EQUAL(1, manager.resource_count);
+    TEST_ASSERT_TRUE(manager.activateStylesheet("calibrated", TEST_SCREEN_SIZE));
+    TEST_ASSERT_EQUAL(0, manager.calibrate_count);
+    TEST_ASSERT_EQUAL(1, manager.resource_count);
+    TEST_ASSERT_EQUAL(240, manager.getStylesheet()->main.height);
+    TEST_ASSERT_EQUAL(60, manager.getStylesheet()->icon.width);
+}
@@ -0,0 +1,415 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "sdkconfig.h"
+#if CONFIG_ESP_BROOKESIA_ENABLE_SERVICES && CONFIG_ESP_BROOKESIA_SERVICES_ENABLE_STORAGE_NVS
+#include <atomic>
+#include <string>
+#include <thread>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "nvs_flash.h"
+#include "unity.h"
+#include "esp_brookesia.hpp"
+
+using namespace esp_brookesia::services;
+
+#define TEST_KEY_INT                    "test_int"
+#define TEST_KEY_STR                    "test_str"
+#define TEST_NAMESPACE                  "test_ns"
+#define TEST_NAMESPACE_QUOTA_BYTES      (256)
+#define TEST_UPDATE_TIMES               (50)
+#define TEST_UPDATE_INTERVAL_MS         (5)
+#define TEST_EVENT_WAIT_TIMEOUT_MS      (1000)
+#define TEST_BENCHMARK_DURATION_MS      (1000)
+#define TEST_FILE_BACKEND_ENTRY_WRITE_US    (40)
+
+static const char *TAG = "test_storage_nvs";
+
+/**
+ * File backend whose writes fail after `set_num_before_reset` items, as if the device was reset in the middle of a
+ * commit. Without a path, the items which were written before survive `del()`.
+ */
+class TestResetFileBackend: public StorageNVSFileBackend {
+public:
+    using StorageNVSFileBackend::StorageNVSFileBackend;
+
+    esp_err_t set(Handle handle, const char *key, Type type, const void *data, size_t len) override
+    {
+        int set_num = set_num_before_reset;
+        if (set_num == 0) {
+            return ESP_FAIL;
+        }
+        if (set_num > 0) {
+            set_num_before_reset = set_num - 1;
+        }
+        return StorageNVSFileBackend::set(handle, key, type, data, len);
+    }
+
+    std::atomic<int> set_num_before_reset = -1;     // -1 means never reset
+};
+
+static void test_wait_future(StorageNVS::EventFuture &future)
+{
+    auto status = future.wait_for(std::chrono::milliseconds(TEST_EVENT_WAIT_TIMEOUT_MS));
+    TEST_ASSERT_TRUE(status == std::future_status::ready);
+    TEST_ASSERT_TRUE(future.get());
+}
+
+static uint32_t test_read_for_duration(StorageNVS &storage, int duration_ms)
+{
+    StorageNVS::Value value;
+    uint32_t reads = 0;
+    auto end_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_ms);
+    while (std::chrono::steady_clock::now() < end_time) {
+        for (int i = 0; i < 100; i++) {
+            TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_INT, value));
+        }
+        reads += 100;
+    }
+
+    return reads;
+}
+
+TEST_CASE("test storage nvs to coalesce writes", "[esp-brookesia][services][storage_nvs]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture future;
+
+    TEST_ASSERT_TRUE(storage.begin());
+    TEST_ASSERT_TRUE(storage.eraseNVS(nullptr, &future));
+    test_wait_future(future);
+
+    int update_signals = 0;
+    auto connection = storage.connectEventSignal([&](const StorageNVS::Event & event) {
+        if (event.operation == StorageNVS::Operation::UpdateNVS) {
+            update_signals++;
+        }
+    });
+
+    ESP_LOGI(TAG, "Update %d times in a burst", TEST_UPDATE_TIMES);
+    storage.resetStats();
+    for (int i = 0; i < TEST_UPDATE_TIMES; i++) {
+        TEST_ASSERT_TRUE(storage.setLocalParam(TEST_KEY_INT, i));
+        vTaskDelay(pdMS_TO_TICKS(TEST_UPDATE_INTERVAL_MS));
+    }
+    TEST_ASSERT_TRUE(storage.setLocalParam(TEST_KEY_STR, std::string("brookesia"), nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(storage.flush(nullptr, &future));
+    test_wait_future(future);
+
+    auto stats = storage.getStats();
+    ESP_LOGI(
+        TAG, "Stats: update_requests(%d), flash_writes(%d), commits(%d)", static_cast<int>(stats.update_requests),
+        static_cast<int>(stats.flash_writes), static_cast<int>(stats.commits)
+    );
+    TEST_ASSERT_EQUAL(TEST_UPDATE_TIMES + 1, update_signals);
+    TEST_ASSERT_EQUAL(TEST_UPDATE_TIMES + 1, stats.update_requests);
+#if CONFIG_ESP_BROOKESIA_STORAGE_NVS_WRITE_BACK_DEBOUNCE_MS > 0
+    TEST_ASSERT_LESS_THAN(stats.update_requests, stats.flash_writes);
+#else
+    TEST_ASSERT_EQUAL(stats.update_requests, stats.flash_writes);
+#endif
+
+    ESP_LOGI(TAG, "Reload parameters from NVS");
+    TEST_ASSERT_TRUE(storage.setLocalParam(TEST_KEY_INT, -1));
+    connection.disconnect();
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.begin());
+
+    StorageNVS::Value value;
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_INT, value));
+    TEST_ASSERT_EQUAL(-1, std::get<int>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_STR, value));
+    TEST_ASSERT_EQUAL_STRING("brookesia", std::get<std::string>(value).c_str());
+
+    TEST_ASSERT_TRUE(storage.eraseNVS(nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_deinit());
+}
+
+TEST_CASE("test storage nvs to store typed values", "[esp-brookesia][services][storage_nvs]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture future;
+
+    TEST_ASSERT_TRUE(storage.begin());
+
+    const uint8_t blob_data[] = {0x00, 0x01, 0xfe, 0xff};
+    std::string long_str(3000, 'b');
+    TEST_ASSERT_TRUE(storage.setLocalParam("test_i64", static_cast<int64_t>(1) << 40));
+    TEST_ASSERT_TRUE(storage.setLocalParam("test_float", 0.5f));
+    TEST_ASSERT_TRUE(storage.setLocalParam("test_bool", true));
+    TEST_ASSERT_TRUE(storage.setLocalParam("test_blob", StorageNVS::makeBlob(blob_data, sizeof(blob_data))));
+    TEST_ASSERT_TRUE(storage.setLocalParam("test_long_str", long_str));
+    TEST_ASSERT_TRUE(storage.flush(nullptr, &future));
+    test_wait_future(future);
+
+    ESP_LOGI(TAG, "Reload parameters from NVS");
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.begin());
+
+    StorageNVS::Value value;
+    TEST_ASSERT_TRUE(storage.getLocalParam("test_i64", value));
+    TEST_ASSERT_TRUE(std::get<int64_t>(value) == (static_cast<int64_t>(1) << 40));
+    TEST_ASSERT_TRUE(storage.getLocalParam("test_float", value));
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, std::get<float>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam("test_bool", value));
+    TEST_ASSERT_TRUE(std::get<bool>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam("test_blob", value));
+    auto &blob = std::get<StorageNVS::Blob>(value);
+    TEST_ASSERT_EQUAL(sizeof(blob_data), blob->size());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(blob_data, blob->data(), sizeof(blob_data));
+    TEST_ASSERT_TRUE(storage.getLocalParam("test_long_str", value));
+    TEST_ASSERT_TRUE(std::get<std::string>(value) == long_str);
+
+    TEST_ASSERT_TRUE(storage.eraseNVS(nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_deinit());
+}
+
+TEST_CASE("test storage nvs to subscribe a key", "[esp-brookesia][services][storage_nvs]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture future;
+
+    TEST_ASSERT_TRUE(storage.begin());
+
+    int int_updates = 0;
+    int str_updates = 0;
+    auto int_connection = storage.subscribe(TEST_KEY_INT, [&](const StorageNVS::Event & event) {
+        TEST_ASSERT_EQUAL_STRING(TEST_KEY_INT, event.key.c_str());
+        int_updates++;
+    });
+    auto str_connection = storage.subscribe(TEST_KEY_STR, [&](const StorageNVS::Event & event) {
+        str_updates++;
+    });
+
+    TEST_ASSERT_TRUE(storage.setLocalParam(TEST_KEY_INT, 1));
+    TEST_ASSERT_TRUE(storage.setLocalParam(TEST_KEY_INT, 2, nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_EQUAL(2, int_updates);
+    TEST_ASSERT_EQUAL(0, str_updates);
+    TEST_ASSERT_EQUAL(storage.internKey(TEST_KEY_INT), storage.internKey(TEST_KEY_INT));
+    TEST_ASSERT_NOT_EQUAL(storage.internKey(TEST_KEY_INT), storage.internKey(TEST_KEY_STR));
+
+    int_connection.disconnect();
+    str_connection.disconnect();
+    TEST_ASSERT_TRUE(storage.eraseNVS(nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_deinit());
+}
+
+TEST_CASE("test storage nvs to commit a transaction", "[esp-brookesia][services][storage_nvs]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture future;
+
+    TEST_ASSERT_TRUE(storage.begin());
+
+    int updates = 0;
+    auto connection = storage.connectEventSignal([&](const StorageNVS::Event & event) {
+        if (event.operation == StorageNVS::Operation::UpdateNVS) {
+            updates++;
+        }
+    });
+
+    storage.resetStats();
+    auto transaction = storage.beginTransaction();
+    transaction.set(TEST_KEY_INT, 100).set(TEST_KEY_STR, std::string("transaction"));
+    TEST_ASSERT_TRUE(transaction.commit(nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_EQUAL(2, updates);
+    TEST_ASSERT_EQUAL(1, storage.getStats().commits);
+
+    connection.disconnect();
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.begin());
+
+    StorageNVS::Value value;
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_INT, value));
+    TEST_ASSERT_EQUAL(100, std::get<int>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_STR, value));
+    TEST_ASSERT_EQUAL_STRING("transaction", std::get<std::string>(value).c_str());
+
+    TEST_ASSERT_TRUE(storage.eraseNVS(nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_deinit());
+}
+
+TEST_CASE("test storage nvs to recover an interrupted transaction", "[esp-brookesia][services][storage_nvs]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture future;
+    StorageNVS::Value value;
+    auto backend = std::make_shared<TestResetFileBackend>(StorageNVSFileBackend::Config{});
+
+    TEST_ASSERT_TRUE(storage.setBackend(backend));
+    TEST_ASSERT_TRUE(storage.begin());
+    auto transaction = storage.beginTransaction();
+    transaction.set(TEST_KEY_INT, 1).set(TEST_KEY_STR, std::string("before"));
+    TEST_ASSERT_TRUE(transaction.commit(nullptr, &future));
+    test_wait_future(future);
+
+    ESP_LOGI(TAG, "Reset before the journal is written, none of the keys is applied");
+    backend->set_num_before_reset = 0;
+    transaction.set(TEST_KEY_INT, 2).set(TEST_KEY_STR, std::string("after"));
+    TEST_ASSERT_TRUE(transaction.commit(nullptr, &future));
+    TEST_ASSERT_FALSE(future.get());
+    backend->set_num_before_reset = -1;
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.begin());
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_INT, value));
+    TEST_ASSERT_EQUAL(1, std::get<int>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_STR, value));
+    TEST_ASSERT_EQUAL_STRING("before", std::get<std::string>(value).c_str());
+
+    ESP_LOGI(TAG, "Reset after the journal and one key are written, all the keys are applied by the replay");
+    backend->set_num_before_reset = 2;
+    transaction.set(TEST_KEY_INT, 2).set(TEST_KEY_STR, std::string("after"));
+    TEST_ASSERT_TRUE(transaction.commit(nullptr, &future));
+    TEST_ASSERT_FALSE(future.get());
+    backend->set_num_before_reset = -1;
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.begin());
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_INT, value));
+    TEST_ASSERT_EQUAL(2, std::get<int>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_STR, value));
+    TEST_ASSERT_EQUAL_STRING("after", std::get<std::string>(value).c_str());
+
+    // Restore the default backend for the other cases
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.setBackend(std::make_shared<StorageNVSFlashBackend>()));
+}
+
+TEST_CASE("test storage nvs to load namespaces lazily", "[esp-brookesia][services][storage_nvs]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture future;
+    auto key_int = StorageNVS::makeKey(TEST_NAMESPACE, TEST_KEY_INT);
+    auto key_str = StorageNVS::makeKey(TEST_NAMESPACE, TEST_KEY_STR);
+
+    TEST_ASSERT_TRUE(storage.begin());
+    TEST_ASSERT_TRUE(storage.registerNamespace(TEST_NAMESPACE, TEST_NAMESPACE_QUOTA_BYTES));
+    TEST_ASSERT_TRUE(storage.setLocalParam(key_int, 1));
+    TEST_ASSERT_TRUE(storage.setLocalParam(key_str, std::string("namespace"), nullptr, &future));
+    test_wait_future(future);
+    // Exceeds the quota, the local parameter is not changed
+    TEST_ASSERT_FALSE(storage.setLocalParam(key_str, std::string(TEST_NAMESPACE_QUOTA_BYTES, 'x')));
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_NAMESPACE_QUOTA_BYTES, storage.getNamespaceUsage(TEST_NAMESPACE));
+    TEST_ASSERT_TRUE(storage.flush(nullptr, &future));
+    test_wait_future(future);
+
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.begin());
+    storage.resetStats();
+
+    // The namespace is only loaded when one of its keys is accessed
+    TEST_ASSERT_EQUAL(0, storage.getLocalParamSnapshot()->count(key_int));
+    StorageNVS::Value value;
+    TEST_ASSERT_TRUE(storage.getLocalParam(key_int, value));
+    TEST_ASSERT_EQUAL(1, std::get<int>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(key_str, value));
+    TEST_ASSERT_EQUAL_STRING("namespace", std::get<std::string>(value).c_str());
+    TEST_ASSERT_EQUAL(1, storage.getStats().namespace_loads);
+
+    TEST_ASSERT_TRUE(storage.eraseNVS(nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_deinit());
+}
+
+TEST_CASE("test storage nvs with a file backend", "[esp-brookesia][services][storage_nvs]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture future;
+
+    // Without a path, the items are kept in memory and survive `del()`
+    auto backend = std::make_shared<StorageNVSFileBackend>(StorageNVSFileBackend::Config{
+        .entry_write_us = TEST_FILE_BACKEND_ENTRY_WRITE_US,
+    });
+    TEST_ASSERT_TRUE(storage.setBackend(backend));
+    TEST_ASSERT_TRUE(storage.begin());
+    TEST_ASSERT_FALSE(storage.setBackend(backend));
+
+    storage.resetStats();
+    for (int i = 0; i < TEST_UPDATE_TIMES; i++) {
+        TEST_ASSERT_TRUE(storage.setLocalParam(TEST_KEY_INT, i));
+    }
+    TEST_ASSERT_TRUE(storage.setLocalParam(TEST_KEY_STR, std::string("file"), nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(storage.flush(nullptr, &future));
+    test_wait_future(future);
+
+    auto stats = storage.getStats();
+    auto backend_stats = backend->getStats();
+    ESP_LOGI(
+        TAG, "Queue latency: avg(%d us), max(%d us), backend entry writes(%d)",
+        static_cast<int>(stats.queue_latency_us_total / stats.events), static_cast<int>(stats.queue_latency_us_max),
+        static_cast<int>(backend_stats.entry_writes)
+    );
+    TEST_ASSERT_EQUAL(TEST_UPDATE_TIMES + 2, stats.events);
+    TEST_ASSERT_EQUAL(2, backend_stats.sets);
+
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.begin());
+
+    StorageNVS::Value value;
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_INT, value));
+    TEST_ASSERT_EQUAL(TEST_UPDATE_TIMES - 1, std::get<int>(value));
+    TEST_ASSERT_TRUE(storage.getLocalParam(TEST_KEY_STR, value));
+    TEST_ASSERT_EQUAL_STRING("file", std::get<std::string>(value).c_str());
+
+    // Restore the default backend for the other cases
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_TRUE(storage.setBackend(std::make_shared<StorageNVSFlashBackend>()));
+}
+
+TEST_CASE("test storage nvs read throughput with a concurrent writer", "[esp-brookesia][services][storage_nvs]")
+{
+    auto &storage = StorageNVS::requestInstance();
+    StorageNVS::EventFuture future;
+
+    TEST_ASSERT_TRUE(storage.begin());
+    TEST_ASSERT_TRUE(storage.setLocalParam(TEST_KEY_INT, 0, nullptr, &future));
+    test_wait_future(future);
+
+    auto idle_reads = test_read_for_duration(storage, TEST_BENCHMARK_DURATION_MS);
+
+    // The writer updates the parameter and reloads all parameters from flash as fast as possible
+    std::atomic<bool> writer_running = true;
+    uint32_t writes = 0;
+    std::thread writer([&]() {
+        StorageNVS::EventFuture writer_future;
+        while (writer_running) {
+            storage.setLocalParam(TEST_KEY_INT, static_cast<int>(writes++));
+            storage.sendEvent({
+                .operation = StorageNVS::Operation::UpdateParam,
+            }, &writer_future);
+            writer_future.wait();
+        }
+    });
+    auto busy_reads = test_read_for_duration(storage, TEST_BENCHMARK_DURATION_MS);
+    writer_running = false;
+    writer.join();
+
+    ESP_LOGI(
+        TAG, "Reads per second: idle(%d), with writer(%d), writer updates(%d)", static_cast<int>(idle_reads),
+        static_cast<int>(busy_reads), static_cast<int>(writes)
+    );
+    TEST_ASSERT_GREATER_THAN(0, busy_reads);
+    TEST_ASSERT_GREATER_THAN(0, writes);
+
+    TEST_ASSERT_TRUE(storage.eraseNVS(nullptr, &future));
+    test_wait_future(future);
+    TEST_ASSERT_TRUE(storage.del());
+    TEST_ASSERT_EQUAL(ESP_OK, nvs_flash_deinit());
+}
+#endif
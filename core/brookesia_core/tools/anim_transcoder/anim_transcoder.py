@@ -0,0 +1,313 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+#
+
+"""
+Transcode animation frames into the tile-compressed animation format (.atf) played by `esp_brookesia::gui::AnimPlayer`.
+
+Layout (little endian):
+    header:  magic "ATF1", checksum(u32), data_length(u32), width(u16), height(u16), tile_size(u16), reserved(u16),
+             frame_num(u32)
+    table:   `frame_num` entries of offset(u32) and size(u32), the offset is relative to the end of the table
+    frame:   flags(u8), dirty-tile bitmap (one bit per tile, row-major, LSB first), then for each dirty tile:
+             method(u8), payload_length(u16), payload
+
+`checksum` is the 32-bit sum of the `data_length` bytes after the first 12 bytes, the same rule as the .aaf format.
+A keyframe (flags bit 0) contains all tiles, other frames only contain the tiles which differ from the previous frame.
+Pixels are RGB565 in little endian. A tile payload is either raw pixels or RLE packets over pixels: a control byte
+`c`, followed by one pixel repeated `(c & 0x7f) + 1` times if bit 7 is set, otherwise `c + 1` literal pixels.
+
+Usage:
+    python3 anim_transcoder.py encode -i <frames_dir|file.gif> -o <file.atf> [--tile-size 16] [--keyframe-interval 30]
+    python3 anim_transcoder.py decode -i <file.atf> -o <frames_dir>
+    python3 anim_transcoder.py info -i <file.atf>
+"""
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b'ATF1'
+HEADER_FORMAT = '<4sIIHHHHI'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+CHECKSUM_START = 12
+TABLE_ENTRY_FORMAT = '<II'
+TABLE_ENTRY_SIZE = struct.calcsize(TABLE_ENTRY_FORMAT)
+
+FRAME_FLAG_KEYFRAME = 0x01
+
+TILE_METHOD_RAW = 0
+TILE_METHOD_RLE = 1
+
+RLE_MAX_PACKET = 128
+
+
+def rgb565_from_rgb(r, g, b):
+    return ((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3)
+
+
+def tile_grid(width, height, tile_size):
+    return (width + tile_size - 1) // tile_size, (height + tile_size - 1) // tile_size
+
+
+def tile_pixels(frame, width, height, tile_size, tx, ty):
+    x0 = tx * tile_size
+    y0 = ty * tile_size
+    x1 = min(x0 + tile_size, width)
+    y1 = min(y0 + tile_size, height)
+    pixels = []
+    for y in range(y0, y1):
+        pixels.extend(frame[y * width + x0:y * width + x1])
+    return pixels
+
+
+def rle_encode(pixels):
+    out = bytearray()
+    i = 0
+    n = len(pixels)
+    while i < n:
+        run = 1
+        while i + run < n and run < RLE_MAX_PACKET and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= 2:
+            out.append(0x80 | (run - 1))
+            out += struct.pack('<H', pixels[i])
+            i += run
+            continue
+        # Collect literals until a run of at least 2 pixels starts
+        start = i
+        while i < n and (i - start) < RLE_MAX_PACKET:
+            if i + 1 < n and pixels[i + 1] == pixels[i]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        out += struct.pack('<%dH' % (i - start), *pixels[start:i])
+    return bytes(out)
+
+
+def rle_decode(payload, pixel_num):
+    pixels = []
+    i = 0
+    while i < len(payload) and len(pixels) < pixel_num:
+        control = payload[i]
+        i += 1
+        if control & 0x80:
+            if i + 2 > len(payload):
+                raise ValueError('Truncated RLE run')
+            pixels.extend([struct.unpack_from('<H', payload, i)[0]] * ((control & 0x7f) + 1))
+            i += 2
+        else:
+            count = control + 1
+            if i + count * 2 > len(payload):
+                raise ValueError('Truncated RLE literals')
+            pixels.extend(struct.unpack_from('<%dH' % count, payload, i))
+            i += count * 2
+    if len(pixels) != pixel_num or i != len(payload):
+        raise ValueError('Invalid RLE payload')
+    return pixels
+
+
+def encode_tile(pixels):
+    raw = struct.pack('<%dH' % len(pixels), *pixels)
+    rle = rle_encode(pixels)
+    if len(rle) < len(raw):
+        return TILE_METHOD_RLE, rle
+    return TILE_METHOD_RAW, raw
+
+
+def encode_frame(frame, previous, width, height, tile_size, is_keyframe):
+    tiles_x, tiles_y = tile_grid(width, height, tile_size)
+    bitmap = bytearray((tiles_x * tiles_y + 7) // 8)
+    body = bytearray()
+    for ty in range(tiles_y):
+        for tx in range(tiles_x):
+            pixels = tile_pixels(frame, width, height, tile_size, tx, ty)
+            if not is_keyframe and pixels == tile_pixels(previous, width, height, tile_size, tx, ty):
+                continue
+            tile_index = ty * tiles_x + tx
+            bitmap[tile_index // 8] |= 1 << (tile_index % 8)
+            method, payload = encode_tile(pixels)
+            body += struct.pack('<BH', method, len(payload)) + payload
+    flags = FRAME_FLAG_KEYFRAME if is_keyframe else 0
+    return bytes([flags]) + bytes(bitmap) + bytes(body)
+
+
+def encode(frames, width, height, tile_size=16, keyframe_interval=30):
+    """Encode a list of frames, each a flat list of `width * height` RGB565 pixels"""
+    if not frames:
+        raise ValueError('No frames')
+    if not (0 < width < 0x10000 and 0 < height < 0x10000 and 0 < tile_size < 0x10000):
+        raise ValueError('Invalid size')
+    # A tile must fit in the 16-bit payload length of the raw method
+    if tile_size * tile_size * 2 > 0xffff:
+        raise ValueError('Tile size too large')
+
+    encoded = []
+    previous = None
+    for i, frame in enumerate(frames):
+        if len(frame) != width * height:
+            raise ValueError('Invalid frame(%d) size' % i)
+        is_keyframe = previous is None or (keyframe_interval > 0 and i % keyframe_interval == 0)
+        encoded.append(encode_frame(frame, previous, width, height, tile_size, is_keyframe))
+        previous = frame
+
+    table = bytearray()
+    offset = 0
+    for data in encoded:
+        table += struct.pack(TABLE_ENTRY_FORMAT, offset, len(data))
+        offset += len(data)
+    body = struct.pack('<HHHHI', width, height, tile_size, 0, len(frames)) + bytes(table) + b''.join(encoded)
+    checksum = sum(body) & 0xffffffff
+    return MAGIC + struct.pack('<II', checksum, len(body)) + body
+
+
+def parse(data):
+    if len(data) < HEADER_SIZE:
+        raise ValueError('Invalid length')
+    magic, checksum, data_length, width, height, tile_size, _, frame_num = struct.unpack_from(HEADER_FORMAT, data)
+    if magic != MAGIC:
+        raise ValueError('Invalid magic')
+    if CHECKSUM_START + data_length > len(data):
+        raise ValueError('Invalid data length')
+    if (sum(data[CHECKSUM_START:CHECKSUM_START + data_length]) & 0xffffffff) != checksum:
+        raise ValueError('Checksum mismatch')
+    table_end = HEADER_SIZE + frame_num * TABLE_ENTRY_SIZE
+    frames = []
+    for i in range(frame_num):
+        offset, size = struct.unpack_from(TABLE_ENTRY_FORMAT, data, HEADER_SIZE + i * TABLE_ENTRY_SIZE)
+        if table_end + offset + size > CHECKSUM_START + data_length:
+            raise ValueError('Invalid frame(%d)' % i)
+        frames.append(data[table_end + offset:table_end + offset + size])
+    return width, height, tile_size, frames
+
+
+def decode_frame(record, canvas, width, height, tile_size):
+    tiles_x, tiles_y = tile_grid(width, height, tile_size)
+    bitmap_size = (tiles_x * tiles_y + 7) // 8
+    if len(record) < 1 + bitmap_size:
+        raise ValueError('Truncated frame')
+    bitmap = record[1:1 + bitmap_size]
+    i = 1 + bitmap_size
+    for tile_index in range(tiles_x * tiles_y):
+        if not bitmap[tile_index // 8] & (1 << (tile_index % 8)):
+            continue
+        method, length = struct.unpack_from('<BH', record, i)
+        i += 3
+        payload = record[i:i + length]
+        i += length
+        tx = tile_index % tiles_x
+        ty = tile_index // tiles_x
+        x0 = tx * tile_size
+        y0 = ty * tile_size
+        tile_w = min(tile_size, width - x0)
+        tile_h = min(tile_size, height - y0)
+        if method == TILE_METHOD_RAW:
+            if length != tile_w * tile_h * 2:
+                raise ValueError('Invalid raw tile')
+            pixels = list(struct.unpack('<%dH' % (tile_w * tile_h), payload))
+        elif method == TILE_METHOD_RLE:
+            pixels = rle_decode(payload, tile_w * tile_h)
+        else:
+            raise ValueError('Invalid tile method(%d)' % method)
+        for y in range(tile_h):
+            canvas[(y0 + y) * width + x0:(y0 + y) * width + x0 + tile_w] = pixels[y * tile_w:(y + 1) * tile_w]
+    if i != len(record):
+        raise ValueError('Trailing frame data')
+
+
+def decode(data, frame_index=None):
+    """Decode all frames, or only one by seeking from its nearest keyframe"""
+    width, height, tile_size, records = parse(data)
+    canvas = [0] * (width * height)
+    if frame_index is not None:
+        start = frame_index
+        while start > 0 and not records[start][0] & FRAME_FLAG_KEYFRAME:
+            start -= 1
+        for record in records[start:frame_index + 1]:
+            decode_frame(record, canvas, width, height, tile_size)
+        return width, height, [list(canvas)]
+    frames = []
+    for record in records:
+        decode_frame(record, canvas, width, height, tile_size)
+        frames.append(list(canvas))
+    return width, height, frames
+
+
+def load_frames(path):
+    try:
+        from PIL import Image, ImageSequence
+    except ImportError:
+        print("Error: Python 'Pillow' package is not installed.")
+        print('Please install it using: pip install pillow')
+        sys.exit(1)
+
+    if os.path.isdir(path):
+        names = sorted(n for n in os.listdir(path) if n.lower().endswith(('.png', '.bmp', '.jpg', '.jpeg')))
+        images = [Image.open(os.path.join(path, n)) for n in names]
+    else:
+        images = [frame.copy() for frame in ImageSequence.Iterator(Image.open(path))]
+    if not images:
+        raise ValueError("No frames found in '%s'" % path)
+
+    width, height = images[0].size
+    frames = []
+    for image in images:
+        if image.size != (width, height):
+            raise ValueError('All frames must have the same size')
+        frames.append([rgb565_from_rgb(r, g, b) for r, g, b in image.convert('RGB').getdata()])
+    return width, height, frames
+
+
+def save_frames(path, width, height, frames):
+    from PIL import Image
+
+    os.makedirs(path, exist_ok=True)
+    for i, frame in enumerate(frames):
+        image = Image.new('RGB', (width, height))
+        image.putdata([(((p >> 11) & 0x1f) << 3, ((p >> 5) & 0x3f) << 2, (p & 0x1f) << 3) for p in frame])
+        image.save(os.path.join(path, 'frame_%04d.png' % i))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Transcode animation frames into the tile-compressed format (.atf)')
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    encode_parser = subparsers.add_parser('encode', help='Encode a directory of images or an animated image')
+    encode_parser.add_argument('--input', '-i', required=True, help='Directory of frames or an animated image')
+    encode_parser.add_argument('--output', '-o', required=True, help='Output .atf file')
+    encode_parser.add_argument('--tile-size', type=int, default=16, help='Tile size in pixels')
+    encode_parser.add_argument('--keyframe-interval', type=int, default=30,
+                               help='Frames between keyframes, `0` for only the first frame')
+
+    decode_parser = subparsers.add_parser('decode', help='Decode an .atf file into PNG frames')
+    decode_parser.add_argument('--input', '-i', required=True, help='Input .atf file')
+    decode_parser.add_argument('--output', '-o', required=True, help='Output directory')
+
+    info_parser = subparsers.add_parser('info', help='Print the information of an .atf file')
+    info_parser.add_argument('--input', '-i', required=True, help='Input .atf file')
+
+    args = parser.parse_args()
+    if args.command == 'encode':
+        width, height, frames = load_frames(args.input)
+        data = encode(frames, width, height, args.tile_size, args.keyframe_interval)
+        with open(args.output, 'wb') as f:
+            f.write(data)
+        print('Encoded %d frames (%dx%d) into %d bytes, raw size %d bytes' %
+              (len(frames), width, height, len(data), len(frames) * width * height * 2))
+    elif args.command == 'decode':
+        with open(args.input, 'rb') as f:
+            width, height, frames = decode(f.read())
+        save_frames(args.output, width, height, frames)
+        print('Decoded %d frames (%dx%d)' % (len(frames), width, height))
+    else:
+        with open(args.input, 'rb') as f:
+            width, height, tile_size, records = parse(f.read())
+        keyframes = [i for i, record in enumerate(records) if record[0] & FRAME_FLAG_KEYFRAME]
+        print('Size: %dx%d, tile size: %d, frames: %d, keyframes: %s' %
+              (width, height, tile_size, len(records), keyframes))
+
+
+if __name__ == '__main__':
+    main()
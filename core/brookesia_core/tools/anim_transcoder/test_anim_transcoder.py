@@ -0,0 +1,75 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Host tests of the animation transcoder, run with:
+    python3 -m unittest test_anim_transcoder.py
+"""
+import random
+import struct
+import unittest
+
+import anim_transcoder
+
+
+def make_frames(width, height, frame_num, seed):
+    rng = random.Random(seed)
+    frame = [rng.choice((0x0000, 0xffff, 0xf800)) for _ in range(width * height)]
+    frames = []
+    for _ in range(frame_num):
+        frame = list(frame)
+        # Change a random block, leaving most tiles untouched
+        x0 = rng.randrange(width)
+        y0 = rng.randrange(height)
+        for y in range(y0, min(y0 + rng.randint(1, 24), height)):
+            for x in range(x0, min(x0 + rng.randint(1, 24), width)):
+                frame[y * width + x] = rng.randrange(0x10000)
+        frames.append(frame)
+    return frames
+
+
+class TestAnimTranscoder(unittest.TestCase):
+    def check_round_trip(self, width, height, tile_size, keyframe_interval, frames):
+        data = anim_transcoder.encode(frames, width, height, tile_size, keyframe_interval)
+        _, _, decoded = anim_transcoder.decode(data)
+        self.assertEqual(decoded, frames)
+        return data
+
+    def test_round_trip(self):
+        for width, height, tile_size in ((64, 64, 16), (284, 126, 16), (50, 30, 8), (7, 5, 16)):
+            with self.subTest(width=width, height=height, tile_size=tile_size):
+                frames = make_frames(width, height, 12, width * height)
+                self.check_round_trip(width, height, tile_size, 5, frames)
+
+    def test_static_frames_are_empty(self):
+        frame = [0x1234] * (32 * 32)
+        data = self.check_round_trip(32, 32, 16, 0, [frame] * 4)
+        _, _, _, records = anim_transcoder.parse(data)
+        # Flags and a bitmap of 4 tiles without any tile data
+        self.assertEqual([len(record) for record in records[1:]], [2, 2, 2])
+
+    def test_rle(self):
+        cases = ([1], [1, 1], [1, 2], [5] * 300, list(range(300)), [1, 1, 2, 3, 3, 3, 4] * 40)
+        for pixels in cases:
+            payload = anim_transcoder.rle_encode(pixels)
+            self.assertEqual(anim_transcoder.rle_decode(payload, len(pixels)), pixels)
+
+    def test_seek(self):
+        frames = make_frames(40, 40, 20, 1)
+        data = anim_transcoder.encode(frames, 40, 40, 8, 6)
+        for i in (0, 5, 6, 7, 19):
+            _, _, decoded = anim_transcoder.decode(data, i)
+            self.assertEqual(decoded[0], frames[i])
+
+    def test_checksum(self):
+        data = bytearray(anim_transcoder.encode(make_frames(16, 16, 2, 2), 16, 16, 8))
+        checksum, data_length = struct.unpack_from('<II', data, 4)
+        self.assertEqual(len(data), 12 + data_length)
+        self.assertEqual(sum(data[12:]) & 0xffffffff, checksum)
+        data[-1] ^= 0x01
+        with self.assertRaises(ValueError):
+            anim_transcoder.parse(bytes(data))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -67,11 +67,7 @@ bool audio_init()
 
     /* Update media sound volume when NVS volume is updated */
     auto &storage_service = StorageNVS::requestInstance();
-    storage_service.connectEventSignal([&](const StorageNVS::Event & event) {
-        if ((event.operation != StorageNVS::Operation::UpdateNVS) || (event.key != Manager::SETTINGS_VOLUME)) {
-            return;
-        }
-
+    storage_service.subscribe(Manager::SETTINGS_VOLUME, [&](const StorageNVS::Event & event) {
         ESP_UTILS_LOG_TRACE_GUARD();
 
         StorageNVS::Value value;
@@ -10,11 +10,13 @@
 #include "esp_log.h"
 #include "esp_sleep.h"
 #include "esp_lib_utils.h"
+#include "esp_brookesia.hpp"
 #include "bsp/esp-bsp.h"
 #include "i2c_bus.h"
 #include "battery_monitor.h"
 
 #define BATTERY_SHUTDOWN_SOC (1)
+#define BATTERY_SHUTDOWN_FLUSH_TIMEOUT_MS (1000)
 
 static const ParamCEDV g_cedv = {
     .cedv_conf = {
@@ -72,6 +74,10 @@ void BatteryMonitor::check_shutdown()
         if (this->shutdown_cb) {
             this->shutdown_cb();
         }
+        // Parameters changed within the write-back window would be lost by the deep sleep
+        esp_brookesia::services::StorageNVS::requestInstance().flush(
+            std::chrono::milliseconds(BATTERY_SHUTDOWN_FLUSH_TIMEOUT_MS)
+        );
         esp_deep_sleep_start();
     }
 }
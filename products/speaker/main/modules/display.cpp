@@ -116,11 +116,7 @@ bool display_init(bool default_dummy_draw)
 
     /* Update display brightness when NVS brightness is updated */
     auto &storage_service = StorageNVS::requestInstance();
-    storage_service.connectEventSignal([&](const StorageNVS::Event & event) {
-        if ((event.operation != StorageNVS::Operation::UpdateNVS) || (event.key != Manager::SETTINGS_BRIGHTNESS)) {
-            return;
-        }
-
+    storage_service.subscribe(Manager::SETTINGS_BRIGHTNESS, [&](const StorageNVS::Event & event) {
         ESP_UTILS_LOG_TRACE_GUARD();
 
         StorageNVS::Value value;
@@ -157,6 +153,19 @@ bool display_init(bool default_dummy_draw)
 
         player->notifyFlushFinished();
     });
+    AnimCompositor::flush_ready_signal.connect(
+        [ = ](int x_start, int y_start, int x_end, int y_end, const void *data, AnimCompositor *compositor
+    ) {
+        if (is_lvgl_dummy_draw) {
+            ESP_UTILS_CHECK_FALSE_EXIT(
+                draw_bitmap_with_lock(disp, x_start, y_start, x_end, y_end, data), "Draw bitmap failed"
+            );
+        }
+
+        ESP_UTILS_CHECK_NULL_EXIT(compositor, "Get compositor failed");
+
+        compositor->notifyFlushFinished();
+    });
     AnimPlayer::animation_stop_signal.connect(
         [ = ](int x_start, int y_start, int x_end, int y_end, void *user_data
     ) {
@@ -50,6 +50,8 @@ constexpr bool        FUNCTION_BRIGHTNESS_CHANGE_THREAD_STACK_CAPS_EXT = true;
 constexpr int         FUNCTION_BRIGHTNESS_CHANGE_STEP                  = 30;
 
 constexpr int         DEVELOPER_MODE_KEY = 0x655;
+// Time to write the pending parameters to NVS before a restart or power off
+constexpr int         STORAGE_FLUSH_TIMEOUT_MS = 1000;
 
 using namespace esp_brookesia;
 using namespace esp_brookesia::systems::speaker;
@@ -172,6 +174,7 @@ bool system_init()
 
                 ESP_UTILS_LOGW("Enter developer mode");
                 developer_mode_key = DEVELOPER_MODE_KEY;
+                StorageNVS::requestInstance().flush(std::chrono::milliseconds(STORAGE_FLUSH_TIMEOUT_MS));
                 esp_restart();
                 break;
             }
@@ -449,10 +452,7 @@ bool system_init()
 
     /* Process touch sensor */
     auto &storage_service = StorageNVS::requestInstance();
-    storage_service.connectEventSignal([](const StorageNVS::Event & event) {
-        if ((event.operation != StorageNVS::Operation::UpdateNVS) || (event.key != SETTINGS_NVS_KEY_TOUCH_SENSOR_SWITCH)) {
-            return;
-        }
+    storage_service.subscribe(SETTINGS_NVS_KEY_TOUCH_SENSOR_SWITCH, [](const StorageNVS::Event & event) {
         ESP_UTILS_LOG_TRACE_GUARD();
         touch_sensor_switch();
     });
@@ -671,6 +671,7 @@ static bool check_whether_enter_developer_mode()
             ESP_UTILS_LOGI("Exit developer mode");
             developer_mode_key = 0;
             _usb_serial_jtag_phy_init();
+            StorageNVS::requestInstance().flush(std::chrono::milliseconds(STORAGE_FLUSH_TIMEOUT_MS));
             esp_restart();
         }, LV_EVENT_CLICKED, nullptr);
 
@@ -816,7 +817,8 @@ static void show_low_power(Speaker *speaker)
     vTaskDelay(pdMS_TO_TICKS(4000));
     led_indicator_stop(led_indicator_handle, BLINK_LOW_POWER);
     StorageNVS::requestInstance().setLocalParam(Manager::SETTINGS_VOLUME, volume_value); // restore volume
-    vTaskDelay(pdMS_TO_TICKS(100)); // ensure storage nvs write completed
+    // Write pending parameters to NVS before the peripherals are powered off
+    StorageNVS::requestInstance().flush(std::chrono::milliseconds(STORAGE_FLUSH_TIMEOUT_MS));
     bsp_set_peripheral_power(false); // board peripheral off
     ESP_UTILS_LOGW("Low power triggered, device will sleep now");
 }